@@ -127,7 +127,7 @@ void electronic_mapping::_init_geiger() {
       for (unsigned int row = 0; row < mapping::NUMBER_OF_GEIGER_ROWS; row++) {
         GID.set(mapping::ROW_INDEX, row);
         EID = _ID_convertor_.convert_GID_to_EID(GID);
-        _geiger_id_bimap_.insert(ID_doublet(GID, EID));
+        _geiger_id_bimap_.insert(ID_doublet(channel_key(GID), channel_key(EID)));
       }  // end of row loop
     }    // end of layer loop
   }      // end of side loop
@@ -144,7 +144,7 @@ void electronic_mapping::_init_mcalo() {
       for (unsigned int row = 0; row < mapping::NUMBER_OF_MAIN_CALO_ROWS; row++) {
         GID.set(mapping::ROW_INDEX, row);
         EID = _ID_convertor_.convert_GID_to_EID(GID);
-        _mcalo_id_bimap_.insert(ID_doublet(GID, EID));
+        _mcalo_id_bimap_.insert(ID_doublet(channel_key(GID), channel_key(EID)));
       }  // end of row loop
     }    // end of column loop
   }      // end of side loop
@@ -163,7 +163,7 @@ void electronic_mapping::_init_x_wall() {
         for (unsigned int row = 0; row < mapping::NUMBER_OF_X_CALO_ROWS; row++) {
           GID.set(mapping::ROW_INDEX, row);
           EID = _ID_convertor_.convert_GID_to_EID(GID);
-          _mcalo_id_bimap_.insert(ID_doublet(GID, EID));
+          _mcalo_id_bimap_.insert(ID_doublet(channel_key(GID), channel_key(EID)));
         }  // end of row loop
       }    // end of column loop
     }      // end of wall loop
@@ -181,7 +181,7 @@ void electronic_mapping::_init_gveto() {
       for (unsigned int column = 0; column < mapping::NUMBER_OF_GVETO_COLUMNS; column++) {
         GID.set(mapping::ROW_INDEX, column);
         EID = _ID_convertor_.convert_GID_to_EID(GID);
-        _mcalo_id_bimap_.insert(ID_doublet(GID, EID));
+        _mcalo_id_bimap_.insert(ID_doublet(channel_key(GID), channel_key(EID)));
       }  // end of column loop
     }    // end of wall loop
   }      // end of side loop
@@ -197,21 +197,22 @@ void electronic_mapping::_convert_EID_to_GID(const bool tracker_trigger_mode_,
   DT_THROW_IF(tracker_trigger_mode_ != mapping::THREE_WIRES_TRACKER_MODE, std::logic_error,
               " Give a correct traker trigger mode (Two wires mode is not supported yet) ! ");
   geom_id_.reset();
+  const channel_key elec_key(elec_id_);
   ID_bimap::right_const_iterator right_iter;
 
   switch (elec_id_.get(mapping::RACK_INDEX)) {
     case mapping::GEIGER_RACK_ID:
-      right_iter = _geiger_id_bimap_.right.find(elec_id_);
+      right_iter = _geiger_id_bimap_.right.find(elec_key);
       if (right_iter != _geiger_id_bimap_.right.end()) {
-        geom_id_ = right_iter->second;
+        right_iter->second.to_geom_id(geom_id_);
       } else {
       }
       break;
 
     case mapping::CALO_RACK_ID:
-      right_iter = _mcalo_id_bimap_.right.find(elec_id_);
+      right_iter = _mcalo_id_bimap_.right.find(elec_key);
       if (right_iter != _mcalo_id_bimap_.right.end()) {
-        geom_id_ = right_iter->second;
+        right_iter->second.to_geom_id(geom_id_);
       } else {
       }
       break;
@@ -229,46 +230,48 @@ void electronic_mapping::_convert_GID_to_EID(const bool tracker_trigger_mode_,
               " Give a correct traker trigger mode (Two wires mode is not supported yet) ! ");
   DT_THROW_IF(!is_initialized(), std::logic_error, "Electronic mapping is not initialized ! ");
   electronic_id_.reset();
+  if (supported_types().count(geom_id_.get_type()) == 0) return;
+  const channel_key geom_key(geom_id_);
   ID_bimap::left_const_iterator left_iter;
 
   switch (geom_id_.get_type()) {
     case mapping::GEIGER_CATEGORY_TYPE:
-      left_iter = _geiger_id_bimap_.left.find(geom_id_);
+      left_iter = _geiger_id_bimap_.left.find(geom_key);
       if (left_iter != _geiger_id_bimap_.left.end()) {
-        electronic_id_ = left_iter->second;
+        left_iter->second.to_geom_id(electronic_id_);
       } else {
         electronic_id_ = _ID_convertor_.convert_GID_to_EID(geom_id_);
-        _geiger_id_bimap_.insert(ID_doublet(geom_id_, electronic_id_));
+        _geiger_id_bimap_.insert(ID_doublet(geom_key, channel_key(electronic_id_)));
       }
       break;
 
     case mapping::CALO_MAIN_WALL_CATEGORY_TYPE:
-      left_iter = _mcalo_id_bimap_.left.find(geom_id_);
+      left_iter = _mcalo_id_bimap_.left.find(geom_key);
       if (left_iter != _mcalo_id_bimap_.left.end()) {
-        electronic_id_ = left_iter->second;
+        left_iter->second.to_geom_id(electronic_id_);
       } else {
         electronic_id_ = _ID_convertor_.convert_GID_to_EID(geom_id_);
-        _mcalo_id_bimap_.insert(ID_doublet(geom_id_, electronic_id_));
+        _mcalo_id_bimap_.insert(ID_doublet(geom_key, channel_key(electronic_id_)));
       }
       break;
 
     case mapping::CALORIMETER_X_WALL_CATEGORY_TYPE:
-      left_iter = _xcalo_id_bimap_.left.find(geom_id_);
+      left_iter = _xcalo_id_bimap_.left.find(geom_key);
       if (left_iter != _xcalo_id_bimap_.left.end()) {
-        electronic_id_ = left_iter->second;
+        left_iter->second.to_geom_id(electronic_id_);
       } else {
         electronic_id_ = _ID_convertor_.convert_GID_to_EID(geom_id_);
-        _xcalo_id_bimap_.insert(ID_doublet(geom_id_, electronic_id_));
+        _xcalo_id_bimap_.insert(ID_doublet(geom_key, channel_key(electronic_id_)));
       }
       break;
 
     case mapping::CALORIMETER_GVETO_CATEGORY_TYPE:
-      left_iter = _gveto_id_bimap_.left.find(geom_id_);
+      left_iter = _gveto_id_bimap_.left.find(geom_key);
       if (left_iter != _gveto_id_bimap_.left.end()) {
-        electronic_id_ = left_iter->second;
+        left_iter->second.to_geom_id(electronic_id_);
       } else {
         electronic_id_ = _ID_convertor_.convert_GID_to_EID(geom_id_);
-        _gveto_id_bimap_.insert(ID_doublet(geom_id_, electronic_id_));
+        _gveto_id_bimap_.insert(ID_doublet(geom_key, channel_key(electronic_id_)));
       }
       break;
 
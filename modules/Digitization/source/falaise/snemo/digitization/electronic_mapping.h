@@ -19,6 +19,7 @@
 #include <bayeux/datatools/logger.h>
 
 // This project
+#include <falaise/snemo/geometry/channel_key.h>
 #include <snemo/digitization/ID_convertor.h>
 #include <snemo/digitization/mapping.h>
 
@@ -27,7 +28,8 @@ namespace snemo {
 namespace digitization {
 
 class electronic_mapping {
-  typedef boost::bimap<geomtools::geom_id, geomtools::geom_id> ID_bimap;
+  typedef snemo::geometry::channel_key channel_key;
+  typedef boost::bimap<channel_key, channel_key> ID_bimap;
   typedef ID_bimap::value_type ID_doublet;
 
  public:
@@ -20,6 +20,7 @@
 #include <falaise/snemo/datamodels/data_model.h>
 #include <falaise/snemo/datamodels/particle_track_data.h>
 #include <falaise/snemo/geometry/calo_locator.h>
+#include <falaise/snemo/geometry/detector_index.h>
 #include <falaise/snemo/geometry/gveto_locator.h>
 #include <falaise/snemo/geometry/locator_plugin.h>
 #include <falaise/snemo/geometry/xcalo_locator.h>
@@ -189,24 +190,29 @@ int gamma_clustering_driver::_process_algo(
 
       geomtools::vector_3d position;
       std::string label;
-      if (calo_locator.is_calo_block_in_current_module(a_gid)) {
-        calo_locator.get_block_position(a_gid, position);
-        const double offset = 45.5 * CLHEP::mm;
-        if (calo_locator.extract_side(a_gid) == snemo::geometry::utils::SIDE_BACK) {
-          position.setX(position.x() - offset);
-        } else {
-          position.setX(position.x() + offset);
+      switch (base_gamma_builder::get_calo_block_type(a_gid)) {
+        case snemo::geometry::detector_index::ELEMENT_CALO_BLOCK: {
+          calo_locator.get_block_position(a_gid, position);
+          const double offset = 45.5 * CLHEP::mm;
+          if (calo_locator.extract_side(a_gid) == snemo::geometry::utils::SIDE_BACK) {
+            position.setX(position.x() - offset);
+          } else {
+            position.setX(position.x() + offset);
+          }
+          label = snemo::datamodel::particle_track::vertex_on_main_calorimeter_label();
+          break;
         }
-        label = snemo::datamodel::particle_track::vertex_on_main_calorimeter_label();
-      } else if (xcalo_locator.is_calo_block_in_current_module(a_gid)) {
-        xcalo_locator.get_block_position(a_gid, position);
-        label = snemo::datamodel::particle_track::vertex_on_x_calorimeter_label();
-      } else if (gveto_locator.is_calo_block_in_current_module(a_gid)) {
-        gveto_locator.get_block_position(a_gid, position);
-        label = snemo::datamodel::particle_track::vertex_on_gamma_veto_label();
-      } else {
-        DT_THROW_IF(true, std::logic_error,
-                    "Current geom id '" << a_gid << "' does not match any scintillator block !");
+        case snemo::geometry::detector_index::ELEMENT_XCALO_BLOCK:
+          xcalo_locator.get_block_position(a_gid, position);
+          label = snemo::datamodel::particle_track::vertex_on_x_calorimeter_label();
+          break;
+        case snemo::geometry::detector_index::ELEMENT_GVETO_BLOCK:
+          gveto_locator.get_block_position(a_gid, position);
+          label = snemo::datamodel::particle_track::vertex_on_gamma_veto_label();
+          break;
+        default:
+          DT_THROW_IF(true, std::logic_error,
+                      "Current geom id '" << a_gid << "' does not match any scintillator block !");
       }
       spot.grab_auxiliaries().store(snemo::datamodel::particle_track::vertex_type_key(), label);
       spot.set_blur_dimension(geomtools::blur_spot::dimension_three);
@@ -260,15 +266,19 @@ void gamma_clustering_driver::_get_geometrical_neighbours(
   } else {
     DT_THROW_IF(true, std::logic_error, "Unknown neighbour mask '" << _cluster_grid_mask_ << "' !")
   }
-  if (calo_locator.is_calo_block_in_current_module(a_gid)) {
-    calo_locator.get_neighbours_ids(a_gid, the_neighbours, mask);
-  } else if (xcalo_locator.is_calo_block_in_current_module(a_gid)) {
-    xcalo_locator.get_neighbours_ids(a_gid, the_neighbours, mask);
-  } else if (gveto_locator.is_calo_block_in_current_module(a_gid)) {
-    gveto_locator.get_neighbours_ids(a_gid, the_neighbours, mask);
-  } else {
-    DT_THROW_IF(true, std::logic_error,
-                "Current geom id '" << a_gid << "' does not match any scintillator block !");
+  switch (base_gamma_builder::get_calo_block_type(a_gid)) {
+    case snemo::geometry::detector_index::ELEMENT_CALO_BLOCK:
+      calo_locator.get_neighbours_ids(a_gid, the_neighbours, mask);
+      break;
+    case snemo::geometry::detector_index::ELEMENT_XCALO_BLOCK:
+      xcalo_locator.get_neighbours_ids(a_gid, the_neighbours, mask);
+      break;
+    case snemo::geometry::detector_index::ELEMENT_GVETO_BLOCK:
+      gveto_locator.get_neighbours_ids(a_gid, the_neighbours, mask);
+      break;
+    default:
+      DT_THROW_IF(true, std::logic_error,
+                  "Current geom id '" << a_gid << "' does not match any scintillator block !");
   }
 
   for (gid_list_type::const_iterator ineighbour = the_neighbours.begin();
@@ -487,27 +497,37 @@ double gamma_clustering_driver::_get_tof_probability(
 
   geomtools::vector_3d head_position;
   const geomtools::geom_id& head_gid = head_end_calo_hit_.get_geom_id();
-  if (calo_locator.is_calo_block_in_current_module(head_gid))
-    calo_locator.get_block_position(head_gid, head_position);
-  else if (xcalo_locator.is_calo_block_in_current_module(head_gid))
-    xcalo_locator.get_block_position(head_gid, head_position);
-  else if (gveto_locator.is_calo_block_in_current_module(head_gid))
-    gveto_locator.get_block_position(head_gid, head_position);
-  else
-    DT_THROW_IF(true, std::logic_error,
-                "Current geom id '" << head_gid << "' does not match any scintillator block !");
+  switch (base_gamma_builder::get_calo_block_type(head_gid)) {
+    case snemo::geometry::detector_index::ELEMENT_CALO_BLOCK:
+      calo_locator.get_block_position(head_gid, head_position);
+      break;
+    case snemo::geometry::detector_index::ELEMENT_XCALO_BLOCK:
+      xcalo_locator.get_block_position(head_gid, head_position);
+      break;
+    case snemo::geometry::detector_index::ELEMENT_GVETO_BLOCK:
+      gveto_locator.get_block_position(head_gid, head_position);
+      break;
+    default:
+      DT_THROW_IF(true, std::logic_error,
+                  "Current geom id '" << head_gid << "' does not match any scintillator block !");
+  }
 
   geomtools::vector_3d tail_position;
   const geomtools::geom_id& tail_gid = tail_begin_calo_hit_.get_geom_id();
-  if (calo_locator.is_calo_block_in_current_module(tail_gid))
-    calo_locator.get_block_position(tail_gid, tail_position);
-  else if (xcalo_locator.is_calo_block_in_current_module(tail_gid))
-    xcalo_locator.get_block_position(tail_gid, tail_position);
-  else if (gveto_locator.is_calo_block_in_current_module(tail_gid))
-    gveto_locator.get_block_position(tail_gid, tail_position);
-  else
-    DT_THROW_IF(true, std::logic_error,
-                "Current geom id '" << tail_gid << "' does not match any scintillator block !");
+  switch (base_gamma_builder::get_calo_block_type(tail_gid)) {
+    case snemo::geometry::detector_index::ELEMENT_CALO_BLOCK:
+      calo_locator.get_block_position(tail_gid, tail_position);
+      break;
+    case snemo::geometry::detector_index::ELEMENT_XCALO_BLOCK:
+      xcalo_locator.get_block_position(tail_gid, tail_position);
+      break;
+    case snemo::geometry::detector_index::ELEMENT_GVETO_BLOCK:
+      gveto_locator.get_block_position(tail_gid, tail_position);
+      break;
+    default:
+      DT_THROW_IF(true, std::logic_error,
+                  "Current geom id '" << tail_gid << "' does not match any scintillator block !");
+  }
 
   const double t1 = head_end_calo_hit_.get_time();
   const double t2 = tail_begin_calo_hit_.get_time();
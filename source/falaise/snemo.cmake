@@ -71,6 +71,9 @@ list(APPEND FalaiseLibrary_HEADERS
   snemo/datamodels/gg_track_utils.h
 
   snemo/geometry/utils.h
+  snemo/geometry/channel_key.h
+  snemo/geometry/detector_index.h
+  snemo/geometry/geom_info_table.h
   snemo/geometry/calo_locator.h
   snemo/geometry/xcalo_locator.h
   snemo/geometry/gg_locator.h
@@ -90,6 +93,8 @@ list(APPEND FalaiseLibrary_HEADERS
   snemo/processing/event_header_utils_module.h
   snemo/processing/calorimeter_regime.h
   snemo/processing/geiger_regime.h
+  snemo/processing/random_stream.h
+  snemo/processing/uniform_table.h
   snemo/processing/mock_calorimeter_s2c_module.h
   snemo/processing/mock_tracker_s2c_module.h
   snemo/processing/base_tracker_clusterizer.h
@@ -148,6 +153,9 @@ list(APPEND FalaiseLibrary_SOURCES
   snemo/geometry/gveto_locator.cc
   snemo/geometry/locator_plugin.cc
   snemo/geometry/utils.cc
+  snemo/geometry/channel_key.cc
+  snemo/geometry/detector_index.cc
+  snemo/geometry/geom_info_table.cc
   snemo/geometry/mapped_magnetic_field.cc
 
   snemo/electronics/constants.cc
@@ -158,6 +166,8 @@ list(APPEND FalaiseLibrary_SOURCES
   snemo/processing/event_header_utils_module.cc
   snemo/processing/calorimeter_regime.cc
   snemo/processing/geiger_regime.cc
+  snemo/processing/random_stream.cc
+  snemo/processing/uniform_table.cc
   snemo/processing/mock_calorimeter_s2c_module.cc
   snemo/processing/mock_tracker_s2c_module.cc
   snemo/processing/base_tracker_clusterizer.cc
@@ -198,11 +208,18 @@ list(APPEND FalaiseLibrary_TESTS
   snemo/testing/test_snemo_datamodel_particle_track.cxx
   snemo/testing/test_snemo_datamodel_particle_track_data.cxx
   snemo/testing/test_snemo_geometry_calo_locator_1.cxx
+  snemo/testing/test_snemo_geometry_channel_key.cxx
+  snemo/testing/test_snemo_geometry_detector_index.cxx
+  snemo/testing/test_snemo_geometry_geom_info_table.cxx
   snemo/testing/test_snemo_geometry_gg_locator_1.cxx
   snemo/testing/test_snemo_geometry_gveto_locator_1.cxx
+  snemo/testing/test_snemo_geometry_locators_threads.cxx
   snemo/testing/test_snemo_geometry_retrieve_info.cxx
   snemo/testing/test_snemo_geometry_xcalo_locator_1.cxx
   snemo/testing/test_snemo_geometry_mapped_magnetic_field.cxx
+  snemo/testing/test_snemo_processing_geiger_regime.cxx
+  snemo/testing/test_snemo_processing_calorimeter_regime.cxx
+  snemo/testing/test_snemo_processing_random_stream.cxx
   # snemo/testing/test_snemo_electronics_mapping.cxx
 
   snemo/testing/test_snemo_cut_particle_track_cut.cxx
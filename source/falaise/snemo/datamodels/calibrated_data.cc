@@ -3,6 +3,9 @@
 // Ourselves:
 #include <falaise/snemo/datamodels/calibrated_data.h>
 
+// Standard library:
+#include <utility>
+
 // Third party:
 // - Bayeux/datatools:
 #include <datatools/clhep_units.h>
@@ -78,6 +81,13 @@ void calibrated_data::clear() {
   return;
 }
 
+void calibrated_data::swap(calibrated_data& other_) {
+  _calibrated_calorimeter_hits_.swap(other_._calibrated_calorimeter_hits_);
+  _calibrated_tracker_hits_.swap(other_._calibrated_tracker_hits_);
+  std::swap(_properties_, other_._properties_);
+  return;
+}
+
 void calibrated_data::tree_dump(std::ostream& out_, const std::string& title_,
                                 const std::string& indent_, bool inherit_) const {
   std::string indent;
@@ -102,6 +102,12 @@ class calibrated_data : public datatools::i_serializable,
   /// Clear attributes
   virtual void clear();
 
+  /// Exchange the hits and properties with another calibrated data
+  ///
+  /// The storage allocated for the collections of hits is exchanged too, so
+  /// that a cleared calibrated data can be refilled without reallocation.
+  void swap(calibrated_data& other_);
+
   /// Smart print
   virtual void tree_dump(std::ostream& a_out = std::clog, const std::string& a_title = "",
                          const std::string& a_indent = "", bool a_inherit = false) const;
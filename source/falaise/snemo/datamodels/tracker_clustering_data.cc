@@ -3,6 +3,9 @@
 // Ourselves:
 #include <falaise/snemo/datamodels/tracker_clustering_data.h>
 
+// Standard library:
+#include <utility>
+
 namespace snemo {
 
 namespace datamodel {
@@ -108,6 +111,13 @@ void tracker_clustering_data::clear() {
   return;
 }
 
+void tracker_clustering_data::swap(tracker_clustering_data& other_) {
+  _solutions_.swap(other_._solutions_);
+  std::swap(_default_solution_, other_._default_solution_);
+  std::swap(_auxiliaries_, other_._auxiliaries_);
+  return;
+}
+
 tracker_clustering_data::tracker_clustering_data() { return; }
 
 tracker_clustering_data::~tracker_clustering_data() {
@@ -4,6 +4,9 @@
 // Ourselves:
 #include <falaise/snemo/datamodels/tracker_trajectory_data.h>
 
+// Standard library:
+#include <utility>
+
 namespace snemo {
 
 namespace datamodel {
@@ -88,6 +91,13 @@ void tracker_trajectory_data::clear() {
   return;
 }
 
+void tracker_trajectory_data::swap(tracker_trajectory_data& other_) {
+  _solutions_.swap(other_._solutions_);
+  std::swap(_default_solution_, other_._default_solution_);
+  std::swap(_auxiliaries_, other_._auxiliaries_);
+  return;
+}
+
 tracker_trajectory_data::tracker_trajectory_data() { return; }
 
 tracker_trajectory_data::~tracker_trajectory_data() {
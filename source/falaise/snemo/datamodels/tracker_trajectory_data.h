@@ -88,6 +88,11 @@ class tracker_trajectory_data : public datatools::i_serializable,
   /// Clear the object
   virtual void clear();
 
+  /// Exchange the trajectory solutions and auxiliaries with another object
+  ///
+  /// The storage allocated for the collection of solutions is exchanged too.
+  void swap(tracker_trajectory_data& other_);
+
   /// Smart print
   virtual void tree_dump(std::ostream& out_ = std::clog, const std::string& title_ = "",
                          const std::string& indent_ = "", bool inherit_ = false) const;
@@ -165,24 +165,118 @@ void calo_locator::get_block_position(const geomtools::geom_id &gid_,
 void calo_locator::get_block_position(uint32_t side_, uint32_t column_, uint32_t row_,
                                       geomtools::vector_3d &position_) const {
   DT_THROW_IF(!is_initialized(), std::logic_error, "Locator is not initialized !");
+  position_ = _block_positions_[_block_index(side_, column_, row_)];
+  return;
+}
+
+const geomtools::placement &calo_locator::get_block_world_placement(
+    const geomtools::geom_id &gid_) const {
+  DT_THROW_IF(!is_initialized(), std::logic_error, "Locator is not initialized !");
+  DT_THROW_IF(gid_.get(_module_address_index_) != _module_number_, std::logic_error,
+              "Invalid module number (" << gid_.get(_module_address_index_)
+                                        << "!=" << _module_number_ << ")!");
+  return get_block_world_placement(gid_.get(_side_address_index_),
+                                   gid_.get(_column_address_index_), gid_.get(_row_address_index_));
+}
+
+const geomtools::placement &calo_locator::get_block_world_placement(uint32_t side_,
+                                                                    uint32_t column_,
+                                                                    uint32_t row_) const {
+  DT_THROW_IF(!is_initialized(), std::logic_error, "Locator is not initialized !");
+  return _block_world_placements_[_block_index(side_, column_, row_)];
+}
+
+size_t calo_locator::get_number_of_blocks() const {
+  DT_THROW_IF(!is_initialized(), std::logic_error, "Locator is not initialized !");
+  return _block_positions_.size();
+}
+
+size_t calo_locator::get_block_index(uint32_t side_, uint32_t column_, uint32_t row_) const {
+  DT_THROW_IF(!is_initialized(), std::logic_error, "Locator is not initialized !");
+  return _block_index(side_, column_, row_);
+}
+
+size_t calo_locator::_block_index(uint32_t side_, uint32_t column_, uint32_t row_) const {
   DT_THROW_IF(side_ > 1, std::logic_error, "Invalid side number (" << side_ << "> 1)!");
-  geomtools::invalidate(position_);
-  if (side_ == (uint32_t)utils::SIDE_BACK) {
-    DT_THROW_IF(column_ >= _back_block_y_.size(), std::logic_error,
-                "Invalid column number (" << column_ << ">" << _back_block_y_.size() - 1 << ")!");
-    DT_THROW_IF(row_ >= _back_block_z_.size(), std::logic_error,
-                "Invalid row number (" << row_ << ">" << _back_block_z_.size() - 1 << ")!");
-    position_.set(_block_x_[utils::SIDE_BACK], _back_block_y_[column_], _back_block_z_[row_]);
-  } else {
-    DT_THROW_IF(column_ >= _front_block_y_.size(), std::logic_error,
-                "Invalid column number (" << column_ << ">" << _front_block_y_.size() - 1 << ")!");
-    DT_THROW_IF(row_ >= _front_block_z_.size(), std::logic_error,
-                "Invalid row number (" << row_ << ">" << _front_block_z_.size() - 1 << ")!");
-    position_.set(_block_x_[utils::SIDE_FRONT], _front_block_y_[column_], _front_block_z_[row_]);
+  const std::vector<double> &block_y =
+      (side_ == (uint32_t)utils::SIDE_BACK) ? _back_block_y_ : _front_block_y_;
+  const std::vector<double> &block_z =
+      (side_ == (uint32_t)utils::SIDE_BACK) ? _back_block_z_ : _front_block_z_;
+  DT_THROW_IF(column_ >= block_y.size(), std::logic_error,
+              "Invalid column number (" << column_ << ">" << block_y.size() - 1 << ")!");
+  DT_THROW_IF(row_ >= block_z.size(), std::logic_error,
+              "Invalid row number (" << row_ << ">" << block_z.size() - 1 << ")!");
+  return _side_block_offset_[side_] + column_ * block_z.size() + row_;
+}
+
+void calo_locator::_build_block_tables() {
+  // Dense indexing of the blocks, side by side, then column by column:
+  _side_block_offset_[utils::SIDE_BACK] = 0;
+  _side_block_offset_[utils::SIDE_FRONT] = _back_block_y_.size() * _back_block_z_.size();
+  const size_t nblocks =
+      _side_block_offset_[utils::SIDE_FRONT] + _front_block_y_.size() * _front_block_z_.size();
+  _block_positions_.assign(nblocks, geomtools::vector_3d());
+  _block_world_placements_.assign(nblocks, geomtools::placement());
+  for (size_t kind = 0; kind < NEIGHBOUR_KINDS; kind++) {
+    _neighbour_ids_[kind].clear();
+    _neighbour_offsets_[kind].assign(nblocks + 1, 0);
+  }
+
+  std::vector<geomtools::geom_id> ids;
+  for (uint32_t side = 0; side < utils::NSIDES; side++) {
+    const bool back = (side == (uint32_t)utils::SIDE_BACK);
+    const std::vector<double> &block_y = back ? _back_block_y_ : _front_block_y_;
+    const std::vector<double> &block_z = back ? _back_block_z_ : _front_block_z_;
+    for (uint32_t column = 0; column < block_y.size(); column++) {
+      for (uint32_t row = 0; row < block_z.size(); row++) {
+        const size_t block_index = _block_index(side, column, row);
+        geomtools::vector_3d &position = _block_positions_[block_index];
+        position.set(_block_x_[side], block_y[column], block_z[row]);
+
+        // World placement from the mapping, or from the module placement if the block
+        // is not mapped:
+        geomtools::geom_id block_gid;
+        block_gid.set_type(_block_type_);
+        block_gid.set(_module_address_index_, _module_number_);
+        block_gid.set(_side_address_index_, side);
+        block_gid.set(_column_address_index_, column);
+        block_gid.set(_row_address_index_, row);
+        if (is_block_partitioned()) {
+          block_gid.set(_part_address_index_, _block_part_);
+        }
+        geomtools::placement &world_placement = _block_world_placements_[block_index];
+        if (_mapping_->validate_id(block_gid)) {
+          world_placement = _mapping_->get_geom_info(block_gid).get_world_placement();
+        } else {
+          geomtools::vector_3d world_position;
+          _module_world_placement_->child_to_mother(position, world_position);
+          world_placement = *_module_world_placement_;
+          world_placement.set_translation(world_position);
+        }
+
+        for (size_t kind = 0; kind < NEIGHBOUR_KINDS; kind++) {
+          _compute_neighbours_ids(side, column, row, ids, _neighbour_kind_mask(kind));
+          _neighbour_ids_[kind].insert(_neighbour_ids_[kind].end(), ids.begin(), ids.end());
+          _neighbour_offsets_[kind][block_index + 1] = ids.size();
+        }
+      }
+    }
+  }
+  // Turn the numbers of neighbours into offsets:
+  for (size_t kind = 0; kind < NEIGHBOUR_KINDS; kind++) {
+    for (size_t i = 0; i < nblocks; i++) {
+      _neighbour_offsets_[kind][i + 1] += _neighbour_offsets_[kind][i];
+    }
   }
   return;
 }
 
+uint8_t calo_locator::_neighbour_kind_mask(size_t kind_) {
+  static const uint8_t masks[NEIGHBOUR_KINDS] = {utils::NEIGHBOUR_SIDE, utils::NEIGHBOUR_DIAG,
+                                                 utils::NEIGHBOUR_SECOND};
+  return masks[kind_];
+}
+
 void calo_locator::get_neighbours_ids(const geomtools::geom_id &gid_,
                                       std::vector<geomtools::geom_id> &ids_, uint8_t mask_) const {
   DT_THROW_IF(!is_initialized(), std::logic_error, "Locator is not initialized !");
@@ -197,6 +291,20 @@ void calo_locator::get_neighbours_ids(const geomtools::geom_id &gid_,
 void calo_locator::get_neighbours_ids(uint32_t side_, uint32_t column_, uint32_t row_,
                                       std::vector<geomtools::geom_id> &ids_, uint8_t mask_) const {
   DT_THROW_IF(!is_initialized(), std::logic_error, "Locator is not initialized !");
+  const size_t block_index = _block_index(side_, column_, row_);
+  ids_.clear();
+  for (size_t kind = 0; kind < NEIGHBOUR_KINDS; kind++) {
+    if (!(mask_ & _neighbour_kind_mask(kind))) continue;
+    const std::vector<geomtools::geom_id>::const_iterator first = _neighbour_ids_[kind].begin();
+    ids_.insert(ids_.end(), first + _neighbour_offsets_[kind][block_index],
+                first + _neighbour_offsets_[kind][block_index + 1]);
+  }
+  return;
+}
+
+void calo_locator::_compute_neighbours_ids(uint32_t side_, uint32_t column_, uint32_t row_,
+                                           std::vector<geomtools::geom_id> &ids_,
+                                           uint8_t mask_) const {
   DT_THROW_IF(side_ > 1, std::logic_error, "Invalid side number (" << side_ << "> 1)!");
 
   ids_.clear();
@@ -434,9 +542,9 @@ void calo_locator::get_neighbours_ids(uint32_t side_, uint32_t column_, uint32_t
      */
     if (second) {
       for (int ir = -2; ir <= +2; ir++) {
-        if (row_ + ir > (_back_block_z_.size() - 1)) continue;
+        if (row_ + ir > (_front_block_z_.size() - 1)) continue;
         for (int ic = -2; ic <= +2; ic++) {
-          if (column_ + ic > (_back_block_y_.size() - 1)) continue;
+          if (column_ + ic > (_front_block_y_.size() - 1)) continue;
           if (std::abs(ir) != 2 && std::abs(ic) != 2) continue;
           gid.set(_column_address_index_, column_ + ic);
           gid.set(_row_address_index_, row_ + ir);
@@ -558,6 +666,7 @@ void calo_locator::_set_defaults_() {
     datatools::invalidate(_block_x_[i]);
     datatools::invalidate(_block_window_x_[i]);
     _submodules_[i] = false;
+    _side_block_offset_[i] = 0;
   }
 
   datatools::invalidate(_block_width_);
@@ -826,6 +935,7 @@ void calo_locator::_construct() {
   _block_height_ = _block_box_->get_y();
   _block_thickness_ = _block_box_->get_z();
 
+  _build_block_tables();
   return;
 }
 
@@ -1034,6 +1144,12 @@ void calo_locator::reset() {
   _front_block_z_.clear();
   _back_block_y_.clear();
   _front_block_y_.clear();
+  _block_positions_.clear();
+  _block_world_placements_.clear();
+  for (size_t kind = 0; kind < NEIGHBOUR_KINDS; kind++) {
+    _neighbour_ids_[kind].clear();
+    _neighbour_offsets_[kind].clear();
+  }
   _set_defaults_();
   return;
 }
@@ -1101,8 +1217,7 @@ bool calo_locator::find_geom_id(const geomtools::vector_3d &world_position_, int
     // Not in this module :
     return false;
   }
-  return const_cast<calo_locator *>(this)->calo_locator::find_block_geom_id_(in_module_position,
-                                                                             gid_);
+  return find_block_geom_id_(in_module_position, gid_);
 }
 
 bool calo_locator::id_is_valid(uint32_t side_, uint32_t column_, uint32_t row_) const {
@@ -1124,7 +1239,7 @@ bool calo_locator::find_block_geom_id(const geomtools::vector_3d &world_position
 }
 
 bool calo_locator::find_block_geom_id_(const geomtools::vector_3d &in_module_position_,
-                                       geomtools::geom_id &gid_, double tolerance_) {
+                                       geomtools::geom_id &gid_, double tolerance_) const {
   DT_LOG_TRACE_ENTERING(get_logging_priority());
 
   double tolerance = tolerance_;
@@ -33,6 +33,7 @@
 
 // Standard library:
 #include <string>
+#include <vector>
 
 // Third party:
 // - Boost :
@@ -41,6 +42,7 @@
 #include <datatools/i_tree_dump.h>
 // - Bayeux/geomtools:
 #include <geomtools/i_locator.h>
+#include <geomtools/placement.h>
 
 // This project:
 #include <falaise/snemo/geometry/utils.h>
@@ -50,7 +52,6 @@ namespace geomtools {
 class mapping;
 class id_mgr;
 class manager;
-class placement;
 class i_shape_3d;
 class box;
 }  // namespace geomtools
@@ -122,7 +123,7 @@ class calo_locator : public geomtools::base_locator, public datatools::i_tree_du
    */
   bool find_block_geom_id_(const geomtools::vector_3d& in_module_position_,
                            geomtools::geom_id& gid_,
-                           double tolerance_ = GEOMTOOLS_PROPER_TOLERANCE);
+                           double tolerance_ = GEOMTOOLS_PROPER_TOLERANCE) const;
 
   void _set_defaults_();
 
@@ -282,6 +283,26 @@ class calo_locator : public geomtools::base_locator, public datatools::i_tree_du
   void get_block_position(uint32_t side_, uint32_t column_, uint32_t row_,
                           geomtools::vector_3d& position_) const;
 
+  /** Given a block with a specific geometry ID, return its placement (position and orientation)
+   * in the world coordinate system.
+   */
+  const geomtools::placement& get_block_world_placement(const geomtools::geom_id& gid_) const;
+
+  /** Given a block with a specific side, column and row, return its placement (position and
+   * orientation) in the world coordinate system.
+   */
+  const geomtools::placement& get_block_world_placement(uint32_t side_, uint32_t column_,
+                                                        uint32_t row_) const;
+
+  /**! @return the number of blocks in the module.
+   */
+  size_t get_number_of_blocks() const;
+
+  /**! @return the dense index (in [0, get_number_of_blocks()[) of a block for specific side,
+   * column and row.
+   */
+  size_t get_block_index(uint32_t side_, uint32_t column_, uint32_t row_) const;
+
   int get_module_address_index() const;
 
   int get_side_address_index() const;
@@ -320,6 +341,22 @@ class calo_locator : public geomtools::base_locator, public datatools::i_tree_du
   void _hack_trace();
 
  private:
+  /// Number of kinds of neighbours (side, diagonal and second ranked)
+  static const size_t NEIGHBOUR_KINDS = 3;
+
+  /// Return the neighbour mask of a kind of neighbours
+  static uint8_t _neighbour_kind_mask(size_t kind_);
+
+  /// Return the dense index of a block, after checking its address
+  size_t _block_index(uint32_t side_, uint32_t column_, uint32_t row_) const;
+
+  /// Compute the geometry IDs of the neighbouring blocks of a block
+  void _compute_neighbours_ids(uint32_t side_, uint32_t column_, uint32_t row_,
+                               std::vector<geomtools::geom_id>& ids_, uint8_t mask_) const;
+
+  /// Build the position, placement and neighbour tables of all blocks
+  void _build_block_tables();
+
   bool _initialized_;
 
   // Configuration parameters :
@@ -362,6 +399,13 @@ class calo_locator : public geomtools::base_locator, public datatools::i_tree_du
 
   // Submodules are present :
   bool _submodules_[2];
+
+  // Block tables, by dense block index :
+  size_t _side_block_offset_[2];                               //!< Index of the first block
+  std::vector<geomtools::vector_3d> _block_positions_;         //!< Module coordinate system
+  std::vector<geomtools::placement> _block_world_placements_;  //!< World coordinate system
+  std::vector<geomtools::geom_id> _neighbour_ids_[NEIGHBOUR_KINDS];  //!< Neighbours by kind
+  std::vector<size_t> _neighbour_offsets_[NEIGHBOUR_KINDS];  //!< Neighbour ranges by kind
 };
 
 }  // end of namespace geometry
@@ -0,0 +1,125 @@
+// falaise/snemo/geometry/channel_key.cc
+
+// Ourselves:
+#include <falaise/snemo/geometry/channel_key.h>
+
+// Standard library:
+#include <stdexcept>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+
+namespace snemo {
+
+namespace geometry {
+
+const uint32_t channel_key::MAX_DEPTH;
+const uint32_t channel_key::MAX_TYPE;
+const uint32_t channel_key::MAX_ADDRESS;
+const channel_key::value_type channel_key::INVALID_VALUE;
+
+namespace {
+
+/// Packed value of an address value
+const uint32_t PACKED_ANY_ADDRESS = 0xFE;
+const uint32_t PACKED_INVALID_ADDRESS = 0xFF;
+
+bool is_packable_address(uint32_t value_) {
+  return value_ < channel_key::MAX_ADDRESS || value_ == geomtools::geom_id::ANY_ADDRESS ||
+         value_ == geomtools::geom_id::INVALID_ADDRESS;
+}
+
+uint32_t pack_address(uint32_t value_) {
+  if (value_ == geomtools::geom_id::ANY_ADDRESS) return PACKED_ANY_ADDRESS;
+  if (value_ == geomtools::geom_id::INVALID_ADDRESS) return PACKED_INVALID_ADDRESS;
+  return value_;
+}
+
+uint32_t unpack_address(uint32_t packed_) {
+  if (packed_ == PACKED_ANY_ADDRESS) return geomtools::geom_id::ANY_ADDRESS;
+  if (packed_ == PACKED_INVALID_ADDRESS) return geomtools::geom_id::INVALID_ADDRESS;
+  return packed_;
+}
+
+/// Return the packed value of a type and depth, with all address values invalid
+channel_key::value_type make_header(uint32_t type_, uint32_t depth_) {
+  return (static_cast<channel_key::value_type>(type_) << 52) |
+         (static_cast<channel_key::value_type>(depth_) << 48) | 0xFFFFFFFFFFFFULL;
+}
+
+}  // namespace
+
+bool channel_key::can_pack(const geomtools::geom_id& gid_) {
+  if (gid_.get_type() == geomtools::geom_id::INVALID_TYPE) return true;
+  if (gid_.get_type() >= MAX_TYPE) return false;
+  if (gid_.get_depth() > MAX_DEPTH) return false;
+  for (uint32_t i = 0; i < gid_.get_depth(); i++) {
+    if (!is_packable_address(gid_.get(i))) return false;
+  }
+  return true;
+}
+
+channel_key::channel_key(const geomtools::geom_id& gid_) : _value_(INVALID_VALUE) {
+  DT_THROW_IF(!can_pack(gid_), std::range_error,
+              "Geometry ID " << gid_ << " cannot be packed in a channel key !");
+  if (gid_.get_type() == geomtools::geom_id::INVALID_TYPE) return;
+  _value_ = make_header(gid_.get_type(), gid_.get_depth());
+  for (uint32_t i = 0; i < gid_.get_depth(); i++) {
+    set(i, gid_.get(i));
+  }
+}
+
+channel_key::channel_key(uint32_t type_, std::initializer_list<uint32_t> address_)
+    : _value_(INVALID_VALUE) {
+  DT_THROW_IF(type_ >= MAX_TYPE, std::range_error,
+              "Type " << type_ << " cannot be packed in a channel key !");
+  DT_THROW_IF(address_.size() > MAX_DEPTH, std::range_error,
+              "Address depth " << address_.size() << " cannot be packed in a channel key !");
+  _value_ = make_header(type_, address_.size());
+  uint32_t index = 0;
+  for (uint32_t value : address_) {
+    set(index++, value);
+  }
+}
+
+uint32_t channel_key::get(uint32_t index_) const {
+  DT_THROW_IF(index_ >= get_depth(), std::range_error,
+              "Invalid address index " << index_ << " for channel key " << *this << " !");
+  return unpack_address(static_cast<uint32_t>((_value_ >> _shift_(index_)) & 0xFF));
+}
+
+void channel_key::set(uint32_t index_, uint32_t value_) {
+  DT_THROW_IF(index_ >= get_depth(), std::range_error,
+              "Invalid address index " << index_ << " for channel key " << *this << " !");
+  DT_THROW_IF(!is_packable_address(value_), std::range_error,
+              "Address value " << value_ << " cannot be packed in a channel key !");
+  const uint32_t shift = _shift_(index_);
+  _value_ &= ~(static_cast<value_type>(0xFF) << shift);
+  _value_ |= static_cast<value_type>(pack_address(value_)) << shift;
+}
+
+void channel_key::to_geom_id(geomtools::geom_id& gid_) const {
+  gid_.reset();
+  if (!is_valid()) return;
+  gid_.set_type(get_type());
+  gid_.set_depth(get_depth());
+  for (uint32_t i = 0; i < get_depth(); i++) {
+    gid_.set(i, get(i));
+  }
+}
+
+geomtools::geom_id channel_key::to_geom_id() const {
+  geomtools::geom_id gid;
+  to_geom_id(gid);
+  return gid;
+}
+
+std::ostream& operator<<(std::ostream& out_, const channel_key& key_) {
+  out_ << key_.to_geom_id();
+  return out_;
+}
+
+}  // end of namespace geometry
+
+}  // end of namespace snemo
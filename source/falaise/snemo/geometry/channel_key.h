@@ -0,0 +1,172 @@
+/// \file falaise/snemo/geometry/channel_key.h
+/* Creation date: 2026-10-18
+ * Last modified: 2026-10-18
+ *
+ * License:
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public  License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Description:
+ *
+ *   Compact detector channel key packing a geometry ID in a 64 bits integer
+ *
+ * History:
+ *
+ */
+
+#ifndef FALAISE_SNEMO_GEOMETRY_CHANNEL_KEY_H
+#define FALAISE_SNEMO_GEOMETRY_CHANNEL_KEY_H 1
+
+// Standard library:
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+
+// Third party:
+// - Boost :
+#include <boost/cstdint.hpp>
+// - Bayeux/geomtools:
+#include <geomtools/geom_id.h>
+
+namespace snemo {
+
+namespace geometry {
+
+/** \brief Compact detector channel key
+ *
+ *  The key packs the type and the address of a geometry ID, like
+ *  (type, module, side, layer, row) for a drift cell or
+ *  (type, module, side, column, row, part) for a calorimeter block,
+ *  in a single 64 bits integer:
+ *
+ *   [ type : 12 bits ][ depth : 4 bits ][ 6 x address : 8 bits ]
+ *
+ *  Contrary to geomtools::geom_id, whose address is stored in a heap
+ *  allocated vector, the key is trivially copyable, hashable and comparable,
+ *  and is thus suited to associative containers in hot paths. The conversion
+ *  from and to geomtools::geom_id is lossless for all the geometry IDs
+ *  with a type lower than MAX_TYPE, at most MAX_DEPTH address values, each
+ *  lower than MAX_ADDRESS or any/invalid.
+ */
+class channel_key {
+ public:
+  /// Type of the packed value
+  typedef uint64_t value_type;
+
+  /// Maximum number of address values
+  static const uint32_t MAX_DEPTH = 6;
+
+  /// Maximum packable geometry type (excluded)
+  static const uint32_t MAX_TYPE = 0xFFF;
+
+  /// Maximum packable address value (excluded)
+  static const uint32_t MAX_ADDRESS = 0xFE;
+
+  /// Packed value of an invalid key
+  static const value_type INVALID_VALUE = 0xFFFFFFFFFFFFFFFFULL;
+
+  /// \brief Hash function object, returning the packed value itself
+  struct hasher {
+    std::size_t operator()(const channel_key& key_) const {
+      return static_cast<std::size_t>(key_._value_);
+    }
+  };
+
+  /// Check if a geometry ID can be losslessly packed in a key
+  static bool can_pack(const geomtools::geom_id& gid_);
+
+  /// Build a key from its packed value
+  static channel_key from_value(value_type value_) {
+    channel_key key;
+    key._value_ = value_;
+    return key;
+  }
+
+  /// Default constructor (invalid key)
+  channel_key() : _value_(INVALID_VALUE) {}
+
+  /// Constructor from a geometry ID, throw if it cannot be packed
+  explicit channel_key(const geomtools::geom_id& gid_);
+
+  /// Constructor from a type and a list of address values
+  channel_key(uint32_t type_, std::initializer_list<uint32_t> address_);
+
+  /// Check the validity of the key
+  bool is_valid() const { return get_type() != geomtools::geom_id::INVALID_TYPE; }
+
+  /// Invalidate the key
+  void invalidate() { _value_ = INVALID_VALUE; }
+
+  /// Return the packed value
+  value_type get_value() const { return _value_; }
+
+  /// Return the geometry type
+  uint32_t get_type() const {
+    const uint32_t type = static_cast<uint32_t>(_value_ >> 52);
+    return type == MAX_TYPE ? geomtools::geom_id::INVALID_TYPE : type;
+  }
+
+  /// Return the number of address values
+  uint32_t get_depth() const { return static_cast<uint32_t>((_value_ >> 48) & 0xF); }
+
+  /// Return the address value at a given index
+  uint32_t get(uint32_t index_) const;
+
+  /// Set the address value at a given index
+  void set(uint32_t index_, uint32_t value_);
+
+  /// Fill a geometry ID with the type and address of the key
+  void to_geom_id(geomtools::geom_id& gid_) const;
+
+  /// Return the geometry ID with the type and address of the key
+  geomtools::geom_id to_geom_id() const;
+
+  bool operator==(const channel_key& other_) const { return _value_ == other_._value_; }
+
+  bool operator!=(const channel_key& other_) const { return _value_ != other_._value_; }
+
+  /// Order by type, depth then address values
+  bool operator<(const channel_key& other_) const { return _value_ < other_._value_; }
+
+  friend std::ostream& operator<<(std::ostream& out_, const channel_key& key_);
+
+ private:
+  /// Return the bit shift of the address value at a given index
+  static uint32_t _shift_(uint32_t index_) { return 40 - 8 * index_; }
+
+  value_type _value_;  //!< Packed type, depth and address
+};
+
+}  // end of namespace geometry
+
+}  // end of namespace snemo
+
+namespace std {
+
+/// Specialization of std::hash for channel keys
+template <>
+struct hash<snemo::geometry::channel_key> : public snemo::geometry::channel_key::hasher {};
+
+}  // end of namespace std
+
+#endif  // FALAISE_SNEMO_GEOMETRY_CHANNEL_KEY_H
+
+// Local Variables: --
+// mode: c++ --
+// c-file-style: "gnu" --
+// tab-width: 2 --
+// End: --
@@ -0,0 +1,385 @@
+// falaise/snemo/geometry/detector_index.cc
+
+// Ourselves:
+#include <falaise/snemo/geometry/detector_index.h>
+
+// Standard library:
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/clhep_units.h>
+#include <datatools/exception.h>
+
+// This project:
+#include <falaise/snemo/geometry/calo_locator.h>
+#include <falaise/snemo/geometry/gg_locator.h>
+#include <falaise/snemo/geometry/gveto_locator.h>
+#include <falaise/snemo/geometry/xcalo_locator.h>
+
+namespace snemo {
+
+namespace geometry {
+
+const uint32_t detector_index::INVALID_ELEMENT;
+
+// static
+double detector_index::default_voxel_size() { return 50. * CLHEP::mm; }
+
+detector_index::detector_index() { _set_defaults_(); }
+
+detector_index::~detector_index() {
+  if (is_initialized()) {
+    reset();
+  }
+}
+
+bool detector_index::is_initialized() const { return _initialized_; }
+
+void detector_index::set_voxel_size(double voxel_size_) {
+  DT_THROW_IF(is_initialized(), std::logic_error, "Detector index is already initialized !");
+  DT_THROW_IF(!(voxel_size_ > 0.0), std::range_error, "Invalid voxel size " << voxel_size_ << " !");
+  _voxel_size_ = voxel_size_;
+}
+
+double detector_index::get_voxel_size() const { return _voxel_size_; }
+
+void detector_index::set_tolerance(double tolerance_) {
+  DT_THROW_IF(is_initialized(), std::logic_error, "Detector index is already initialized !");
+  DT_THROW_IF(tolerance_ < 0.0, std::range_error, "Invalid tolerance " << tolerance_ << " !");
+  _tolerance_ = tolerance_;
+}
+
+double detector_index::get_tolerance() const { return _tolerance_; }
+
+void detector_index::initialize(const gg_locator* gg_locator_, const calo_locator* calo_locator_,
+                                const xcalo_locator* xcalo_locator_,
+                                const gveto_locator* gveto_locator_) {
+  DT_THROW_IF(is_initialized(), std::logic_error, "Detector index is already initialized !");
+  _gg_locator_ = gg_locator_;
+  _calo_locator_ = calo_locator_;
+  _xcalo_locator_ = xcalo_locator_;
+  _gveto_locator_ = gveto_locator_;
+
+  if (_gg_locator_ != 0) {
+    const gg_locator& ggl = *_gg_locator_;
+    DT_THROW_IF(!ggl.is_initialized(), std::logic_error, "Geiger locator is not initialized !");
+    _check_module_number_(ggl.get_module_number());
+    const double diameter = ggl.get_cell_diameter();
+    const double length = ggl.get_cell_length();
+    geomtools::geom_id gid;
+    for (uint32_t side = 0; side < ggl.get_number_of_sides(); side++) {
+      for (uint32_t layer = 0; layer < ggl.get_number_of_layers(side); layer++) {
+        for (uint32_t row = 0; row < ggl.get_number_of_rows(side); row++) {
+          ggl.make_cell_geom_id(gg_locator::make_cell_id(side, layer, row), gid);
+          _add_element_(ELEMENT_DRIFT_CELL, gid, ggl.get_module_address_index(),
+                        ggl.get_cell_position(side, layer, row), diameter, diameter, length);
+        }
+      }
+    }
+  }
+
+  if (_calo_locator_ != 0) {
+    const calo_locator& cl = *_calo_locator_;
+    DT_THROW_IF(!cl.is_initialized(), std::logic_error, "Calo locator is not initialized !");
+    _check_module_number_(cl.get_module_number());
+    geomtools::geom_id gid;
+    for (uint32_t side = 0; side < cl.get_number_of_sides(); side++) {
+      for (uint32_t column = 0; column < cl.get_number_of_columns(side); column++) {
+        for (uint32_t row = 0; row < cl.get_number_of_rows(side); row++) {
+          const geomtools::placement& block_placement =
+              cl.get_block_world_placement(side, column, row);
+          DT_THROW_IF(!cl.find_block_geom_id(block_placement.get_translation(), gid),
+                      std::logic_error,
+                      "Cannot locate calo block [" << side << ':' << column << ':' << row << "] !");
+          // Thickness along X, columns along Y and rows along Z:
+          _add_element_(ELEMENT_CALO_BLOCK, gid, cl.get_module_address_index(),
+                        cl.get_block_position(side, column, row), cl.get_block_thickness(),
+                        cl.get_block_width(), cl.get_block_height());
+        }
+      }
+    }
+  }
+
+  if (_xcalo_locator_ != 0) {
+    const xcalo_locator& xcl = *_xcalo_locator_;
+    DT_THROW_IF(!xcl.is_initialized(), std::logic_error, "X-calo locator is not initialized !");
+    _check_module_number_(xcl.get_module_number());
+    geomtools::geom_id gid;
+    for (uint32_t side = 0; side < xcl.get_number_of_sides(); side++) {
+      for (uint32_t wall = 0; wall < xcl.get_number_of_walls(); wall++) {
+        for (uint32_t column = 0; column < xcl.get_number_of_columns(side, wall); column++) {
+          for (uint32_t row = 0; row < xcl.get_number_of_rows(side, wall); row++) {
+            const geomtools::placement& block_placement =
+                xcl.get_block_world_placement(side, wall, column, row);
+            DT_THROW_IF(!xcl.find_block_geom_id(block_placement.get_translation(), gid),
+                        std::logic_error,
+                        "Cannot locate X-calo block [" << side << ':' << wall << ':' << column
+                                                       << ':' << row << "] !");
+            // Columns along X, thickness along Y and rows along Z:
+            _add_element_(ELEMENT_XCALO_BLOCK, gid, xcl.get_module_address_index(),
+                          xcl.get_block_position(side, wall, column, row), xcl.get_block_width(),
+                          xcl.get_block_thickness(), xcl.get_block_height());
+          }
+        }
+      }
+    }
+  }
+
+  if (_gveto_locator_ != 0) {
+    const gveto_locator& gvl = *_gveto_locator_;
+    DT_THROW_IF(!gvl.is_initialized(), std::logic_error, "Gveto locator is not initialized !");
+    _check_module_number_(gvl.get_module_number());
+    geomtools::geom_id gid;
+    for (uint32_t side = 0; side < gvl.get_number_of_sides(); side++) {
+      for (uint32_t wall = 0; wall < gvl.get_number_of_walls(); wall++) {
+        for (uint32_t column = 0; column < gvl.get_number_of_columns(side, wall); column++) {
+          const geomtools::placement& block_placement =
+              gvl.get_block_world_placement(side, wall, column);
+          DT_THROW_IF(!gvl.find_block_geom_id(block_placement.get_translation(), gid),
+                      std::logic_error,
+                      "Cannot locate gveto block [" << side << ':' << wall << ':' << column
+                                                    << "] !");
+          // Width along X, columns along Y and thickness along Z:
+          _add_element_(ELEMENT_GVETO_BLOCK, gid, gvl.get_module_address_index(),
+                        gvl.get_block_position(side, wall, column), gvl.get_block_width(),
+                        gvl.get_block_height(), gvl.get_block_thickness());
+        }
+      }
+    }
+  }
+
+  _build_grid_();
+  _initialized_ = true;
+}
+
+void detector_index::reset() {
+  DT_THROW_IF(!is_initialized(), std::logic_error, "Detector index is not initialized !");
+  _initialized_ = false;
+  _element_types_.clear();
+  _element_ids_.clear();
+  _element_boxes_.clear();
+  _geom_types_.clear();
+  _voxel_offsets_.clear();
+  _voxel_elements_.clear();
+  _set_defaults_();
+}
+
+size_t detector_index::get_number_of_elements() const { return _element_types_.size(); }
+
+size_t detector_index::get_number_of_voxels() const {
+  return _voxel_offsets_.empty() ? 0 : _voxel_offsets_.size() - 1;
+}
+
+uint32_t detector_index::find_element(const geomtools::vector_3d& world_position_) const {
+  DT_THROW_IF(!is_initialized(), std::logic_error, "Detector index is not initialized !");
+  if (_element_types_.empty()) {
+    return INVALID_ELEMENT;
+  }
+  // All locators share the same module coordinate system:
+  geomtools::vector_3d position;
+  if (_gg_locator_ != 0) {
+    _gg_locator_->transform_world_to_module(world_position_, position);
+  } else if (_calo_locator_ != 0) {
+    _calo_locator_->transform_world_to_module(world_position_, position);
+  } else if (_xcalo_locator_ != 0) {
+    _xcalo_locator_->transform_world_to_module(world_position_, position);
+  } else {
+    _gveto_locator_->transform_world_to_module(world_position_, position);
+  }
+  const double coordinates[3] = {position.x(), position.y(), position.z()};
+  size_t voxel = 0;
+  for (int axis = 2; axis >= 0; axis--) {
+    const int coordinate = _voxel_coordinate_(axis, coordinates[axis]);
+    if (coordinate < 0) {
+      return INVALID_ELEMENT;
+    }
+    voxel = voxel * _grid_dimensions_[axis] + coordinate;
+  }
+  for (uint32_t i = _voxel_offsets_[voxel]; i < _voxel_offsets_[voxel + 1]; i++) {
+    const uint32_t element = _voxel_elements_[i];
+    const double* box = &_element_boxes_[6 * element];
+    if (coordinates[0] >= box[0] && coordinates[0] <= box[1] && coordinates[1] >= box[2] &&
+        coordinates[1] <= box[3] && coordinates[2] >= box[4] && coordinates[2] <= box[5]) {
+      return element;
+    }
+  }
+  return INVALID_ELEMENT;
+}
+
+detector_index::element_type detector_index::find_element(
+    const geomtools::vector_3d& world_position_, geomtools::geom_id& gid_) const {
+  const uint32_t element = find_element(world_position_);
+  if (element == INVALID_ELEMENT) {
+    gid_.invalidate();
+    return ELEMENT_INVALID;
+  }
+  gid_ = _element_ids_[element];
+  return _element_types_[element];
+}
+
+detector_index::element_type detector_index::get_element_type(uint32_t element_) const {
+  DT_THROW_IF(element_ >= _element_types_.size(), std::range_error,
+              "Invalid element index " << element_ << " !");
+  return _element_types_[element_];
+}
+
+const geomtools::geom_id& detector_index::get_element_geom_id(uint32_t element_) const {
+  DT_THROW_IF(element_ >= _element_ids_.size(), std::range_error,
+              "Invalid element index " << element_ << " !");
+  return _element_ids_[element_];
+}
+
+detector_index::element_type detector_index::get_element_type(
+    const geomtools::geom_id& gid_) const {
+  DT_THROW_IF(!is_initialized(), std::logic_error, "Detector index is not initialized !");
+  for (size_t i = 0; i < _geom_types_.size(); i++) {
+    const geom_type_entry& entry = _geom_types_[i];
+    if (entry.geom_type == gid_.get_type()) {
+      return gid_.get(entry.module_address_index) == _module_number_ ? entry.type
+                                                                     : ELEMENT_INVALID;
+    }
+  }
+  return ELEMENT_INVALID;
+}
+
+void detector_index::tree_dump(std::ostream& out_, const std::string& title_,
+                               const std::string& indent_, bool inherit_) const {
+  const std::string itag = datatools::i_tree_dumpable::tags::item();
+  if (!title_.empty()) {
+    out_ << indent_ << title_ << std::endl;
+  }
+  out_ << indent_ << itag << "Voxel size         = " << _voxel_size_ / CLHEP::mm << " mm"
+       << std::endl;
+  out_ << indent_ << itag << "Tolerance          = " << _tolerance_ / CLHEP::mm << " mm"
+       << std::endl;
+  out_ << indent_ << itag << "Number of elements = " << get_number_of_elements() << std::endl;
+  out_ << indent_ << itag << "Grid dimensions    = " << _grid_dimensions_[0] << 'x'
+       << _grid_dimensions_[1] << 'x' << _grid_dimensions_[2] << std::endl;
+  out_ << indent_ << itag << "Number of entries  = " << _voxel_elements_.size() << std::endl;
+  out_ << indent_ << datatools::i_tree_dumpable::inherit_tag(inherit_)
+       << "Initialized        = " << _initialized_ << std::endl;
+}
+
+void detector_index::_add_element_(element_type type_, const geomtools::geom_id& gid_,
+                                   int module_index_, const geomtools::vector_3d& center_,
+                                   double dx_, double dy_, double dz_) {
+  if (_element_types_.empty() || _element_types_.back() != type_) {
+    const geom_type_entry entry = {gid_.get_type(), type_, module_index_};
+    _geom_types_.push_back(entry);
+  }
+  _element_types_.push_back(type_);
+  _element_ids_.push_back(gid_);
+  const double half_sizes[3] = {0.5 * dx_ + _tolerance_, 0.5 * dy_ + _tolerance_,
+                                0.5 * dz_ + _tolerance_};
+  const double center[3] = {center_.x(), center_.y(), center_.z()};
+  for (int axis = 0; axis < 3; axis++) {
+    _element_boxes_.push_back(center[axis] - half_sizes[axis]);
+    _element_boxes_.push_back(center[axis] + half_sizes[axis]);
+  }
+}
+
+void detector_index::_check_module_number_(uint32_t module_number_) {
+  if (_element_types_.empty()) {
+    _module_number_ = module_number_;
+  }
+  DT_THROW_IF(module_number_ != _module_number_, std::logic_error,
+              "Locators of modules " << _module_number_ << " and " << module_number_
+                                     << " cannot be indexed together !");
+}
+
+void detector_index::_build_grid_() {
+  const size_t nelements = _element_types_.size();
+  if (nelements == 0) {
+    return;
+  }
+  DT_THROW_IF(nelements >= INVALID_ELEMENT, std::range_error, "Too many elements !");
+  for (int axis = 0; axis < 3; axis++) {
+    double lower = std::numeric_limits<double>::max();
+    double upper = -std::numeric_limits<double>::max();
+    for (size_t element = 0; element < nelements; element++) {
+      lower = std::min(lower, _element_boxes_[6 * element + 2 * axis]);
+      upper = std::max(upper, _element_boxes_[6 * element + 2 * axis + 1]);
+    }
+    _grid_origin_[axis] = lower;
+    _grid_dimensions_[axis] = static_cast<uint32_t>(std::ceil((upper - lower) / _voxel_size_));
+    if (_grid_dimensions_[axis] == 0) {
+      _grid_dimensions_[axis] = 1;
+    }
+  }
+
+  // Voxel ranges covered by each element:
+  std::vector<int> ranges(6 * nelements);
+  for (size_t element = 0; element < nelements; element++) {
+    for (int axis = 0; axis < 3; axis++) {
+      const double* box = &_element_boxes_[6 * element + 2 * axis];
+      const int last = static_cast<int>(_grid_dimensions_[axis]) - 1;
+      ranges[6 * element + 2 * axis] =
+          std::min(last, static_cast<int>((box[0] - _grid_origin_[axis]) / _voxel_size_));
+      ranges[6 * element + 2 * axis + 1] =
+          std::min(last, static_cast<int>((box[1] - _grid_origin_[axis]) / _voxel_size_));
+    }
+  }
+
+  // Count, then fill the elements of each voxel:
+  const size_t nvoxels = static_cast<size_t>(_grid_dimensions_[0]) * _grid_dimensions_[1] *
+                         _grid_dimensions_[2];
+  _voxel_offsets_.assign(nvoxels + 1, 0);
+  for (int pass = 0; pass < 2; pass++) {
+    std::vector<uint32_t> cursors;
+    if (pass == 1) {
+      for (size_t voxel = 0; voxel < nvoxels; voxel++) {
+        _voxel_offsets_[voxel + 1] += _voxel_offsets_[voxel];
+      }
+      _voxel_elements_.assign(_voxel_offsets_.back(), INVALID_ELEMENT);
+      cursors.assign(_voxel_offsets_.begin(), _voxel_offsets_.end() - 1);
+    }
+    for (size_t element = 0; element < nelements; element++) {
+      const int* range = &ranges[6 * element];
+      for (int iz = range[4]; iz <= range[5]; iz++) {
+        for (int iy = range[2]; iy <= range[3]; iy++) {
+          for (int ix = range[0]; ix <= range[1]; ix++) {
+            const size_t voxel = (static_cast<size_t>(iz) * _grid_dimensions_[1] + iy) *
+                                     _grid_dimensions_[0] +
+                                 ix;
+            if (pass == 0) {
+              _voxel_offsets_[voxel + 1]++;
+            } else {
+              _voxel_elements_[cursors[voxel]++] = element;
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+int detector_index::_voxel_coordinate_(int axis_, double position_) const {
+  const double coordinate = (position_ - _grid_origin_[axis_]) / _voxel_size_;
+  if (!(coordinate >= 0.0) || coordinate >= _grid_dimensions_[axis_]) {
+    return -1;
+  }
+  return static_cast<int>(coordinate);
+}
+
+void detector_index::_set_defaults_() {
+  _initialized_ = false;
+  _voxel_size_ = default_voxel_size();
+  _tolerance_ = 1.0 * CLHEP::micrometer;
+  _gg_locator_ = 0;
+  _calo_locator_ = 0;
+  _xcalo_locator_ = 0;
+  _gveto_locator_ = 0;
+  _module_number_ = 0;
+  for (int axis = 0; axis < 3; axis++) {
+    _grid_origin_[axis] = 0.0;
+    _grid_dimensions_[axis] = 0;
+  }
+}
+
+}  // end of namespace geometry
+
+}  // end of namespace snemo
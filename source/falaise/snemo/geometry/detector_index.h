@@ -0,0 +1,195 @@
+/// \file falaise/snemo/geometry/detector_index.h
+/* Creation date: 2026-10-18
+ * Last modified: 2026-10-18
+ *
+ * License:
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public  License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Description:
+ *
+ *   Spatial index of the drift cells and scintillator blocks of a module
+ *
+ * History:
+ *
+ */
+
+#ifndef FALAISE_SNEMO_GEOMETRY_DETECTOR_INDEX_H
+#define FALAISE_SNEMO_GEOMETRY_DETECTOR_INDEX_H 1
+
+// Standard library:
+#include <vector>
+
+// Third party:
+// - Boost :
+#include <boost/cstdint.hpp>
+// - Bayeux/datatools:
+#include <datatools/i_tree_dump.h>
+// - Bayeux/geomtools:
+#include <geomtools/geom_id.h>
+#include <geomtools/utils.h>
+
+namespace snemo {
+
+namespace geometry {
+
+class gg_locator;
+class calo_locator;
+class xcalo_locator;
+class gveto_locator;
+
+/** \brief Spatial index of the detector elements of a SuperNEMO module
+ *
+ *  The index answers, with a single lookup, which drift cell, main wall,
+ *  X-wall or gamma-veto block contains a given world position, instead of
+ *  querying each locator in turn. At initialization, the bounding box of
+ *  each element, in the module coordinate system, is registered in the
+ *  voxels of a uniform grid covering all the elements. A lookup only tests
+ *  the few elements registered in the voxel of the position.
+ *
+ *  The index also classifies a geometry ID by its element type, from the
+ *  geometry types and module number recorded at initialization, without
+ *  querying each locator in turn.
+ */
+class detector_index : public datatools::i_tree_dumpable {
+ public:
+  /// Type of a detector element
+  enum element_type {
+    ELEMENT_INVALID = 0,      ///< Not a detector element
+    ELEMENT_DRIFT_CELL = 1,   ///< Drift cell of the tracker
+    ELEMENT_CALO_BLOCK = 2,   ///< Main wall scintillator block
+    ELEMENT_XCALO_BLOCK = 3,  ///< X-wall scintillator block
+    ELEMENT_GVETO_BLOCK = 4   ///< Gamma-veto scintillator block
+  };
+
+  /// Index of an invalid element
+  static const uint32_t INVALID_ELEMENT = 0xFFFFFFFF;
+
+  /// Default voxel size
+  static double default_voxel_size();
+
+  /// Default constructor
+  detector_index();
+
+  /// Destructor
+  virtual ~detector_index();
+
+  /// Check initialization flag
+  bool is_initialized() const;
+
+  /// Set the size of the voxels
+  void set_voxel_size(double voxel_size_);
+
+  /// Return the size of the voxels
+  double get_voxel_size() const;
+
+  /// Set the tolerance on the boundaries of the elements
+  void set_tolerance(double tolerance_);
+
+  /// Return the tolerance on the boundaries of the elements
+  double get_tolerance() const;
+
+  /// Initialize the index from initialized locators of the same module, any of which may be
+  /// missing (null)
+  void initialize(const gg_locator* gg_locator_, const calo_locator* calo_locator_,
+                  const xcalo_locator* xcalo_locator_, const gveto_locator* gveto_locator_);
+
+  /// Reset
+  void reset();
+
+  /// Return the number of registered elements
+  size_t get_number_of_elements() const;
+
+  /// Return the number of voxels of the grid
+  size_t get_number_of_voxels() const;
+
+  /// Return the index of the element whose box, widened by the tolerance, contains a world
+  /// position, INVALID_ELEMENT if none
+  uint32_t find_element(const geomtools::vector_3d& world_position_) const;
+
+  /// Find the element containing a world position and return its type
+  element_type find_element(const geomtools::vector_3d& world_position_,
+                            geomtools::geom_id& gid_) const;
+
+  /// Return the type of an element
+  element_type get_element_type(uint32_t element_) const;
+
+  /// Return the geometry ID of an element
+  const geomtools::geom_id& get_element_geom_id(uint32_t element_) const;
+
+  /// Return the type of the element of the indexed module with a given geometry ID
+  element_type get_element_type(const geomtools::geom_id& gid_) const;
+
+  /// Smart print
+  virtual void tree_dump(std::ostream& out_ = std::clog, const std::string& title_ = "",
+                         const std::string& indent_ = "", bool inherit_ = false) const;
+
+ private:
+  /// Element type of a geometry type, with the address index of the module number
+  struct geom_type_entry {
+    uint32_t geom_type;        //!< Geometry type
+    element_type type;         //!< Element type
+    int module_address_index;  //!< Index of the module number in the geometry IDs
+  };
+
+  /// Register an element with its bounding box in the module coordinate system
+  void _add_element_(element_type type_, const geomtools::geom_id& gid_, int module_index_,
+                     const geomtools::vector_3d& center_, double dx_, double dy_, double dz_);
+
+  /// Check that a locator indexes the same module as the previous ones
+  void _check_module_number_(uint32_t module_number_);
+
+  /// Build the voxel grid from the registered elements
+  void _build_grid_();
+
+  /// Return the voxel coordinate along an axis, -1 if out of the grid
+  int _voxel_coordinate_(int axis_, double position_) const;
+
+  /// Set default attributes values
+  void _set_defaults_();
+
+ private:
+  bool _initialized_;                    //!< Initialization flag
+  double _voxel_size_;                   //!< Size of the voxels
+  double _tolerance_;                    //!< Tolerance on the boundaries of the elements
+  const gg_locator* _gg_locator_;        //!< Geiger locator
+  const calo_locator* _calo_locator_;    //!< Main wall locator
+  const xcalo_locator* _xcalo_locator_;  //!< X-wall locator
+  const gveto_locator* _gveto_locator_;  //!< Gamma-veto locator
+
+  std::vector<element_type> _element_types_;      //!< Type of the elements
+  std::vector<geomtools::geom_id> _element_ids_;  //!< Geometry ID of the elements
+  std::vector<double> _element_boxes_;  //!< Boxes (xmin, xmax, ymin, ymax, zmin, zmax)
+  std::vector<geom_type_entry> _geom_types_;  //!< Element type of the geometry types
+  uint32_t _module_number_;                   //!< Number of the indexed module
+
+  double _grid_origin_[3];                 //!< Lower corner of the grid
+  uint32_t _grid_dimensions_[3];           //!< Number of voxels along each axis
+  std::vector<uint32_t> _voxel_offsets_;   //!< First registered element of each voxel
+  std::vector<uint32_t> _voxel_elements_;  //!< Registered elements, grouped by voxel
+};
+
+}  // end of namespace geometry
+
+}  // end of namespace snemo
+
+#endif  // FALAISE_SNEMO_GEOMETRY_DETECTOR_INDEX_H
+
+// Local Variables: --
+// mode: c++ --
+// c-file-style: "gnu" --
+// tab-width: 2 --
+// End: --
@@ -0,0 +1,214 @@
+// falaise/snemo/geometry/geom_info_table.cc
+
+// Ourselves:
+#include <falaise/snemo/geometry/geom_info_table.h>
+
+// Standard library:
+#include <algorithm>
+#include <stdexcept>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+// - Bayeux/geomtools:
+#include <geomtools/id_mgr.h>
+#include <geomtools/manager.h>
+#include <geomtools/mapping.h>
+
+namespace snemo {
+
+namespace geometry {
+
+namespace {
+
+/// Maximum number of slots of a dense table
+const size_t MAX_SLOTS = 0x1000000;
+
+/// Check if all the address values of a geometry ID are plain values
+bool has_plain_address(const geomtools::geom_id& gid_) {
+  for (uint32_t i = 0; i < gid_.get_depth(); i++) {
+    if (gid_.get(i) >= channel_key::MAX_ADDRESS) return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+geom_info_table::geom_info_table() {
+  _initialized_ = false;
+  _type_ = geomtools::geom_id::INVALID_TYPE;
+  _depth_ = 0;
+  for (uint32_t i = 0; i < channel_key::MAX_DEPTH; i++) {
+    _extents_[i] = 0;
+  }
+  _number_of_entries_ = 0;
+}
+
+geom_info_table::~geom_info_table() {
+  if (is_initialized()) {
+    reset();
+  }
+}
+
+bool geom_info_table::is_initialized() const { return _initialized_; }
+
+void geom_info_table::initialize(const geomtools::manager& geo_manager_,
+                                 const std::string& category_,
+                                 const std::string& module_category_) {
+  DT_THROW_IF(is_initialized(), std::logic_error, "Geometry info table is already initialized !");
+  const geomtools::id_mgr& id_manager = geo_manager_.get_id_mgr();
+  DT_THROW_IF(!id_manager.has_category_info(category_), std::logic_error,
+              "Unknown geometry category '" << category_ << "' !");
+  const geomtools::mapping& the_mapping = geo_manager_.get_mapping();
+  const uint32_t type = id_manager.get_category_info(category_).get_type();
+  DT_THROW_IF(type >= channel_key::MAX_TYPE, std::range_error,
+              "Geometry type " << type << " cannot be packed in a channel key !");
+
+  // Collect the mapped volumes of the category and the range of their addresses:
+  std::vector<const geomtools::geom_info*> ginfos;
+  uint32_t depth = 0;
+  uint32_t extents[channel_key::MAX_DEPTH] = {0};
+  const geomtools::geom_info_dict_type& all_ginfos = the_mapping.get_geom_infos();
+  for (geomtools::geom_info_dict_type::const_iterator it = all_ginfos.begin();
+       it != all_ginfos.end(); ++it) {
+    const geomtools::geom_id& gid = it->first;
+    if (gid.get_type() != type || !has_plain_address(gid)) continue;
+    DT_THROW_IF(gid.get_depth() > channel_key::MAX_DEPTH, std::range_error,
+                "Geometry ID " << gid << " cannot be packed in a channel key !");
+    if (ginfos.empty()) {
+      depth = gid.get_depth();
+    }
+    DT_THROW_IF(gid.get_depth() != depth, std::logic_error,
+                "Geometry ID " << gid << " has not the depth " << depth << " of its category !");
+    for (uint32_t i = 0; i < depth; i++) {
+      extents[i] = std::max(extents[i], gid.get(i) + 1);
+    }
+    ginfos.push_back(&it->second);
+  }
+  DT_THROW_IF(ginfos.empty(), std::logic_error,
+              "No mapped volume in geometry category '" << category_ << "' !");
+  size_t nslots = 1;
+  for (uint32_t i = 0; i < depth; i++) {
+    nslots *= extents[i];
+    DT_THROW_IF(nslots > MAX_SLOTS, std::range_error,
+                "Too sparse addresses in geometry category '" << category_ << "' !");
+  }
+
+  _category_ = category_;
+  _type_ = type;
+  _depth_ = depth;
+  for (uint32_t i = 0; i < channel_key::MAX_DEPTH; i++) {
+    _extents_[i] = extents[i];
+  }
+  entry invalid_entry;
+  invalid_entry.ginfo = 0;
+  for (size_t i = 0; i < 12; i++) {
+    invalid_entry.transform[i] = 0.0;
+  }
+  geomtools::invalidate(invalid_entry.world_position);
+  geomtools::invalidate(invalid_entry.module_position);
+  _entries_.assign(nslots, invalid_entry);
+
+  // Fill the entries:
+  const geomtools::vector_3d origin(0.0, 0.0, 0.0);
+  geomtools::geom_id module_gid;
+  id_manager.make_id(module_category_, module_gid);
+  for (size_t ientry = 0; ientry < ginfos.size(); ientry++) {
+    const geomtools::geom_info& ginfo = *ginfos[ientry];
+    const geomtools::placement& world_placement = ginfo.get_world_placement();
+    size_t slot = 0;
+    for (uint32_t i = 0; i < _depth_; i++) {
+      slot = slot * _extents_[i] + ginfo.get_id().get(i);
+    }
+    entry& e = _entries_[slot];
+    e.ginfo = &ginfo;
+
+    // The world to local transform is affine: it is sampled on the origin and
+    // the unit vectors of the world frame:
+    geomtools::vector_3d local_origin;
+    world_placement.mother_to_child(origin, local_origin);
+    for (uint32_t axis = 0; axis < 3; axis++) {
+      geomtools::vector_3d unit(0.0, 0.0, 0.0);
+      unit[axis] = 1.0;
+      geomtools::vector_3d local_unit;
+      world_placement.mother_to_child(unit, local_unit);
+      for (uint32_t row = 0; row < 3; row++) {
+        e.transform[4 * row + axis] = local_unit[row] - local_origin[row];
+      }
+    }
+    for (uint32_t row = 0; row < 3; row++) {
+      e.transform[4 * row + 3] = local_origin[row];
+    }
+
+    world_placement.child_to_mother(origin, e.world_position);
+    id_manager.extract(ginfo.get_id(), module_gid);
+    if (the_mapping.validate_id(module_gid)) {
+      the_mapping.get_geom_info(module_gid)
+          .get_world_placement()
+          .mother_to_child(e.world_position, e.module_position);
+    }
+  }
+  _number_of_entries_ = ginfos.size();
+
+  _initialized_ = true;
+}
+
+void geom_info_table::reset() {
+  DT_THROW_IF(!is_initialized(), std::logic_error, "Geometry info table is not initialized !");
+  _initialized_ = false;
+  _entries_.clear();
+  _number_of_entries_ = 0;
+  for (uint32_t i = 0; i < channel_key::MAX_DEPTH; i++) {
+    _extents_[i] = 0;
+  }
+  _depth_ = 0;
+  _type_ = geomtools::geom_id::INVALID_TYPE;
+  _category_.clear();
+}
+
+const std::string& geom_info_table::get_category() const { return _category_; }
+
+uint32_t geom_info_table::get_type() const { return _type_; }
+
+size_t geom_info_table::get_number_of_entries() const { return _number_of_entries_; }
+
+size_t geom_info_table::get_number_of_slots() const { return _entries_.size(); }
+
+const geom_info_table::entry* geom_info_table::find(const geomtools::geom_id& gid_) const {
+  if (gid_.get_type() != _type_ || !channel_key::can_pack(gid_)) {
+    return 0;
+  }
+  return find(channel_key(gid_));
+}
+
+const geom_info_table::entry& geom_info_table::get(const channel_key& key_) const {
+  const entry* e = find(key_);
+  DT_THROW_IF(e == 0, std::logic_error,
+              "Channel " << key_ << " is not registered in category '" << _category_ << "' !");
+  return *e;
+}
+
+void geom_info_table::tree_dump(std::ostream& out_, const std::string& title_,
+                                const std::string& indent_, bool inherit_) const {
+  if (!title_.empty()) {
+    out_ << indent_ << title_ << std::endl;
+  }
+  out_ << indent_ << datatools::i_tree_dumpable::tag << "Initialized : " << _initialized_
+       << std::endl;
+  out_ << indent_ << datatools::i_tree_dumpable::tag << "Category : '" << _category_ << "' (type "
+       << _type_ << ")" << std::endl;
+  out_ << indent_ << datatools::i_tree_dumpable::tag << "Extents : [";
+  for (uint32_t i = 0; i < _depth_; i++) {
+    if (i != 0) out_ << ':';
+    out_ << _extents_[i];
+  }
+  out_ << ']' << std::endl;
+  out_ << indent_ << datatools::i_tree_dumpable::tag
+       << "Number of entries : " << _number_of_entries_ << std::endl;
+  out_ << indent_ << datatools::i_tree_dumpable::inherit_tag(inherit_)
+       << "Number of slots : " << _entries_.size() << std::endl;
+}
+
+}  // end of namespace geometry
+
+}  // end of namespace snemo
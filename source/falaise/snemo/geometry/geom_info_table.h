@@ -0,0 +1,175 @@
+/// \file falaise/snemo/geometry/geom_info_table.h
+/* Creation date: 2026-10-18
+ * Last modified: 2026-10-18
+ *
+ * License:
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public  License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Description:
+ *
+ *   Dense table of the placements of the volumes of a geometry category
+ *
+ * History:
+ *
+ */
+
+#ifndef FALAISE_SNEMO_GEOMETRY_GEOM_INFO_TABLE_H
+#define FALAISE_SNEMO_GEOMETRY_GEOM_INFO_TABLE_H 1
+
+// Standard library:
+#include <string>
+#include <vector>
+
+// Third party:
+// - Boost :
+#include <boost/cstdint.hpp>
+// - Bayeux/datatools:
+#include <datatools/i_tree_dump.h>
+// - Bayeux/geomtools:
+#include <geomtools/geom_info.h>
+#include <geomtools/utils.h>
+
+// This project:
+#include <falaise/snemo/geometry/channel_key.h>
+
+namespace geomtools {
+class manager;
+}
+
+namespace snemo {
+
+namespace geometry {
+
+/** \brief Dense table of the placements of the volumes of a geometry category
+ *
+ *  The table holds, for each volume of a category like the drift cells
+ *  ("drift_cell_core") or the main wall blocks ("calorimeter_block"), its
+ *  geometry information, its world to local transform reduced to a 3x3
+ *  matrix and an offset, and the positions of its center in the world and
+ *  module coordinate systems. It is filled once from the geometry mapping.
+ *
+ *  Entries are stored in a dense array whose index is computed from the
+ *  address values of the channel key of a volume, so that the lookup
+ *  avoids both the geometry ID keyed search of the mapping and the general
+ *  placement transform in the hot loops of the processing modules.
+ */
+class geom_info_table : public datatools::i_tree_dumpable {
+ public:
+  /// \brief Cached geometry data of a volume
+  struct entry {
+    /// Check the validity of the entry
+    bool is_valid() const { return ginfo != 0; }
+
+    /// Compute the position in the local coordinate system of the volume
+    void world_to_local(const geomtools::vector_3d& world_position_,
+                        geomtools::vector_3d& local_position_) const {
+      const double x = world_position_.x();
+      const double y = world_position_.y();
+      const double z = world_position_.z();
+      local_position_.set(transform[0] * x + transform[1] * y + transform[2] * z + transform[3],
+                          transform[4] * x + transform[5] * y + transform[6] * z + transform[7],
+                          transform[8] * x + transform[9] * y + transform[10] * z + transform[11]);
+    }
+
+    /// Return the local Z coordinate of a world position
+    double world_to_local_z(const geomtools::vector_3d& world_position_) const {
+      return transform[8] * world_position_.x() + transform[9] * world_position_.y() +
+             transform[10] * world_position_.z() + transform[11];
+    }
+
+    const geomtools::geom_info* ginfo;     //!< Geometry information from the mapping
+    double transform[12];                  //!< World to local transform (3x4 row major)
+    geomtools::vector_3d world_position;   //!< Center of the volume in the world frame
+    geomtools::vector_3d module_position;  //!< Center of the volume in its module frame
+  };
+
+  /// Default constructor
+  geom_info_table();
+
+  /// Destructor
+  virtual ~geom_info_table();
+
+  /// Check initialization flag
+  bool is_initialized() const;
+
+  /// Initialize the table with all the mapped volumes of a geometry category
+  void initialize(const geomtools::manager& geo_manager_, const std::string& category_,
+                  const std::string& module_category_ = "module");
+
+  /// Reset
+  void reset();
+
+  /// Return the geometry category
+  const std::string& get_category() const;
+
+  /// Return the geometry type of the category
+  uint32_t get_type() const;
+
+  /// Return the number of registered volumes
+  size_t get_number_of_entries() const;
+
+  /// Return the number of slots of the dense table
+  size_t get_number_of_slots() const;
+
+  /// Return the entry of a volume, or null if it is not registered
+  const entry* find(const channel_key& key_) const {
+    if (key_.get_type() != _type_ || key_.get_depth() != _depth_) {
+      return 0;
+    }
+    size_t slot = 0;
+    for (uint32_t i = 0; i < _depth_; i++) {
+      const uint32_t address = key_.get(i);
+      if (address >= _extents_[i]) {
+        return 0;
+      }
+      slot = slot * _extents_[i] + address;
+    }
+    const entry& e = _entries_[slot];
+    return e.is_valid() ? &e : 0;
+  }
+
+  /// Return the entry of a volume, or null if it is not registered
+  const entry* find(const geomtools::geom_id& gid_) const;
+
+  /// Return the entry of a volume, throw if it is not registered
+  const entry& get(const channel_key& key_) const;
+
+  /// Smart print
+  virtual void tree_dump(std::ostream& out_ = std::clog, const std::string& title_ = "",
+                         const std::string& indent_ = "", bool inherit_ = false) const;
+
+ private:
+  bool _initialized_;                          //!< Initialization flag
+  std::string _category_;                      //!< Geometry category
+  uint32_t _type_;                             //!< Geometry type of the category
+  uint32_t _depth_;                            //!< Number of address values
+  uint32_t _extents_[channel_key::MAX_DEPTH];  //!< Number of values of each address
+  size_t _number_of_entries_;                  //!< Number of registered volumes
+  std::vector<entry> _entries_;                //!< Dense array of entries
+};
+
+}  // end of namespace geometry
+
+}  // end of namespace snemo
+
+#endif  // FALAISE_SNEMO_GEOMETRY_GEOM_INFO_TABLE_H
+
+// Local Variables: --
+// mode: c++ --
+// c-file-style: "gnu" --
+// tab-width: 2 --
+// End: --
@@ -22,6 +22,8 @@
 #include <falaise/snemo/geometry/gg_locator.h>
 
 // Standard library:
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
 
 // Third party
@@ -38,6 +40,9 @@ namespace snemo {
 
 namespace geometry {
 
+const gg_locator::cell_id_type gg_locator::INVALID_CELL_ID;
+const size_t gg_locator::MAX_NEIGHBOURS;
+
 bool gg_locator::is_initialized() const { return _initialized_; }
 
 double gg_locator::get_cell_diameter() const {
@@ -179,12 +184,78 @@ void gg_locator::get_neighbours_ids(const geomtools::geom_id &gid_,
 
 void gg_locator::get_neighbours_ids(uint32_t side_, uint32_t layer_, uint32_t row_,
                                     std::vector<geomtools::geom_id> &ids_, bool other_side_) const {
+  const cell_id_range neighbours = get_neighbour_cell_ids(side_, layer_, row_, other_side_);
+  ids_.resize(neighbours.size());
+  for (size_t i = 0; i < neighbours.size(); i++) {
+    make_cell_geom_id(neighbours[i], ids_[i]);
+  }
+  return;
+}
+
+gg_locator::cell_id_range gg_locator::get_neighbour_cell_ids(uint32_t side_, uint32_t layer_,
+                                                             uint32_t row_,
+                                                             bool other_side_) const {
   DT_THROW_IF(!is_initialized(), std::logic_error, "Locator is not initialized !");
+  const size_t cell_index = _cell_index(side_, layer_, row_);
+  const size_t table = other_side_ ? 1 : 0;
+  const cell_id_type *first = &_neighbour_cell_ids_[table][cell_index * MAX_NEIGHBOURS];
+  return cell_id_range(first, first + _number_of_neighbour_cells_[table][cell_index]);
+}
+
+gg_locator::cell_id_range gg_locator::get_neighbour_cell_ids(cell_id_type cell_id_,
+                                                             bool other_side_) const {
+  return get_neighbour_cell_ids(cell_id_side(cell_id_), cell_id_layer(cell_id_),
+                                cell_id_row(cell_id_), other_side_);
+}
+
+size_t gg_locator::_cell_index(uint32_t side_, uint32_t layer_, uint32_t row_) const {
+  DT_THROW_IF(side_ != utils::SIDE_BACK && side_ != utils::SIDE_FRONT, std::logic_error,
+              "Invalid side number (" << side_ << "> 1)!");
+  const std::vector<double> &cell_x = (side_ == utils::SIDE_BACK) ? _back_cell_x_ : _front_cell_x_;
+  const std::vector<double> &cell_y = (side_ == utils::SIDE_BACK) ? _back_cell_y_ : _front_cell_y_;
+  DT_THROW_IF(layer_ >= cell_x.size(), std::logic_error,
+              "Invalid layer number (" << layer_ << ">" << cell_x.size() - 1 << ")!");
+  DT_THROW_IF(row_ >= cell_y.size(), std::logic_error,
+              "Invalid row number (" << row_ << ">" << cell_y.size() - 1 << ")!");
+  return _side_cell_offset_[side_] + layer_ * cell_y.size() + row_;
+}
+
+void gg_locator::_build_neighbour_table() {
+  // Dense indexing of the cells, side by side, then layer by layer:
+  _side_cell_offset_[utils::SIDE_BACK] = 0;
+  _side_cell_offset_[utils::SIDE_FRONT] = _back_cell_x_.size() * _back_cell_y_.size();
+  const size_t ncells =
+      _side_cell_offset_[utils::SIDE_FRONT] + _front_cell_x_.size() * _front_cell_y_.size();
+  std::vector<cell_id_type> ids;
+  for (size_t table = 0; table < 2; table++) {
+    _neighbour_cell_ids_[table].assign(ncells * MAX_NEIGHBOURS, INVALID_CELL_ID);
+    _number_of_neighbour_cells_[table].assign(ncells, 0);
+    for (uint32_t side = 0; side < utils::NSIDES; side++) {
+      const bool back = (side == utils::SIDE_BACK);
+      const size_t nlayers = back ? _back_cell_x_.size() : _front_cell_x_.size();
+      const size_t nrows = back ? _back_cell_y_.size() : _front_cell_y_.size();
+      for (uint32_t layer = 0; layer < nlayers; layer++) {
+        for (uint32_t row = 0; row < nrows; row++) {
+          _compute_neighbour_cell_ids(side, layer, row, ids, table == 1);
+          const size_t cell_index = _cell_index(side, layer, row);
+          std::copy(ids.begin(), ids.end(),
+                    _neighbour_cell_ids_[table].begin() + cell_index * MAX_NEIGHBOURS);
+          _number_of_neighbour_cells_[table][cell_index] = ids.size();
+        }
+      }
+    }
+  }
+  return;
+}
+
+void gg_locator::_compute_neighbour_cell_ids(uint32_t side_, uint32_t layer_, uint32_t row_,
+                                             std::vector<cell_id_type> &ids_,
+                                             bool other_side_) const {
   DT_THROW_IF(side_ != utils::SIDE_BACK && side_ != utils::SIDE_FRONT, std::logic_error,
               "Invalid side number (" << side_ << "> 1)!");
 
   ids_.clear();
-  ids_.reserve(8);
+  ids_.reserve(MAX_NEIGHBOURS);
 
   // back
   if (side_ == utils::SIDE_BACK) {
@@ -198,7 +269,7 @@ void gg_locator::get_neighbours_ids(uint32_t side_, uint32_t layer_, uint32_t ro
        *  [ ][.][x]
        *  [ ][ ][ ]
        */
-      ids_.push_back(geomtools::geom_id(_cell_type_, _module_number_, side_, layer_ - 1, row_));
+      ids_.push_back(make_cell_id(side_, layer_ - 1, row_));
     }
     if (layer_ < (_back_cell_x_.size() - 1)) {
       /*  L+1 L L-1
@@ -206,7 +277,7 @@ void gg_locator::get_neighbours_ids(uint32_t side_, uint32_t layer_, uint32_t ro
        *  [x][.][ ] R
        *  [ ][ ][ ] R-1
        */
-      ids_.push_back(geomtools::geom_id(_cell_type_, _module_number_, side_, layer_ + 1, row_));
+      ids_.push_back(make_cell_id(side_, layer_ + 1, row_));
     }
     if (row_ > 0) {
       /*  L+1 L L-1
@@ -214,7 +285,7 @@ void gg_locator::get_neighbours_ids(uint32_t side_, uint32_t layer_, uint32_t ro
        *  [ ][.][ ] R
        *  [ ][x][ ] R-1
        */
-      ids_.push_back(geomtools::geom_id(_cell_type_, _module_number_, side_, layer_, row_ - 1));
+      ids_.push_back(make_cell_id(side_, layer_, row_ - 1));
     }
     if (row_ < (_back_cell_y_.size() - 1)) {
       /*  L+1 L L-1
@@ -222,7 +293,7 @@ void gg_locator::get_neighbours_ids(uint32_t side_, uint32_t layer_, uint32_t ro
        *  [ ][.][ ] R
        *  [ ][ ][ ] R-1
        */
-      ids_.push_back(geomtools::geom_id(_cell_type_, _module_number_, side_, layer_, row_ + 1));
+      ids_.push_back(make_cell_id(side_, layer_, row_ + 1));
     }
 
     if ((layer_ < (_back_cell_x_.size() - 1)) && (row_ > 0)) {
@@ -231,7 +302,7 @@ void gg_locator::get_neighbours_ids(uint32_t side_, uint32_t layer_, uint32_t ro
        *  [ ][.][ ] R
        *  [x][ ][ ] R-1
        */
-      ids_.push_back(geomtools::geom_id(_cell_type_, _module_number_, side_, layer_ + 1, row_ - 1));
+      ids_.push_back(make_cell_id(side_, layer_ + 1, row_ - 1));
     }
     if ((layer_ < (_back_cell_x_.size() - 1)) && (row_ < (_back_cell_y_.size() - 1))) {
       /*  L+1 L L-1
@@ -239,7 +310,7 @@ void gg_locator::get_neighbours_ids(uint32_t side_, uint32_t layer_, uint32_t ro
        *  [ ][.][ ] R
        *  [ ][ ][ ] R-1
        */
-      ids_.push_back(geomtools::geom_id(_cell_type_, _module_number_, side_, layer_ + 1, row_ + 1));
+      ids_.push_back(make_cell_id(side_, layer_ + 1, row_ + 1));
     }
     if ((layer_ > 0) && (row_ > 0)) {
       /*  L+1 L L-1
@@ -247,7 +318,7 @@ void gg_locator::get_neighbours_ids(uint32_t side_, uint32_t layer_, uint32_t ro
        *  [ ][.][ ] R
        *  [ ][ ][x] R-1
        */
-      ids_.push_back(geomtools::geom_id(_cell_type_, _module_number_, side_, layer_ - 1, row_ - 1));
+      ids_.push_back(make_cell_id(side_, layer_ - 1, row_ - 1));
     }
     if ((layer_ > 0) && (row_ < (_back_cell_y_.size() - 1))) {
       /*  L+1 L L-1
@@ -255,7 +326,7 @@ void gg_locator::get_neighbours_ids(uint32_t side_, uint32_t layer_, uint32_t ro
        *  [ ][.][ ] R
        *  [ ][ ][ ] R-1
        */
-      ids_.push_back(geomtools::geom_id(_cell_type_, _module_number_, side_, layer_ - 1, row_ + 1));
+      ids_.push_back(make_cell_id(side_, layer_ - 1, row_ + 1));
     }
     if ((layer_ == 0) && (row_ > 0) && other_side_) {
       /*   1  0     0
@@ -263,7 +334,7 @@ void gg_locator::get_neighbours_ids(uint32_t side_, uint32_t layer_, uint32_t ro
        *  [ ][.] | [ ] R
        *  [ ][ ] | [x] R-1
        */
-      ids_.push_back(geomtools::geom_id(_cell_type_, _module_number_, side_ + 1, 0, row_ - 1));
+      ids_.push_back(make_cell_id(side_ + 1, 0, row_ - 1));
     }
     if ((layer_ == 0) && other_side_) {
       /*   1  0     0
@@ -271,7 +342,7 @@ void gg_locator::get_neighbours_ids(uint32_t side_, uint32_t layer_, uint32_t ro
        *  [ ][.] | [x] R
        *  [ ][ ] | [ ] R-1
        */
-      ids_.push_back(geomtools::geom_id(_cell_type_, _module_number_, side_ + 1, 0, row_));
+      ids_.push_back(make_cell_id(side_ + 1, 0, row_));
     }
     if ((layer_ == 0) && (row_ < (_back_cell_y_.size() - 1)) && other_side_) {
       /*   1  0     0
@@ -279,7 +350,7 @@ void gg_locator::get_neighbours_ids(uint32_t side_, uint32_t layer_, uint32_t ro
        *  [ ][.] | [ ] R
        *  [ ][ ] | [ ] R-1
        */
-      ids_.push_back(geomtools::geom_id(_cell_type_, _module_number_, side_ + 1, 0, row_ + 1));
+      ids_.push_back(make_cell_id(side_ + 1, 0, row_ + 1));
     }
   }
   // front:
@@ -294,7 +365,7 @@ void gg_locator::get_neighbours_ids(uint32_t side_, uint32_t layer_, uint32_t ro
        *  [x][.][ ]
        *  [ ][ ][ ]
        */
-      ids_.push_back(geomtools::geom_id(_cell_type_, _module_number_, side_, layer_ - 1, row_));
+      ids_.push_back(make_cell_id(side_, layer_ - 1, row_));
     }
     if (layer_ < (_front_cell_x_.size() - 1)) {
       /*  L-1 L L+1
@@ -302,7 +373,7 @@ void gg_locator::get_neighbours_ids(uint32_t side_, uint32_t layer_, uint32_t ro
        *  [ ][.][x] R
        *  [ ][ ][ ] R-1
        */
-      ids_.push_back(geomtools::geom_id(_cell_type_, _module_number_, side_, layer_ + 1, row_));
+      ids_.push_back(make_cell_id(side_, layer_ + 1, row_));
     }
     if (row_ > 0) {
       /*  L-1 L L+1
@@ -310,7 +381,7 @@ void gg_locator::get_neighbours_ids(uint32_t side_, uint32_t layer_, uint32_t ro
        *  [ ][.][ ] R
        *  [ ][x][ ] R-1
        */
-      ids_.push_back(geomtools::geom_id(_cell_type_, _module_number_, side_, layer_, row_ - 1));
+      ids_.push_back(make_cell_id(side_, layer_, row_ - 1));
     }
     if (row_ < (_front_cell_y_.size() - 1)) {
       /*  L-1 L L+1
@@ -318,7 +389,7 @@ void gg_locator::get_neighbours_ids(uint32_t side_, uint32_t layer_, uint32_t ro
        *  [ ][.][ ] R
        *  [ ][ ][ ] R-1
        */
-      ids_.push_back(geomtools::geom_id(_cell_type_, _module_number_, side_, layer_, row_ + 1));
+      ids_.push_back(make_cell_id(side_, layer_, row_ + 1));
     }
 
     if ((layer_ < (_front_cell_x_.size() - 1)) && (row_ > 0)) {
@@ -327,7 +398,7 @@ void gg_locator::get_neighbours_ids(uint32_t side_, uint32_t layer_, uint32_t ro
        *  [ ][.][ ] R
        *  [ ][ ][x] R-1
        */
-      ids_.push_back(geomtools::geom_id(_cell_type_, _module_number_, side_, layer_ + 1, row_ - 1));
+      ids_.push_back(make_cell_id(side_, layer_ + 1, row_ - 1));
     }
     if ((layer_ < (_front_cell_x_.size() - 1)) && (row_ < (_front_cell_y_.size() - 1))) {
       /*  L-1 L L+1
@@ -335,7 +406,7 @@ void gg_locator::get_neighbours_ids(uint32_t side_, uint32_t layer_, uint32_t ro
        *  [ ][.][ ] R
        *  [ ][ ][ ] R-1
        */
-      ids_.push_back(geomtools::geom_id(_cell_type_, _module_number_, side_, layer_ + 1, row_ + 1));
+      ids_.push_back(make_cell_id(side_, layer_ + 1, row_ + 1));
     }
     if ((layer_ > 0) && (row_ > 0)) {
       /*  L-1 L L+1
@@ -343,7 +414,7 @@ void gg_locator::get_neighbours_ids(uint32_t side_, uint32_t layer_, uint32_t ro
        *  [ ][.][ ] R
        *  [x][ ][ ] R-1
        */
-      ids_.push_back(geomtools::geom_id(_cell_type_, _module_number_, side_, layer_ - 1, row_ - 1));
+      ids_.push_back(make_cell_id(side_, layer_ - 1, row_ - 1));
     }
     if ((layer_ > 0) && (row_ < (_front_cell_y_.size() - 1))) {
       /*  L-1 L L+1
@@ -351,7 +422,7 @@ void gg_locator::get_neighbours_ids(uint32_t side_, uint32_t layer_, uint32_t ro
        *  [ ][.][ ] R
        *  [ ][ ][ ] R-1
        */
-      ids_.push_back(geomtools::geom_id(_cell_type_, _module_number_, side_, layer_ - 1, row_ + 1));
+      ids_.push_back(make_cell_id(side_, layer_ - 1, row_ + 1));
     }
     if ((layer_ == 0) && (row_ > 0) && other_side_) {
       /*   0     0  1
@@ -359,7 +430,7 @@ void gg_locator::get_neighbours_ids(uint32_t side_, uint32_t layer_, uint32_t ro
        *  [ ] | [.][ ] R
        *  [x] | [ ]| [x] R-1
        */
-      ids_.push_back(geomtools::geom_id(_cell_type_, _module_number_, side_ - 1, 0, row_ - 1));
+      ids_.push_back(make_cell_id(side_ - 1, 0, row_ - 1));
     }
     if ((layer_ == 0) && other_side_) {
       /*   0     0  1
@@ -367,7 +438,7 @@ void gg_locator::get_neighbours_ids(uint32_t side_, uint32_t layer_, uint32_t ro
        *  [x] | [.][ ] R
        *  [ ] | [ ]| [x] R-1
        */
-      ids_.push_back(geomtools::geom_id(_cell_type_, _module_number_, side_ - 1, 0, row_));
+      ids_.push_back(make_cell_id(side_ - 1, 0, row_));
     }
     if ((layer_ == 0) && (row_ < (_front_cell_y_.size() - 1)) && other_side_) {
       /*   0     0  1
@@ -375,7 +446,7 @@ void gg_locator::get_neighbours_ids(uint32_t side_, uint32_t layer_, uint32_t ro
        *  [ ] | [.][ ] R
        *  [ ] | [ ]| [x] R-1
        */
-      ids_.push_back(geomtools::geom_id(_cell_type_, _module_number_, side_ - 1, 0, row_ + 1));
+      ids_.push_back(make_cell_id(side_ - 1, 0, row_ + 1));
     }
   }
   return;
@@ -448,6 +519,8 @@ size_t gg_locator::get_number_of_rows(uint32_t side_) const {
   return nbr_rows;
 }
 
+int gg_locator::get_module_address_index() const { return _module_address_index_; }
+
 uint32_t gg_locator::extract_module(const geomtools::geom_id &gid_) const {
   return gid_.get(_module_address_index_);
 }
@@ -503,6 +576,7 @@ void gg_locator::_set_defaults() {
   _row_index_ = -1;
 
   _module_number_ = geomtools::geom_id::INVALID_ADDRESS;
+  _cell_key_template_.invalidate();
   _mapping_ = 0;
   _id_manager_ = 0;
   _module_ginfo_ = 0;
@@ -511,6 +585,11 @@ void gg_locator::_set_defaults() {
 
   for (size_t i = 0; i < utils::NSIDES; i++) {
     _submodules_[i] = false;
+    datatools::invalidate(_first_cell_x_[i]);
+    datatools::invalidate(_cell_pitch_x_[i]);
+    datatools::invalidate(_first_cell_y_[i]);
+    datatools::invalidate(_cell_pitch_y_[i]);
+    _side_cell_offset_[i] = 0;
   }
 
   datatools::invalidate(_anode_wire_length_);
@@ -577,6 +656,7 @@ void gg_locator::_construct() {
   _side_index_ = cell_cat_info.get_subaddress_index("side");
   _layer_index_ = cell_cat_info.get_subaddress_index("layer");
   _row_index_ = cell_cat_info.get_subaddress_index("row");
+  _cell_key_template_ = channel_key(geomtools::geom_id(_cell_type_, _module_number_, 0, 0, 0));
 
   const geomtools::geom_id module_gid(_module_type_, _module_number_);
   DT_THROW_IF(!_mapping_->validate_id(module_gid), std::logic_error,
@@ -664,6 +744,23 @@ void gg_locator::_construct() {
     }
   }
 
+  // Regular cell grid used by the batch lookups:
+  for (size_t side = 0; side < utils::NSIDES; side++) {
+    if (vlx[side]->empty() || vcy[side]->empty()) continue;
+    _first_cell_x_[side] = vlx[side]->front();
+    _first_cell_y_[side] = vcy[side]->front();
+    _cell_pitch_x_[side] = get_cell_diameter();
+    _cell_pitch_y_[side] = get_cell_diameter();
+    if (vlx[side]->size() > 1) {
+      _cell_pitch_x_[side] = (vlx[side]->back() - vlx[side]->front()) / (vlx[side]->size() - 1);
+    }
+    if (vcy[side]->size() > 1) {
+      _cell_pitch_y_[side] = (vcy[side]->back() - vcy[side]->front()) / (vcy[side]->size() - 1);
+    }
+  }
+
+  _build_neighbour_table();
+
   // analyse the geometry versioning :
   datatools::version_id geom_mgr_setup_vid;
   get_geo_manager().fetch_setup_version_id(geom_mgr_setup_vid);
@@ -883,6 +980,10 @@ void gg_locator::reset() {
   _front_cell_x_.clear();
   _back_cell_y_.clear();
   _front_cell_y_.clear();
+  for (size_t table = 0; table < 2; table++) {
+    _neighbour_cell_ids_[table].clear();
+    _number_of_neighbour_cells_[table].clear();
+  }
 
   _initialized_ = false;
   return;
@@ -954,7 +1055,7 @@ bool gg_locator::find_geom_id(const geomtools::vector_3d &world_position_, int t
     // Not in this module :
     return false;
   }
-  return const_cast<gg_locator *>(this)->gg_locator::_find_cell_geom_id(in_module_position, gid_);
+  return _find_cell_geom_id(in_module_position, gid_);
 }
 
 bool gg_locator::find_cell_geom_id(const geomtools::vector_3d &world_position_,
@@ -962,8 +1063,109 @@ bool gg_locator::find_cell_geom_id(const geomtools::vector_3d &world_position_,
   return find_geom_id(world_position_, _cell_type_, gid_, tolerance_);
 }
 
+size_t gg_locator::find_cell_ids(const std::vector<geomtools::vector_3d> &world_positions_,
+                                 std::vector<cell_id_type> &cell_ids_, double tolerance_) const {
+  DT_THROW_IF(!is_initialized(), std::logic_error, "Locator is not initialized !");
+  cell_ids_.assign(world_positions_.size(), INVALID_CELL_ID);
+  size_t nfound = 0;
+  geomtools::vector_3d in_module_position;
+  for (size_t i = 0; i < world_positions_.size(); i++) {
+    _module_world_placement_->mother_to_child(world_positions_[i], in_module_position);
+    if (!_module_box_->is_inside(in_module_position, tolerance_)) continue;
+    cell_ids_[i] = _locate_cell(in_module_position, tolerance_);
+    if (cell_ids_[i] != INVALID_CELL_ID) nfound++;
+  }
+  return nfound;
+}
+
+size_t gg_locator::find_cell_ids_in_module(
+    const std::vector<geomtools::vector_3d> &module_positions_,
+    std::vector<cell_id_type> &cell_ids_, double tolerance_) const {
+  DT_THROW_IF(!is_initialized(), std::logic_error, "Locator is not initialized !");
+  cell_ids_.assign(module_positions_.size(), INVALID_CELL_ID);
+  size_t nfound = 0;
+  for (size_t i = 0; i < module_positions_.size(); i++) {
+    cell_ids_[i] = _locate_cell(module_positions_[i], tolerance_);
+    if (cell_ids_[i] != INVALID_CELL_ID) nfound++;
+  }
+  return nfound;
+}
+
+void gg_locator::make_cell_geom_id(cell_id_type cell_id_, geomtools::geom_id &gid_) const {
+  DT_THROW_IF(!is_initialized(), std::logic_error, "Locator is not initialized !");
+  gid_.invalidate();
+  if (cell_id_ == INVALID_CELL_ID) return;
+  gid_.set_type(_cell_type_);
+  gid_.set(_module_index_, _module_number_);
+  gid_.set(_side_index_, cell_id_side(cell_id_));
+  gid_.set(_layer_index_, cell_id_layer(cell_id_));
+  gid_.set(_row_index_, cell_id_row(cell_id_));
+  return;
+}
+
+channel_key gg_locator::make_cell_channel_key(cell_id_type cell_id_) const {
+  DT_THROW_IF(!is_initialized(), std::logic_error, "Locator is not initialized !");
+  channel_key key;
+  if (cell_id_ == INVALID_CELL_ID) return key;
+  key = _cell_key_template_;
+  key.set(_side_index_, cell_id_side(cell_id_));
+  key.set(_layer_index_, cell_id_layer(cell_id_));
+  key.set(_row_index_, cell_id_row(cell_id_));
+  return key;
+}
+
+gg_locator::cell_id_type gg_locator::_locate_cell(const geomtools::vector_3d &in_module_position_,
+                                                  double tolerance_) const {
+  double tolerance = tolerance_;
+  if (tolerance == GEOMTOOLS_PROPER_TOLERANCE) {
+    tolerance = _cell_box_->get_tolerance();
+  }
+  const double half_tolerance = 0.5 * tolerance;
+  const double x = in_module_position_.x();
+  const double y = in_module_position_.y();
+  const double z = in_module_position_.z();
+  if (std::abs(z) >= _cell_box_->get_half_z() + half_tolerance) {
+    return INVALID_CELL_ID;
+  }
+
+  // Find the side, as _find_cell_geom_id does:
+  const double half_cell = 0.5 * get_cell_diameter() + tolerance;
+  uint32_t side = geomtools::geom_id::INVALID_ADDRESS;
+  const std::vector<double> *cell_x = 0;
+  const std::vector<double> *cell_y = 0;
+  if (_submodules_[utils::SIDE_BACK] && !_back_cell_x_.empty() && !_back_cell_y_.empty() &&
+      x <= _back_cell_x_.front() + half_cell) {
+    side = utils::SIDE_BACK;
+    cell_x = &_back_cell_x_;
+    cell_y = &_back_cell_y_;
+  } else if (_submodules_[utils::SIDE_FRONT] && !_front_cell_x_.empty() &&
+             !_front_cell_y_.empty() && x >= _front_cell_x_.front() - half_cell) {
+    side = utils::SIDE_FRONT;
+    cell_x = &_front_cell_x_;
+    cell_y = &_front_cell_y_;
+  } else {
+    return INVALID_CELL_ID;
+  }
+
+  // Nearest cell on the regular grid:
+  const double fx = (x - _first_cell_x_[side]) / _cell_pitch_x_[side];
+  const double fy = (y - _first_cell_y_[side]) / _cell_pitch_y_[side];
+  const int ix = (int)std::floor(fx + 0.5);
+  const int iy = (int)std::floor(fy + 0.5);
+  if (ix < 0 || ix >= (int)cell_x->size() || iy < 0 || iy >= (int)cell_y->size()) {
+    return INVALID_CELL_ID;
+  }
+
+  // Check the position is inside the cell box:
+  const geomtools::vector_3d to_cell_pos(x - (*cell_x)[ix], y - (*cell_y)[iy], z);
+  if (!_cell_box_->is_inside(to_cell_pos, tolerance)) {
+    return INVALID_CELL_ID;
+  }
+  return make_cell_id(side, ix, iy);
+}
+
 bool gg_locator::_find_cell_geom_id(const geomtools::vector_3d &in_module_position_,
-                                    geomtools::geom_id &gid_, double tolerance_) {
+                                    geomtools::geom_id &gid_, double tolerance_) const {
   DT_LOG_TRACE_ENTERING(get_logging_priority());
   double tolerance = tolerance_;
   if (tolerance == GEOMTOOLS_PROPER_TOLERANCE) {
@@ -33,6 +33,7 @@
 
 // Standard library:
 #include <string>
+#include <vector>
 
 // Third party
 // - Boost :
@@ -43,6 +44,7 @@
 #include <geomtools/i_locator.h>
 
 // This project:
+#include <falaise/snemo/geometry/channel_key.h>
 #include <falaise/snemo/geometry/utils.h>
 
 /** forward declaration */
@@ -61,6 +63,45 @@ namespace geometry {
 /// \brief Fast locator class for SuperNEMO drift chamber volumes
 class gg_locator : public geomtools::base_locator, public datatools::i_tree_dumpable {
  public:
+  /// Packed identifier of a drift cell (side, layer and row) in the module of the locator
+  typedef uint32_t cell_id_type;
+
+  /// Invalid packed cell identifier
+  static const cell_id_type INVALID_CELL_ID = 0xFFFFFFFF;
+
+  /// Maximum number of neighbours of a cell (including the other side)
+  static const size_t MAX_NEIGHBOURS = 11;
+
+  /// Read-only view of a contiguous array of packed cell identifiers
+  class cell_id_range {
+   public:
+    cell_id_range(const cell_id_type* begin_, const cell_id_type* end_)
+        : _begin_(begin_), _end_(end_) {}
+    const cell_id_type* begin() const { return _begin_; }
+    const cell_id_type* end() const { return _end_; }
+    size_t size() const { return _end_ - _begin_; }
+    bool empty() const { return _begin_ == _end_; }
+    cell_id_type operator[](size_t i_) const { return _begin_[i_]; }
+
+   private:
+    const cell_id_type* _begin_;
+    const cell_id_type* _end_;
+  };
+
+  /// Return the packed identifier of the cell at given side, layer and row
+  static cell_id_type make_cell_id(uint32_t side_, uint32_t layer_, uint32_t row_) {
+    return (side_ << 24) | (layer_ << 16) | row_;
+  }
+
+  /// Return the side of a packed cell identifier
+  static uint32_t cell_id_side(cell_id_type cell_id_) { return cell_id_ >> 24; }
+
+  /// Return the layer of a packed cell identifier
+  static uint32_t cell_id_layer(cell_id_type cell_id_) { return (cell_id_ >> 16) & 0xFF; }
+
+  /// Return the row of a packed cell identifier
+  static uint32_t cell_id_row(cell_id_type cell_id_) { return cell_id_ & 0xFFFF; }
+
   /// Check intialization flag
   virtual bool is_initialized() const;
 
@@ -90,11 +131,37 @@ class gg_locator : public geomtools::base_locator, public datatools::i_tree_dump
   bool find_cell_geom_id(const geomtools::vector_3d& world_position_, geomtools::geom_id& gid_,
                          double tolerance_ = GEOMTOOLS_PROPER_TOLERANCE) const;
 
+  /** Find the cells containing a batch of world coordinate system positions.
+   *  The packed identifier of the cell containing each position, or INVALID_CELL_ID,
+   *  is stored at the same index in cell_ids_. Cells are found from the regular cell
+   *  pitch of each side and the cell box, without searching the geometry mapping
+   *  (wires within the cells are thus not excluded).
+   *  @return the number of positions located in a cell
+   */
+  size_t find_cell_ids(const std::vector<geomtools::vector_3d>& world_positions_,
+                       std::vector<cell_id_type>& cell_ids_,
+                       double tolerance_ = GEOMTOOLS_PROPER_TOLERANCE) const;
+
+  /** Find the cells containing a batch of module coordinate system positions.
+   *  @see find_cell_ids
+   */
+  size_t find_cell_ids_in_module(const std::vector<geomtools::vector_3d>& module_positions_,
+                                 std::vector<cell_id_type>& cell_ids_,
+                                 double tolerance_ = GEOMTOOLS_PROPER_TOLERANCE) const;
+
+  /** Build the geometry ID of a cell from its packed identifier.
+   */
+  void make_cell_geom_id(cell_id_type cell_id_, geomtools::geom_id& gid_) const;
+
+  /** Build the channel key of a cell from its packed identifier.
+   */
+  channel_key make_cell_channel_key(cell_id_type cell_id_) const;
+
  protected:
   /**
    */
   bool _find_cell_geom_id(const geomtools::vector_3d& in_module_position_, geomtools::geom_id& gid_,
-                          double tolerance_ = GEOMTOOLS_PROPER_TOLERANCE);
+                          double tolerance_ = GEOMTOOLS_PROPER_TOLERANCE) const;
 
  public:
   /**! @return the number of the module (>=0).
@@ -224,6 +291,18 @@ class gg_locator : public geomtools::base_locator, public datatools::i_tree_dump
   void get_neighbours_ids(const geomtools::geom_id& gid_, std::vector<geomtools::geom_id>& ids_,
                           bool other_side_ = false) const;
 
+  /** Given a cell at specific side, layer and row, return the packed identifiers of the
+   * neighbouring cells, in the same order as get_neighbours_ids. The view is served from a
+   * table built at initialization and remains valid until the locator is reset.
+   */
+  cell_id_range get_neighbour_cell_ids(uint32_t side_, uint32_t layer_, uint32_t row_,
+                                       bool other_side_ = false) const;
+
+  /** Given a cell with a packed identifier, return the packed identifiers of the
+   * neighbouring cells.
+   */
+  cell_id_range get_neighbour_cell_ids(cell_id_type cell_id_, bool other_side_ = false) const;
+
   /** Given a cell with a specific geometry IDs, compute its position in the module coordinate
    * system.
    */
@@ -235,6 +314,8 @@ class gg_locator : public geomtools::base_locator, public datatools::i_tree_dump
   void get_cell_position(uint32_t side_, uint32_t layer_, uint32_t row_,
                          geomtools::vector_3d& position_) const;
 
+  int get_module_address_index() const;
+
   uint32_t extract_module(const geomtools::geom_id& gid_) const;
 
   uint32_t extract_side(const geomtools::geom_id& gid) const;
@@ -271,6 +352,20 @@ class gg_locator : public geomtools::base_locator, public datatools::i_tree_dump
   /// Hack trace
   void _hack_trace();
 
+  /// Return the packed identifier of the cell containing a module position, if any
+  cell_id_type _locate_cell(const geomtools::vector_3d& in_module_position_,
+                            double tolerance_) const;
+
+  /// Return the dense index of a cell, after checking its address
+  size_t _cell_index(uint32_t side_, uint32_t layer_, uint32_t row_) const;
+
+  /// Compute the packed identifiers of the neighbouring cells of a cell
+  void _compute_neighbour_cell_ids(uint32_t side_, uint32_t layer_, uint32_t row_,
+                                   std::vector<cell_id_type>& ids_, bool other_side_) const;
+
+  /// Build the neighbour tables of all cells
+  void _build_neighbour_table();
+
  private:
   bool _initialized_;
 
@@ -289,6 +384,7 @@ class gg_locator : public geomtools::base_locator, public datatools::i_tree_dump
   uint32_t _tracker_layer_type_;
   uint32_t _cell_type_;
   uint32_t _module_number_;
+  channel_key _cell_key_template_;  //!< Channel key of the cells of the module
   const geomtools::mapping* _mapping_;
   const geomtools::id_mgr* _id_manager_;
 
@@ -306,6 +402,17 @@ class gg_locator : public geomtools::base_locator, public datatools::i_tree_dump
   double _field_wire_length_;
   double _field_wire_diameter_;
 
+  // Regular cell grid of each side (module coordinate system):
+  double _first_cell_x_[2];  //!< X-position of the cells in layer 0
+  double _cell_pitch_x_[2];  //!< Distance between two consecutive layers
+  double _first_cell_y_[2];  //!< Y-position of the cells in row 0
+  double _cell_pitch_y_[2];  //!< Distance between two consecutive rows
+
+  // Neighbour tables, without (0) and with (1) the cells on the other side:
+  size_t _side_cell_offset_[2];  //!< Dense index of the first cell of each side
+  std::vector<cell_id_type> _neighbour_cell_ids_[2];  //!< MAX_NEIGHBOURS slots per cell
+  std::vector<uint8_t> _number_of_neighbour_cells_[2];  //!< Number of neighbours per cell
+
   int _module_address_index_;
   int _side_address_index_;
   int _layer_address_index_;
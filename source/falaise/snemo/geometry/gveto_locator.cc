@@ -189,27 +189,120 @@ void gveto_locator::get_block_position(const geomtools::geom_id &gid_,
 void gveto_locator::get_block_position(uint32_t side_, uint32_t wall_, uint32_t column_,
                                        geomtools::vector_3d &position_) const {
   DT_THROW_IF(!is_initialized(), std::logic_error, "Locator is not initialized !");
+  position_ = _block_positions_[_block_index(side_, wall_, column_)];
+  return;
+}
+
+const geomtools::placement &gveto_locator::get_block_world_placement(
+    const geomtools::geom_id &gid_) const {
+  DT_THROW_IF(!is_initialized(), std::logic_error, "Locator is not initialized !");
+  DT_THROW_IF(gid_.get(_module_address_index_) != _module_number_, std::logic_error,
+              "Invalid module number(" << gid_.get(_module_address_index_)
+                                       << "!=" << _module_number_ << ")!");
+  return get_block_world_placement(gid_.get(_side_address_index_), gid_.get(_wall_address_index_),
+                                   gid_.get(_column_address_index_));
+}
+
+const geomtools::placement &gveto_locator::get_block_world_placement(uint32_t side_,
+                                                                     uint32_t wall_,
+                                                                     uint32_t column_) const {
+  DT_THROW_IF(!is_initialized(), std::logic_error, "Locator is not initialized !");
+  return _block_world_placements_[_block_index(side_, wall_, column_)];
+}
+
+size_t gveto_locator::get_number_of_blocks() const {
+  DT_THROW_IF(!is_initialized(), std::logic_error, "Locator is not initialized !");
+  return _block_positions_.size();
+}
+
+size_t gveto_locator::get_block_index(uint32_t side_, uint32_t wall_, uint32_t column_) const {
+  DT_THROW_IF(!is_initialized(), std::logic_error, "Locator is not initialized !");
+  return _block_index(side_, wall_, column_);
+}
+
+size_t gveto_locator::_block_index(uint32_t side_, uint32_t wall_, uint32_t column_) const {
   DT_THROW_IF(side_ >= utils::NSIDES, std::logic_error,
               "Invalid side number(" << side_ << ">" << utils::NSIDES << ")!");
   DT_THROW_IF(wall_ >= NWALLS_PER_SIDE, std::logic_error,
               "Invalid wall number(" << wall_ << ">" << NWALLS_PER_SIDE << ")!");
-  geomtools::invalidate(position_);
-  if (side_ == (uint32_t)utils::SIDE_BACK) {
-    DT_THROW_IF(
-        column_ >= _back_block_y_[wall_].size(), std::logic_error,
-        "Invalid column number(" << column_ << ">" << _back_block_y_[wall_].size() - 1 << ")!");
-    position_.set(_back_block_x_[wall_][0], _back_block_y_[wall_][column_],
-                  _block_z_[side_][wall_]);
-  } else {
-    DT_THROW_IF(
-        column_ >= _front_block_y_[wall_].size(), std::logic_error,
-        "Invalid column number(" << column_ << ">" << _front_block_y_[wall_].size() - 1 << ")!");
-    position_.set(_front_block_x_[wall_][0], _front_block_y_[wall_][column_],
-                  _block_z_[side_][wall_]);
+  const std::vector<double> &block_y =
+      (side_ == (uint32_t)utils::SIDE_BACK) ? _back_block_y_[wall_] : _front_block_y_[wall_];
+  DT_THROW_IF(column_ >= block_y.size(), std::logic_error,
+              "Invalid column number(" << column_ << ">" << block_y.size() - 1 << ")!");
+  return _wall_block_offset_[side_][wall_] + column_;
+}
+
+void gveto_locator::_build_block_tables() {
+  // Dense indexing of the blocks, side by side, then wall by wall:
+  size_t nblocks = 0;
+  for (uint32_t side = 0; side < utils::NSIDES; side++) {
+    const bool back = (side == (uint32_t)utils::SIDE_BACK);
+    for (uint32_t wall = 0; wall < NWALLS_PER_SIDE; wall++) {
+      _wall_block_offset_[side][wall] = nblocks;
+      nblocks += back ? _back_block_y_[wall].size() : _front_block_y_[wall].size();
+    }
+  }
+  _block_positions_.assign(nblocks, geomtools::vector_3d());
+  _block_world_placements_.assign(nblocks, geomtools::placement());
+  for (size_t kind = 0; kind < NEIGHBOUR_KINDS; kind++) {
+    _neighbour_ids_[kind].clear();
+    _neighbour_offsets_[kind].assign(nblocks + 1, 0);
+  }
+
+  std::vector<geomtools::geom_id> ids;
+  for (uint32_t side = 0; side < utils::NSIDES; side++) {
+    const bool back = (side == (uint32_t)utils::SIDE_BACK);
+    for (uint32_t wall = 0; wall < NWALLS_PER_SIDE; wall++) {
+      const std::vector<double> &block_x = back ? _back_block_x_[wall] : _front_block_x_[wall];
+      const std::vector<double> &block_y = back ? _back_block_y_[wall] : _front_block_y_[wall];
+      for (uint32_t column = 0; column < block_y.size(); column++) {
+        const size_t block_index = _block_index(side, wall, column);
+        geomtools::vector_3d &position = _block_positions_[block_index];
+        position.set(block_x[0], block_y[column], _block_z_[side][wall]);
+
+        // World placement from the mapping, or from the module placement if the block
+        // is not mapped:
+        geomtools::geom_id block_gid;
+        block_gid.set_type(_block_type_);
+        block_gid.set(_module_address_index_, _module_number_);
+        block_gid.set(_side_address_index_, side);
+        block_gid.set(_wall_address_index_, wall);
+        block_gid.set(_column_address_index_, column);
+        if (is_block_partitioned()) {
+          block_gid.set(_part_address_index_, _block_part_);
+        }
+        geomtools::placement &world_placement = _block_world_placements_[block_index];
+        if (_mapping_->validate_id(block_gid)) {
+          world_placement = _mapping_->get_geom_info(block_gid).get_world_placement();
+        } else {
+          geomtools::vector_3d world_position;
+          _module_world_placement_->child_to_mother(position, world_position);
+          world_placement = *_module_world_placement_;
+          world_placement.set_translation(world_position);
+        }
+
+        for (size_t kind = 0; kind < NEIGHBOUR_KINDS; kind++) {
+          _compute_neighbours_ids(side, wall, column, ids, _neighbour_kind_mask(kind));
+          _neighbour_ids_[kind].insert(_neighbour_ids_[kind].end(), ids.begin(), ids.end());
+          _neighbour_offsets_[kind][block_index + 1] = ids.size();
+        }
+      }
+    }
+  }
+  // Turn the numbers of neighbours into offsets:
+  for (size_t kind = 0; kind < NEIGHBOUR_KINDS; kind++) {
+    for (size_t i = 0; i < nblocks; i++) {
+      _neighbour_offsets_[kind][i + 1] += _neighbour_offsets_[kind][i];
+    }
   }
   return;
 }
 
+uint8_t gveto_locator::_neighbour_kind_mask(size_t kind_) {
+  static const uint8_t masks[NEIGHBOUR_KINDS] = {utils::NEIGHBOUR_SIDE, utils::NEIGHBOUR_DIAG};
+  return masks[kind_];
+}
+
 void gveto_locator::get_neighbours_ids(const geomtools::geom_id &gid_,
                                        std::vector<geomtools::geom_id> &ids_, uint8_t mask_) const {
   DT_THROW_IF(!is_initialized(), std::logic_error, "Locator is not initialized !");
@@ -226,6 +319,24 @@ void gveto_locator::get_neighbours_ids(const geomtools::geom_id &gid_,
 void gveto_locator::get_neighbours_ids(uint32_t side_, uint32_t wall_, uint32_t column_,
                                        std::vector<geomtools::geom_id> &ids_, uint8_t mask_) const {
   DT_THROW_IF(!is_initialized(), std::logic_error, "Locator is not initialized !");
+  const size_t block_index = _block_index(side_, wall_, column_);
+  if (mask_ & utils::NEIGHBOUR_SECOND) {
+    DT_LOG_NOTICE(get_logging_priority(),
+                  "Looking for second order neighbour of 'gveto' locator is not implemented !");
+  }
+  ids_.clear();
+  for (size_t kind = 0; kind < NEIGHBOUR_KINDS; kind++) {
+    if (!(mask_ & _neighbour_kind_mask(kind))) continue;
+    const std::vector<geomtools::geom_id>::const_iterator first = _neighbour_ids_[kind].begin();
+    ids_.insert(ids_.end(), first + _neighbour_offsets_[kind][block_index],
+                first + _neighbour_offsets_[kind][block_index + 1]);
+  }
+  return;
+}
+
+void gveto_locator::_compute_neighbours_ids(uint32_t side_, uint32_t wall_, uint32_t column_,
+                                            std::vector<geomtools::geom_id> &ids_,
+                                            uint8_t mask_) const {
   DT_THROW_IF(side_ >= utils::NSIDES, std::logic_error,
               "Invalid side number(" << side_ << ">= " << utils::NSIDES << ")!");
   DT_THROW_IF(wall_ >= NWALLS_PER_SIDE, std::logic_error,
@@ -236,11 +347,6 @@ void gveto_locator::get_neighbours_ids(uint32_t side_, uint32_t wall_, uint32_t
 
   const bool sides = mask_ & utils::NEIGHBOUR_SIDE;
   const bool diagonal = mask_ & utils::NEIGHBOUR_DIAG;
-  const bool second = mask_ & utils::NEIGHBOUR_SECOND;
-  if (second) {
-    DT_LOG_NOTICE(get_logging_priority(),
-                  "Looking for second order neighbour of 'gveto' locator is not implemented !");
-  }
 
   // prepare neighbour GID :
   geomtools::geom_id gid;
@@ -464,6 +570,7 @@ void gveto_locator::_set_defaults_() {
     for (unsigned int j = 0; j < NWALLS_PER_SIDE; j++) {
       datatools::invalidate(_block_z_[i][j]);
       datatools::invalidate(_block_window_z_[i][j]);
+      _wall_block_offset_[i][j] = 0;
     }
     _submodules_[i] = false;
   }
@@ -709,6 +816,7 @@ void gveto_locator::_construct() {
   _block_height_ = _block_box_->get_y();
   _block_thickness_ = _block_box_->get_z();
 
+  _build_block_tables();
   return;
 }
 
@@ -902,6 +1010,12 @@ void gveto_locator::reset() {
     _back_block_y_[i].clear();
     _front_block_y_[i].clear();
   }
+  _block_positions_.clear();
+  _block_world_placements_.clear();
+  for (size_t kind = 0; kind < NEIGHBOUR_KINDS; kind++) {
+    _neighbour_ids_[kind].clear();
+    _neighbour_offsets_[kind].clear();
+  }
   _set_defaults_();
   return;
 }
@@ -969,8 +1083,7 @@ bool gveto_locator::find_geom_id(const geomtools::vector_3d &world_position_, in
     // Not in this module :
     return false;
   }
-  return const_cast<gveto_locator *>(this)->gveto_locator::find_block_geom_id_(in_module_position,
-                                                                               gid_, tolerance_);
+  return find_block_geom_id_(in_module_position, gid_, tolerance_);
 }
 
 bool gveto_locator::id_is_valid(uint32_t side_, uint32_t wall_, uint32_t column_) const {
@@ -1005,7 +1118,7 @@ bool gveto_locator::find_block_geom_id(const geomtools::vector_3d &world_positio
 }
 
 bool gveto_locator::find_block_geom_id_(const geomtools::vector_3d &in_module_position_,
-                                        geomtools::geom_id &gid_, double tolerance_) {
+                                        geomtools::geom_id &gid_, double tolerance_) const {
   DT_LOG_TRACE_ENTERING(get_logging_priority());
 
   double tolerance = tolerance_;
@@ -5,6 +5,7 @@
 
 // Third party:
 // - Bayeux/datatools :
+#include <datatools/clhep_units.h>
 #include <datatools/version_id.h>
 
 // This project:
@@ -47,6 +48,13 @@ const snemo::geometry::gveto_locator& locator_plugin::get_gveto_locator() const
   return *_gveto_locator_;
 }
 
+bool locator_plugin::has_detector_index() const { return _detector_index_.is_initialized(); }
+
+const snemo::geometry::detector_index& locator_plugin::get_detector_index() const {
+  DT_THROW_IF(!has_detector_index(), std::logic_error, "No detector index is available !");
+  return _detector_index_;
+}
+
 const locator_plugin::locator_dict_type& locator_plugin::get_locators() const {
   DT_THROW_IF(!is_initialized(), std::logic_error, "Locator plugin is not initialized !");
   return _locators_;
@@ -85,11 +93,17 @@ int locator_plugin::initialize(const datatools::properties& config_,
   DT_LOG_NOTICE(get_logging_priority(), "Building the embedded locators...");
   _build_locators(config_);
 
+  DT_LOG_NOTICE(get_logging_priority(), "Building the detector index...");
+  _build_detector_index(config_);
+
   _initialized_ = true;
   return 0;
 }
 
 int locator_plugin::reset() {
+  if (_detector_index_.is_initialized()) {
+    _detector_index_.reset();
+  }
   _gg_locator_ = 0;
   _calo_locator_ = 0;
   _xcalo_locator_ = 0;
@@ -203,6 +217,34 @@ void locator_plugin::_build_locators(const datatools::properties& config_) {
   return;
 }
 
+void locator_plugin::_build_detector_index(const datatools::properties& config_) {
+  DT_LOG_TRACE(get_logging_priority(), "Entering...");
+
+  bool do_index = true;
+  if (config_.has_key("detector_index.active")) {
+    do_index = config_.fetch_boolean("detector_index.active");
+  }
+  if (!do_index) {
+    DT_LOG_TRACE(get_logging_priority(), "Exiting.");
+    return;
+  }
+
+  if (config_.has_key("detector_index.voxel_size")) {
+    double voxel_size = config_.fetch_real("detector_index.voxel_size");
+    if (!config_.has_explicit_unit("detector_index.voxel_size")) {
+      voxel_size *= CLHEP::mm;
+    }
+    _detector_index_.set_voxel_size(voxel_size);
+  }
+  _detector_index_.initialize(_gg_locator_, _calo_locator_, _xcalo_locator_, _gveto_locator_);
+  if (get_logging_priority() >= datatools::logger::PRIO_DEBUG) {
+    _detector_index_.tree_dump(std::clog, "Detector index:", "[debug] ");
+  }
+
+  DT_LOG_TRACE(get_logging_priority(), "Exiting.");
+  return;
+}
+
 }  // end of namespace geometry
 
 }  // namespace snemo
@@ -7,7 +7,8 @@
  *
  * Description:
  *
- *   A geometry manager plugin with embeded locators.
+ *   A geometry manager plugin with embeded locators and a spatial index of
+ *   the detector elements.
  *
  * History:
  *
@@ -23,6 +24,9 @@
 #include <geomtools/manager.h>
 #include <geomtools/manager_macros.h>
 
+// This project:
+#include <falaise/snemo/geometry/detector_index.h>
+
 namespace geomtools {
 class i_base_locator;
 }
@@ -37,6 +41,9 @@ class xcalo_locator;
 class gveto_locator;
 
 /// \brief A geometry manager plugin with embedded SuperNEMO locators.
+///
+/// Once the plugin is initialized, its locators and detector index are immutable: their const
+/// interfaces do not modify any internal state, so the plugin can be shared by concurrent threads.
 class locator_plugin : public geomtools::manager::base_plugin {
  public:
   typedef datatools::handle<geomtools::base_locator> locator_handle_type;
@@ -98,10 +105,19 @@ class locator_plugin : public geomtools::manager::base_plugin {
   /// Returns a non-mutable reference to the gamma veto locator
   const snemo::geometry::gveto_locator& get_gveto_locator() const;
 
+  /// Check if the spatial index of the detector elements is available
+  bool has_detector_index() const;
+
+  /// Returns a non-mutable reference to the spatial index of the detector elements
+  const snemo::geometry::detector_index& get_detector_index() const;
+
  protected:
   /// Internal mapping build method
   void _build_locators(const datatools::properties& config_);
 
+  /// Internal spatial index build method
+  void _build_detector_index(const datatools::properties& config_);
+
  private:
   bool _initialized_;                                     //!< Initialization flag
   locator_dict_type _locators_;                           //!< Locator dictionary
@@ -109,6 +125,7 @@ class locator_plugin : public geomtools::manager::base_plugin {
   const snemo::geometry::calo_locator* _calo_locator_;    //!< Main wall locator
   const snemo::geometry::xcalo_locator* _xcalo_locator_;  //!< X-wall locator
   const snemo::geometry::gveto_locator* _gveto_locator_;  //!< gamma-veto locator
+  snemo::geometry::detector_index _detector_index_;       //!< Spatial index of the elements
 
   GEOMTOOLS_PLUGIN_REGISTRATION_INTERFACE(locator_plugin)
 };
@@ -24,7 +24,19 @@
 #include <falaise/snemo/geometry/mapped_magnetic_field.h>
 
 // Standard library:
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
 #include <vector>
+// - POSIX:
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 // Third party:
 // - Boost:
@@ -81,12 +93,87 @@ namespace geometry {
 // Registration instantiation macro :
 EMFIELD_REGISTRATION_IMPLEMENT(mapped_magnetic_field, "snemo::geometry::mapped_magnetic_field")
 
+namespace {
+
+/// \brief Header of the binary cache of a CSV map, followed by the packed B-field values
+struct csv_map_0_cache_header {
+  char magic[8];           ///< File signature
+  uint32_t version;        ///< Format version
+  uint32_t reserved;       ///< Unused
+  uint64_t checksum;       ///< Checksum of the source CSV file
+  uint64_t data_checksum;  ///< Checksum of the packed B-field values
+  uint32_t nx;             ///< Number of nodes along X
+  uint32_t ny;             ///< Number of nodes along Y
+  uint32_t nz;             ///< Number of nodes along Z
+  uint32_t reserved2;      ///< Unused
+  double origin[3];        ///< Origin of the grid (CLHEP units)
+  double step[3];          ///< Steps of the grid (CLHEP units)
+};
+
+const char CSV_MAP_0_CACHE_MAGIC[8] = {'S', 'N', 'B', 'M', 'A', 'P', '0', '\0'};
+
+/// Version of the cache format, to be incremented at any change of the layout
+const uint32_t CSV_MAP_0_CACHE_VERSION = 2;
+
+/// Offset basis of the 64 bits FNV-1a hash
+const uint64_t FNV1A_64_BASIS = 14695981039346656037ULL;
+
+/// Update a 64 bits FNV-1a hash with a range of bytes
+uint64_t fnv1a_64(uint64_t hash_, const void* data_, size_t size_) {
+  const unsigned char* bytes = static_cast<const unsigned char*>(data_);
+  for (size_t i = 0; i < size_; i++) {
+    hash_ ^= bytes[i];
+    hash_ *= 1099511628211ULL;
+  }
+  return hash_;
+}
+
+/// Return the 64 bits FNV-1a checksum of the content of a file
+uint64_t file_checksum(const std::string& filename_) {
+  std::ifstream fin(filename_.c_str(), std::ios::binary);
+  DT_THROW_IF(!fin, std::runtime_error, "Cannot open file '" << filename_ << "'!");
+  uint64_t hash = FNV1A_64_BASIS;
+  std::vector<char> buffer(1 << 16);
+  while (fin) {
+    fin.read(&buffer[0], buffer.size());
+    hash = fnv1a_64(hash, &buffer[0], fin.gcount());
+  }
+  return hash;
+}
+
+/// Return the default directory of the binary map caches, private to the user, or an empty
+/// string if it cannot be made
+std::string default_cache_directory() {
+  boost::filesystem::path cache_dir;
+  const char* xdg_cache_home = std::getenv("XDG_CACHE_HOME");
+  const char* home = std::getenv("HOME");
+  if (xdg_cache_home != 0 && xdg_cache_home[0] == '/') {
+    cache_dir = xdg_cache_home;
+  } else if (home != 0 && home[0] != '\0') {
+    cache_dir = boost::filesystem::path(home) / ".cache";
+  } else {
+    return std::string();
+  }
+  boost::system::error_code error;
+  boost::filesystem::create_directories(cache_dir, error);
+  cache_dir /= "falaise";
+  if (::mkdir(cache_dir.string().c_str(), S_IRWXU) != 0 && errno != EEXIST) {
+    return std::string();
+  }
+  return cache_dir.string();
+}
+
+}  // namespace
+
 /// \brief Private working data for MM_IMPORT_CSV_MAP_0 mode
 struct csv_map_0_type {
  public:
   csv_map_0_type();
   void init();
   void load();
+  void parse_csv(const std::string& filename_);
+  bool map_cache(const std::string& cache_filename_, uint64_t checksum_);
+  void save_cache(const std::string& cache_filename_, uint64_t checksum_) const;
   void dump(std::ostream& = std::clog) const;
   void reset();
   int interpolate(const ::geomtools::vector_3d& position_,
@@ -97,6 +184,8 @@ struct csv_map_0_type {
  public:
   // Configuration:
   std::string map_filename;
+  bool use_cache;
+  std::string cache_directory;
   datatools::logger::priority logging;
   double length_unit;
   double mag_field_unit;
@@ -108,15 +197,19 @@ struct csv_map_0_type {
   double dx;
   double dy;
   double dz;
-  // Mapped B-field:
-  typedef std::vector<int> vd;
-  typedef std::vector<vd> vvd;
-  typedef std::vector<vvd> vvvd;
-  typedef std::vector<vvvd> vvvvd;
-  vvvvd bmap;
+  // Mapped B-field, as (Bx, By, Bz) triplets at index (iz * ny + iy) * nx + ix:
+  std::vector<int32_t> bmap;  //!< Values parsed from the CSV file
+  void* cache_address;        //!< Memory mapped binary cache, if any
+  size_t cache_size;          //!< Size of the memory mapped binary cache
+  const int32_t* bdata;       //!< Values in use, from bmap or from the memory mapped cache
 };
 
 csv_map_0_type::csv_map_0_type() {
+  use_cache = false;
+  logging = datatools::logger::PRIO_FATAL;
+  cache_address = 0;
+  cache_size = 0;
+  bdata = 0;
   length_unit = CLHEP::meter;
   mag_field_unit = datatools::units::milli() * CLHEP::gauss;
   nx = 0;
@@ -130,7 +223,13 @@ csv_map_0_type::csv_map_0_type() {
 }
 
 void csv_map_0_type::reset() {
+  bdata = 0;
   bmap.clear();
+  if (cache_address != 0) {
+    ::munmap(cache_address, cache_size);
+    cache_address = 0;
+    cache_size = 0;
+  }
   nx = 0;
   ny = 0;
   nz = 0;
@@ -177,6 +276,8 @@ void mapped_magnetic_field::_set_defaults() {
   _mapping_mode_ = MM_INVALID;
   _zero_field_outside_map_ = true;
   _z_inverted_ = false;
+  _map_cache_ = false;
+  _map_cache_directory_.clear();
   return;
 }
 
@@ -219,6 +320,24 @@ void mapped_magnetic_field::set_z_inverted(bool f_) {
 
 bool mapped_magnetic_field::is_z_inverted() const { return _z_inverted_; }
 
+void mapped_magnetic_field::set_map_cache(bool f_) {
+  DT_THROW_IF(is_initialized(), std::logic_error, "Cannot change the map cache flag !");
+  _map_cache_ = f_;
+  return;
+}
+
+bool mapped_magnetic_field::is_map_cache() const { return _map_cache_; }
+
+void mapped_magnetic_field::set_map_cache_directory(const std::string& dir_) {
+  DT_THROW_IF(is_initialized(), std::logic_error, "Cannot change the map cache directory !");
+  _map_cache_directory_ = dir_;
+  return;
+}
+
+const std::string& mapped_magnetic_field::get_map_cache_directory() const {
+  return _map_cache_directory_;
+}
+
 void mapped_magnetic_field::initialize(const ::datatools::properties& config_,
                                        ::datatools::service_manager& service_manager_,
                                        base_electromagnetic_field::field_dict_type& fields_) {
@@ -259,12 +378,24 @@ void mapped_magnetic_field::initialize(const ::datatools::properties& config_,
     set_z_inverted(z_inverted);
   }
 
+  if (config_.has_key("map_cache")) {
+    bool map_cache = config_.fetch_boolean("map_cache");
+    set_map_cache(map_cache);
+  }
+
+  if (config_.has_key("map_cache_directory")) {
+    const std::string& mcd_str = config_.fetch_string("map_cache_directory");
+    set_map_cache_directory(mcd_str);
+  }
+
   // Private initialization:
   _work_.reset(new _work_type);
 
   if (_mapping_mode_ == MM_IMPORT_CSV_MAP_0) {
     _work_->csv_map_0_data.logging = get_logging_priority();
     _work_->csv_map_0_data.map_filename = _map_filename_;
+    _work_->csv_map_0_data.use_cache = _map_cache_;
+    _work_->csv_map_0_data.cache_directory = _map_cache_directory_;
     _work_->csv_map_0_data.init();
   }
 
@@ -293,8 +424,14 @@ void mapped_magnetic_field::tree_dump(std::ostream& out_, const std::string& tit
   out_ << indent_ << datatools::i_tree_dumpable::tag << "Mapping mode : " << _mapping_mode_
        << std::endl;
 
-  out_ << indent_ << datatools::i_tree_dumpable::inherit_tag(inherit_) << "Map file : '"
-       << _map_filename_ << std::endl;
+  out_ << indent_ << datatools::i_tree_dumpable::tag << "Map file : '" << _map_filename_ << "'"
+       << std::endl;
+
+  out_ << indent_ << datatools::i_tree_dumpable::tag << "Map cache : " << _map_cache_
+       << std::endl;
+
+  out_ << indent_ << datatools::i_tree_dumpable::inherit_tag(inherit_) << "Map cache directory : '"
+       << _map_cache_directory_ << "'" << std::endl;
 
   return;
 }
@@ -309,6 +446,27 @@ int mapped_magnetic_field::compute_electric_field(const geomtools::vector_3d& /*
 int mapped_magnetic_field::compute_magnetic_field(const ::geomtools::vector_3d& position_,
                                                   double /* time_ */,
                                                   ::geomtools::vector_3d& magnetic_field_) const {
+  const int status = _compute_magnetic_field_(position_, magnetic_field_);
+  DT_LOG_DEBUG(get_logging_priority(),
+               "Magnetic field values = " << magnetic_field_ / CLHEP::gauss << " gauss");
+  return status;
+}
+
+int mapped_magnetic_field::compute_magnetic_fields(
+    const std::vector<geomtools::vector_3d>& positions_, double /* time_ */,
+    std::vector<geomtools::vector_3d>& magnetic_fields_) const {
+  magnetic_fields_.resize(positions_.size());
+  int status = STATUS_SUCCESS;
+  for (size_t i = 0; i < positions_.size(); i++) {
+    if (_compute_magnetic_field_(positions_[i], magnetic_fields_[i]) != STATUS_SUCCESS) {
+      status = STATUS_ERROR;
+    }
+  }
+  return status;
+}
+
+int mapped_magnetic_field::_compute_magnetic_field_(
+    const ::geomtools::vector_3d& position_, ::geomtools::vector_3d& magnetic_field_) const {
   int status = STATUS_ERROR;
   if (_mapping_mode_ == MM_IMPORT_CSV_MAP_0) {
     status = _work_->csv_map_0_data.compute(position_, magnetic_field_);
@@ -323,8 +481,6 @@ int mapped_magnetic_field::compute_magnetic_field(const ::geomtools::vector_3d&
       }
     }
   }
-  DT_LOG_DEBUG(get_logging_priority(),
-               "Magnetic field values = " << magnetic_field_ / CLHEP::gauss << " gauss");
   return status;
 }
 
@@ -339,8 +495,150 @@ void csv_map_0_type::load() {
   datatools::fetch_path_with_env(mfn);
   DT_THROW_IF(!boost::filesystem::exists(mfn), std::runtime_error,
               "File '" << mfn << "' does not exist!");
-  std::ifstream fin(mfn.c_str());
-  DT_THROW_IF(!fin, std::runtime_error, "Cannot open file '" << map_filename << "'!");
+
+  std::string cache_filename;
+  uint64_t checksum = 0;
+  if (use_cache) {
+    // The cache file is named after the checksum of the CSV file, so that any change of
+    // the latter selects another cache file:
+    checksum = file_checksum(mfn);
+    std::string cache_dir = cache_directory;
+    if (cache_dir.empty()) {
+      cache_dir = default_cache_directory();
+    } else {
+      datatools::fetch_path_with_env(cache_dir);
+    }
+    if (cache_dir.empty()) {
+      DT_LOG_WARNING(logging, "No directory for the B map cache, the cache is not used!");
+      use_cache = false;
+    } else {
+      std::ostringstream cache_basename;
+      cache_basename << boost::filesystem::path(mfn).filename().string() << '.' << std::hex
+                     << std::setw(16) << std::setfill('0') << checksum << ".bmap";
+      cache_filename = (boost::filesystem::path(cache_dir) / cache_basename.str()).string();
+    }
+  }
+  if (use_cache && map_cache(cache_filename, checksum)) {
+    DT_LOG_DEBUG(logging, "B map loaded from cache file '" << cache_filename << "'");
+    if (logging >= datatools::logger::PRIO_DEBUG) {
+      dump(std::clog);
+    }
+    DT_LOG_TRACE_EXITING(logging);
+    return;
+  }
+
+  parse_csv(mfn);
+  bdata = bmap.data();
+  if (use_cache) {
+    save_cache(cache_filename, checksum);
+  }
+
+  DT_LOG_TRACE_EXITING(logging);
+  return;
+}
+
+bool csv_map_0_type::map_cache(const std::string& cache_filename_, uint64_t checksum_) {
+  const int fd = ::open(cache_filename_.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  // Only trust a regular file that no one else can have written:
+  struct stat file_status;
+  if (::fstat(fd, &file_status) != 0 || !S_ISREG(file_status.st_mode) ||
+      file_status.st_uid != ::geteuid() || (file_status.st_mode & (S_IWGRP | S_IWOTH)) != 0 ||
+      file_status.st_size < (off_t)sizeof(csv_map_0_cache_header)) {
+    ::close(fd);
+    DT_LOG_WARNING(logging, "Ignoring B map cache file '" << cache_filename_
+                                                           << "' with unsafe ownership or size!");
+    return false;
+  }
+  const size_t size = file_status.st_size;
+  void* address = ::mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (address == MAP_FAILED) {
+    return false;
+  }
+  const csv_map_0_cache_header* header = static_cast<const csv_map_0_cache_header*>(address);
+  const size_t nvalues = 3 * static_cast<size_t>(header->nx) * header->ny * header->nz;
+  if (std::memcmp(header->magic, CSV_MAP_0_CACHE_MAGIC, sizeof(header->magic)) != 0 ||
+      header->version != CSV_MAP_0_CACHE_VERSION || header->checksum != checksum_ ||
+      size != sizeof(csv_map_0_cache_header) + nvalues * sizeof(int32_t) ||
+      fnv1a_64(FNV1A_64_BASIS, header + 1, nvalues * sizeof(int32_t)) != header->data_checksum) {
+    DT_LOG_WARNING(logging, "Ignoring invalid B map cache file '" << cache_filename_ << "'!");
+    ::munmap(address, size);
+    return false;
+  }
+  nx = header->nx;
+  ny = header->ny;
+  nz = header->nz;
+  origin.set(header->origin[0], header->origin[1], header->origin[2]);
+  dx = header->step[0];
+  dy = header->step[1];
+  dz = header->step[2];
+  cache_address = address;
+  cache_size = size;
+  bdata = reinterpret_cast<const int32_t*>(static_cast<const char*>(address) +
+                                           sizeof(csv_map_0_cache_header));
+  return true;
+}
+
+void csv_map_0_type::save_cache(const std::string& cache_filename_, uint64_t checksum_) const {
+  csv_map_0_cache_header header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, CSV_MAP_0_CACHE_MAGIC, sizeof(header.magic));
+  header.version = CSV_MAP_0_CACHE_VERSION;
+  header.checksum = checksum_;
+  header.data_checksum = fnv1a_64(FNV1A_64_BASIS, bmap.data(), bmap.size() * sizeof(int32_t));
+  header.nx = nx;
+  header.ny = ny;
+  header.nz = nz;
+  header.origin[0] = origin.x();
+  header.origin[1] = origin.y();
+  header.origin[2] = origin.z();
+  header.step[0] = dx;
+  header.step[1] = dy;
+  header.step[2] = dz;
+
+  // Write a new temporary file, readable and writable by the user only, then rename it,
+  // so that concurrent jobs never map a partially written cache:
+  std::string tmp_filename = cache_filename_ + ".XXXXXX";
+  const int fd = ::mkstemp(&tmp_filename[0]);
+  if (fd < 0) {
+    DT_LOG_WARNING(logging, "Cannot write the B map cache file '" << cache_filename_ << "'!");
+    return;
+  }
+  const char* chunks[2] = {reinterpret_cast<const char*>(&header),
+                           reinterpret_cast<const char*>(bmap.data())};
+  size_t sizes[2] = {sizeof(header), bmap.size() * sizeof(int32_t)};
+  bool ok = true;
+  for (int chunk = 0; ok && chunk < 2; chunk++) {
+    while (ok && sizes[chunk] > 0) {
+      const ssize_t n = ::write(fd, chunks[chunk], sizes[chunk]);
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      ok = n > 0;
+      if (ok) {
+        chunks[chunk] += n;
+        sizes[chunk] -= n;
+      }
+    }
+  }
+  ok = (::close(fd) == 0) && ok;
+  if (ok) {
+    ok = std::rename(tmp_filename.c_str(), cache_filename_.c_str()) == 0;
+  }
+  if (!ok) {
+    std::remove(tmp_filename.c_str());
+    DT_LOG_WARNING(logging, "Cannot write the B map cache file '" << cache_filename_ << "'!");
+    return;
+  }
+  DT_LOG_DEBUG(logging, "B map saved in cache file '" << cache_filename_ << "'");
+}
+
+void csv_map_0_type::parse_csv(const std::string& filename_) {
+  std::ifstream fin(filename_.c_str());
+  DT_THROW_IF(!fin, std::runtime_error, "Cannot open file '" << filename_ << "'!");
 
   DT_LOG_TRACE(logging, "Loading B map header...");
   {
@@ -380,8 +678,7 @@ void csv_map_0_type::load() {
   DT_LOG_TRACE(logging, "Loading B  map...");
   {
     // Read map:
-    csv_map_0_type::vvvvd& bb = bmap;
-    bb.reserve(3);
+    bmap.assign(3 * static_cast<size_t>(nx) * ny * nz, 0);
     for (size_t ax = 0; ax < 3; ax++) {
       if (ax == 0) {
         DT_LOG_TRACE(logging, "Loading Bx table...");
@@ -390,20 +687,8 @@ void csv_map_0_type::load() {
       } else if (ax == 2) {
         DT_LOG_TRACE(logging, "Loading Bz table...");
       }
-      {
-        csv_map_0_type::vvvd dummy;
-        bb.push_back(dummy);
-      }
-      csv_map_0_type::vvvd& bxyz = bb.back();
-      bxyz.reserve(nz);
       for (size_t iz = 0; iz < nz; iz++) {
         DT_LOG_TRACE(logging, "  Scanning iz=" << iz);
-        {
-          csv_map_0_type::vvd dummy;
-          bxyz.push_back(dummy);
-        }
-        csv_map_0_type::vvd& bxy = bxyz.back();
-        bxy.reserve(ny);
         for (size_t iy = 0; iy < ny; iy++) {
           DT_LOG_TRACE(logging, "    Scanning iy=" << iy);
           std::string bmap_line;
@@ -420,74 +705,54 @@ void csv_map_0_type::load() {
           DT_LOG_TRACE(logging, "    axi=[" << axi << "] iyi=[" << iyi << "] izi=[" << izi << "] ");
           DT_THROW_IF(axi != ax || iyi != iy || izi != iz, std::logic_error,
                       "Invalid B map line format!");
-          {
-            csv_map_0_type::vd dummy;
-            bxy.push_back(dummy);
-          }
-          csv_map_0_type::vd& xdata = bxy.back();
-          xdata.reserve(btokens.size() - 3);
-          for (size_t ix = 3; ix < btokens.size(); ix++) {
-            xdata.push_back(boost::lexical_cast<int>(btokens[ix]));
+          int32_t* bline = &bmap[3 * (iz * ny + iy) * nx + ax];
+          for (size_t ix = 0; ix < nx; ix++) {
+            bline[3 * ix] = boost::lexical_cast<int32_t>(btokens[ix + 3]);
           }
         }
       }
     }
   }
-
-  DT_LOG_TRACE_EXITING(logging);
   return;
 }
 
 int csv_map_0_type::interpolate(const ::geomtools::vector_3d& position_,
                                 ::geomtools::vector_3d& magnetic_field_) const {
-  double xu = (position_.x() - origin.x()) / dx;
-  double yu = (position_.y() - origin.y()) / dy;
-  double zu = (position_.z() - origin.z()) / dz;
-  DT_LOG_DEBUG(logging, "xu=[" << xu << "] yu=[" << yu << "] zu=[" << zu << "]");
-  int ixl = (int)xu;
-  int iyl = (int)yu;
-  int izl = (int)zu;
+  const double xu = (position_.x() - origin.x()) / dx;
+  const double yu = (position_.y() - origin.y()) / dy;
+  const double zu = (position_.z() - origin.z()) / dz;
+  const int ixl = (int)xu;
+  const int iyl = (int)yu;
+  const int izl = (int)zu;
   DT_LOG_DEBUG(logging, "ixl=[" << ixl << "] iyl=[" << iyl << "] izl=[" << izl << "]");
-  double fx = xu - ixl;
-  double fy = yu - iyl;
-  double fz = zu - izl;
-  double gx = 1.0 - fx;
-  double gy = 1.0 - fy;
-  double gz = 1.0 - fz;
-  DT_LOG_DEBUG(logging, "  fx=[" << fx << "] fy=[" << fy << "] fz=[" << fz << "]");
-  DT_LOG_DEBUG(logging, "  gx=[" << gx << "] gy=[" << gy << "] gz=[" << gz << "]");
-  const vvvvd& bb = bmap;
-  if (ixl >= 0 && ixl < (int)(nx - 1) && iyl >= 0 && iyl < (int)(ny - 1) && izl >= 0 &&
-      izl < (int)(nz - 1)) {
-    DT_LOG_DEBUG(logging, "TEST...");
-    for (int ax = 0; ax < 3; ax++) {
-      const vvvd& b3d = bb[ax];
-      int b000 = b3d[izl][iyl][ixl];
-      int b100 = b3d[izl][iyl][ixl + 1];
-      int b010 = b3d[izl][iyl + 1][ixl];
-      int b001 = b3d[izl + 1][iyl][ixl];
-      int b110 = b3d[izl][iyl + 1][ixl + 1];
-      int b011 = b3d[izl + 1][iyl + 1][ixl];
-      int b101 = b3d[izl + 1][iyl][ixl + 1];
-      int b111 = b3d[izl + 1][iyl + 1][ixl + 1];
-      DT_LOG_DEBUG(logging, "  b000=[" << b000 << "] b100=[" << b100 << "] b010=[" << b010
-                                       << "] b001=[" << b001 << "]");
-      DT_LOG_DEBUG(logging, "  b110=[" << b110 << "] b011=[" << b011 << "] b101=[" << b101
-                                       << "] b111=[" << b111 << "]");
-      double bf00 = gx * b000 + fx * b100;
-      double bf10 = gx * b010 + fx * b110;
-      double bff0 = gy * bf00 + fy * bf10;
-      double bf01 = gx * b001 + fx * b101;
-      double bf11 = gx * b011 + fx * b111;
-      double bff1 = gy * bf01 + fy * bf11;
-      double bfff = gz * bff0 + fz * bff1;
-      magnetic_field_[ax] = bfff;
-    }
-  } else {
+  if (ixl < 0 || ixl >= (int)nx - 1 || iyl < 0 || iyl >= (int)ny - 1 || izl < 0 ||
+      izl >= (int)nz - 1) {
     geomtools::invalidate(magnetic_field_);
     return mapped_magnetic_field::STATUS_ERROR;
   }
-
+  const double fx = xu - ixl;
+  const double fy = yu - iyl;
+  const double fz = zu - izl;
+  const double gx = 1.0 - fx;
+  const double gy = 1.0 - fy;
+  const double gz = 1.0 - fz;
+
+  // Weights and nodes of the grid cell, the X index running fastest:
+  const double w[8] = {gx * gy * gz, fx * gy * gz, gx * fy * gz, fx * fy * gz,
+                       gx * gy * fz, fx * gy * fz, gx * fy * fz, fx * fy * fz};
+  const size_t sx = 3;
+  const size_t sy = 3 * static_cast<size_t>(nx);
+  const size_t sz = sy * ny;
+  const int32_t* b000 = bdata + sz * izl + sy * iyl + sx * ixl;
+  const int32_t* nodes[8] = {b000,      b000 + sx,      b000 + sy,      b000 + sy + sx,
+                             b000 + sz, b000 + sz + sx, b000 + sz + sy, b000 + sz + sy + sx};
+  for (int ax = 0; ax < 3; ax++) {
+    double bfff = 0.0;
+    for (int k = 0; k < 8; k++) {
+      bfff += w[k] * nodes[k][ax];
+    }
+    magnetic_field_[ax] = bfff;
+  }
   return mapped_magnetic_field::STATUS_SUCCESS;
 }
 
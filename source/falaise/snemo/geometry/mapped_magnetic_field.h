@@ -34,6 +34,7 @@
 
 // Standard library:
 #include <string>
+#include <vector>
 
 // Third party:
 // - Bayeux/emfield:
@@ -43,7 +44,17 @@ namespace snemo {
 
 namespace geometry {
 
-/// \brief Class representing a contant mapped  magnetic field
+/** \brief Class representing a contant mapped  magnetic field
+ *
+ *  The map is stored as a single flat array of packed (Bx, By, Bz) triplets
+ *  and interpolated with a trilinear kernel over the 8 nodes of a grid cell.
+ *
+ *  If the map cache is enabled, the imported CSV map is saved in a binary
+ *  file, named after the checksum of the CSV file, which is memory mapped by
+ *  the next jobs instead of parsing the CSV file again. A cache file is only
+ *  used if it belongs to the user, is not writable by others and its values
+ *  match their checksum.
+ */
 class mapped_magnetic_field : public ::emfield::base_electromagnetic_field {
  public:
   /// \brief Mapping mode
@@ -73,6 +84,12 @@ class mapped_magnetic_field : public ::emfield::base_electromagnetic_field {
   virtual int compute_magnetic_field(const ::geomtools::vector_3d &position_, double time_,
                                      geomtools::vector_3d &magnetic_field_) const;
 
+  /// Compute magnetic field at many positions. The field is zero or invalid at the positions
+  /// outside the mapped domain, as for compute_magnetic_field.
+  /// @return STATUS_SUCCESS if the field could be computed at all positions
+  int compute_magnetic_fields(const std::vector<geomtools::vector_3d> &positions_, double time_,
+                              std::vector<geomtools::vector_3d> &magnetic_fields_) const;
+
   /// Smart print
   virtual void tree_dump(std::ostream &out_ = std::clog, const std::string &title_ = "",
                          const std::string &indent_ = "", bool inherit_ = false) const;
@@ -95,15 +112,35 @@ class mapped_magnetic_field : public ::emfield::base_electromagnetic_field {
   /// Return the Z component inversion flag
   bool is_z_inverted() const;
 
+  /// Set the flag to cache the imported map in a memory mapped binary file
+  void set_map_cache(bool);
+
+  /// Return the flag to cache the imported map in a memory mapped binary file
+  bool is_map_cache() const;
+
+  /// Set the directory of the binary map cache (default: $XDG_CACHE_HOME/falaise or
+  /// ~/.cache/falaise)
+  void set_map_cache_directory(const std::string &);
+
+  /// Return the directory of the binary map cache
+  const std::string &get_map_cache_directory() const;
+
  protected:
   /// Set default attributes values
   void _set_defaults();
 
  private:
-  mapping_mode_type _mapping_mode_;  //!< Mapping mode
-  std::string _map_filename_;        //!< Map filename
-  bool _zero_field_outside_map_;     //!< Force zero field outside the interpolated map
-  bool _z_inverted_;                 //!< Invert the Z component of the field
+  /// Compute magnetic field at a given position
+  int _compute_magnetic_field_(const ::geomtools::vector_3d &position_,
+                               ::geomtools::vector_3d &magnetic_field_) const;
+
+ private:
+  mapping_mode_type _mapping_mode_;   //!< Mapping mode
+  std::string _map_filename_;         //!< Map filename
+  bool _zero_field_outside_map_;      //!< Force zero field outside the interpolated map
+  bool _z_inverted_;                  //!< Invert the Z component of the field
+  bool _map_cache_;                   //!< Cache the imported map in a binary file
+  std::string _map_cache_directory_;  //!< Directory of the binary map cache
 
   struct _work_type;
   boost::scoped_ptr<_work_type> _work_;  //!< PIMPL-ized working data
@@ -14,6 +14,7 @@
 // This project:
 #include <falaise/snemo/datamodels/particle_track_data.h>
 #include <falaise/snemo/geometry/calo_locator.h>
+#include <falaise/snemo/geometry/detector_index.h>
 #include <falaise/snemo/geometry/gveto_locator.h>
 #include <falaise/snemo/geometry/locator_plugin.h>
 #include <falaise/snemo/geometry/xcalo_locator.h>
@@ -51,6 +52,40 @@ const snemo::geometry::gveto_locator& base_gamma_builder::get_gveto_locator() co
   return _locator_plugin_->get_gveto_locator();
 }
 
+bool base_gamma_builder::has_detector_index() const {
+  DT_THROW_IF(!is_initialized(), std::logic_error,
+              "Driver '" << get_id() << "' is not initialized !");
+  return _locator_plugin_->has_detector_index();
+}
+
+const snemo::geometry::detector_index& base_gamma_builder::get_detector_index() const {
+  DT_THROW_IF(!is_initialized(), std::logic_error,
+              "Driver '" << get_id() << "' is not initialized !");
+  return _locator_plugin_->get_detector_index();
+}
+
+snemo::geometry::detector_index::element_type base_gamma_builder::get_calo_block_type(
+    const geomtools::geom_id& gid_) const {
+  if (has_detector_index()) {
+    const snemo::geometry::detector_index::element_type type =
+        get_detector_index().get_element_type(gid_);
+    if (type == snemo::geometry::detector_index::ELEMENT_DRIFT_CELL) {
+      return snemo::geometry::detector_index::ELEMENT_INVALID;
+    }
+    return type;
+  }
+  if (get_calo_locator().is_calo_block_in_current_module(gid_)) {
+    return snemo::geometry::detector_index::ELEMENT_CALO_BLOCK;
+  }
+  if (get_xcalo_locator().is_calo_block_in_current_module(gid_)) {
+    return snemo::geometry::detector_index::ELEMENT_XCALO_BLOCK;
+  }
+  if (get_gveto_locator().is_calo_block_in_current_module(gid_)) {
+    return snemo::geometry::detector_index::ELEMENT_GVETO_BLOCK;
+  }
+  return snemo::geometry::detector_index::ELEMENT_INVALID;
+}
+
 bool base_gamma_builder::is_initialized() const { return _initialized_; }
 
 void base_gamma_builder::_set_initialized(bool i_) {
@@ -470,19 +505,23 @@ int base_gamma_builder::_post_process(const base_gamma_builder::hit_collection_t
           geomtools::vector_3d a_block_position;
           std::string a_label;
           const geomtools::geom_id& a_gid = a_calo_hit.get_geom_id();
-          if (get_calo_locator().is_calo_block_in_current_module(a_gid)) {
-            get_calo_locator().get_block_position(a_gid, a_block_position);
-            a_label = snemo::datamodel::particle_track::vertex_on_main_calorimeter_label();
-          } else if (get_xcalo_locator().is_calo_block_in_current_module(a_gid)) {
-            get_xcalo_locator().get_block_position(a_gid, a_block_position);
-            a_label = snemo::datamodel::particle_track::vertex_on_x_calorimeter_label();
-          } else if (get_gveto_locator().is_calo_block_in_current_module(a_gid)) {
-            get_gveto_locator().get_block_position(a_gid, a_block_position);
-            a_label = snemo::datamodel::particle_track::vertex_on_gamma_veto_label();
-          } else {
-            DT_THROW_IF(
-                true, std::logic_error,
-                "Current geom id '" << a_gid << "' does not match any scintillator block !");
+          switch (get_calo_block_type(a_gid)) {
+            case snemo::geometry::detector_index::ELEMENT_CALO_BLOCK:
+              get_calo_locator().get_block_position(a_gid, a_block_position);
+              a_label = snemo::datamodel::particle_track::vertex_on_main_calorimeter_label();
+              break;
+            case snemo::geometry::detector_index::ELEMENT_XCALO_BLOCK:
+              get_xcalo_locator().get_block_position(a_gid, a_block_position);
+              a_label = snemo::datamodel::particle_track::vertex_on_x_calorimeter_label();
+              break;
+            case snemo::geometry::detector_index::ELEMENT_GVETO_BLOCK:
+              get_gveto_locator().get_block_position(a_gid, a_block_position);
+              a_label = snemo::datamodel::particle_track::vertex_on_gamma_veto_label();
+              break;
+            default:
+              DT_THROW_IF(
+                  true, std::logic_error,
+                  "Current geom id '" << a_gid << "' does not match any scintillator block !");
           }
 
           const double track_length = (a_block_position - a_spot.get_position()).mag();
@@ -39,6 +39,7 @@
 
 // Falaise:
 #include <falaise/snemo/datamodels/calibrated_data.h>
+#include <falaise/snemo/geometry/detector_index.h>
 
 // Forward declaration :
 namespace datatools {
@@ -88,6 +89,17 @@ class base_gamma_builder {
   /// Return the gamma veto calorimeter locator
   const snemo::geometry::gveto_locator &get_gveto_locator() const;
 
+  /// Check if the spatial index of the detector elements is available
+  bool has_detector_index() const;
+
+  /// Return the spatial index of the detector elements
+  const snemo::geometry::detector_index &get_detector_index() const;
+
+  /// Return the type of the scintillator block with a given geometry ID, from the detector
+  /// index if available or else from the calorimeter locators
+  snemo::geometry::detector_index::element_type get_calo_block_type(
+      const geomtools::geom_id &gid_) const;
+
   /// Check the geometry manager
   bool has_geometry_manager() const;
 
@@ -12,13 +12,30 @@
 // - Bayeux/datatools:
 #include <datatools/clhep_units.h>
 #include <datatools/properties.h>
+#include <datatools/utils.h>
 // - Bayeux/mygsl:
 #include <mygsl/rng.h>
 
+// This project:
+#include <falaise/snemo/processing/random_stream.h>
+
 namespace snemo {
 
 namespace processing {
 
+namespace {
+
+/// Conversion factor from FWHM to sigma of a gaussian
+const double FWHM_TO_SIGMA = 1.0 / (2 * std::sqrt(2 * std::log(2.0)));
+
+/// Upper bound of the alpha quenching table (above the Po-212 alpha energy)
+const double ALPHA_QUENCHING_TABLE_MAX_ENERGY = 12. * CLHEP::MeV;
+
+/// Number of bins of the alpha quenching table
+const size_t NUMBER_OF_TABLE_BINS = 4096;
+
+}  // namespace
+
 // static
 const double& calorimeter_regime::default_energy_resolution() {
   static double _r(8. * CLHEP::perCent);
@@ -89,6 +106,14 @@ void calorimeter_regime::initialize(const datatools::properties& config_) {
     }
   }
 
+  // Alpha quenching
+  {
+    const std::string key_name = "alpha_quenching";
+    if (config_.has_key(key_name)) {
+      _alpha_quenching_ = config_.fetch_boolean(key_name);
+    }
+  }
+
   // Alpha quenching fit parameters
   {
     const std::string key_name = "alpha_quenching_parameters";
@@ -97,6 +122,9 @@ void calorimeter_regime::initialize(const datatools::properties& config_) {
       _alpha_quenching_1_ = config_.fetch_real_vector(key_name, 1);
       _alpha_quenching_2_ = config_.fetch_real_vector(key_name, 2);
     }
+    DT_THROW_IF(_alpha_quenching_ && !(_alpha_quenching_0_ > 0.0 && _alpha_quenching_1_ > 0.0 &&
+                                       _alpha_quenching_2_ > 0.0),
+                std::range_error, "Invalid alpha quenching parameters !");
   }
 
   // Scintillator relaxation time for time resolution
@@ -110,6 +138,11 @@ void calorimeter_regime::initialize(const datatools::properties& config_) {
     }
   }
 
+  _sigma_energy_factor_ = _resolution_ * FWHM_TO_SIGMA / std::sqrt(CLHEP::MeV);
+  if (_alpha_quenching_) {
+    _build_tables_();
+  }
+
   _initialized_ = true;
   return;
 }
@@ -126,6 +159,7 @@ void calorimeter_regime::_init_defaults_() {
   _scintillator_relaxation_time_ = default_scintillator_relaxation_time();
 
   // Default alpha quenching parameters:
+  _alpha_quenching_ = true;
   _alpha_quenching_0_ = 77.4;
   _alpha_quenching_1_ = 0.639;
   _alpha_quenching_2_ = 2.34;
@@ -133,6 +167,10 @@ void calorimeter_regime::_init_defaults_() {
   // Default category is empty:
   _category_ = "";
 
+  // Reset internals:
+  datatools::invalidate(_sigma_energy_factor_);
+  _quenched_alpha_energy_.reset();
+
   return;
 }
 
@@ -161,22 +199,35 @@ double calorimeter_regime::randomize_energy(mygsl::rng& ran_, const double energ
 
   // 2016-06-01 XG: Get back to gaussian fluctuation to avoid fixed number
   // of photon-electron due to Poisson distribution
-  const double sigma_energy = get_sigma_energy(energy_);
+  const double sigma_energy = _sigma_energy_factor_ * std::sqrt(energy_);
   const double spread_energy = ran_.gaussian(energy_, sigma_energy);
   return (spread_energy < 0.0 ? 0.0 : spread_energy);
 }
 
-double calorimeter_regime::get_sigma_energy(const double energy_) const {
+double calorimeter_regime::randomize_energy(random_stream& ran_, const double energy_) const {
   DT_THROW_IF(!is_initialized(), std::logic_error, "Not initialized !");
+  const double sigma_energy = _sigma_energy_factor_ * std::sqrt(energy_);
+  const double spread_energy = ran_.gaussian(energy_, sigma_energy);
+  return (spread_energy < 0.0 ? 0.0 : spread_energy);
+}
 
-  const double fwhm2sig = 1.0 / (2 * sqrt(2 * log(2.0)));
-
-  return _resolution_ * fwhm2sig * sqrt(energy_ / CLHEP::MeV);
+double calorimeter_regime::get_sigma_energy(const double energy_) const {
+  DT_THROW_IF(!is_initialized(), std::logic_error, "Not initialized !");
+  // The resolution scales as a single square root: it is cheaper and more
+  // accurate to evaluate it than to interpolate it near zero energy.
+  return _sigma_energy_factor_ * std::sqrt(energy_);
 }
 
-double calorimeter_regime::quench_alpha_energy(const double energy_) const {
+double calorimeter_regime::quench_alpha_energy(const double energy_, int mode_) const {
   DT_THROW_IF(!is_initialized(), std::logic_error, "Not initialized !");
+  if (mode_ == 0 && _quenched_alpha_energy_.is_built() &&
+      _quenched_alpha_energy_.contains(energy_)) {
+    return _quenched_alpha_energy_(energy_);
+  }
+  return _compute_quenched_alpha_energy_(energy_);
+}
 
+double calorimeter_regime::_compute_quenched_alpha_energy_(const double energy_) const {
   const double energy = energy_ * CLHEP::MeV;
 
   const double par_0 = _alpha_quenching_0_;
@@ -192,6 +243,19 @@ double calorimeter_regime::quench_alpha_energy(const double energy_) const {
   return quenched_energy;
 }
 
+void calorimeter_regime::_build_tables_() {
+  _quenched_alpha_energy_.build(0.0, ALPHA_QUENCHING_TABLE_MAX_ENERGY, NUMBER_OF_TABLE_BINS);
+  // The fitted formula is 0/0 at zero energy, where the quenching factor is
+  // par_0 * par_1 * par_2 * E / 2 at first order:
+  _quenched_alpha_energy_.values[0] =
+      2.0 / (_alpha_quenching_0_ * _alpha_quenching_1_ * _alpha_quenching_2_);
+  for (size_t i = 1; i <= _quenched_alpha_energy_.nbins; i++) {
+    _quenched_alpha_energy_.values[i] =
+        _compute_quenched_alpha_energy_(_quenched_alpha_energy_.node(i));
+  }
+  return;
+}
+
 double calorimeter_regime::randomize_time(mygsl::rng& ran_, const double time_,
                                           const double energy_) const {
   DT_THROW_IF(!is_initialized(), std::logic_error, "Not initialized !");
@@ -204,6 +268,12 @@ double calorimeter_regime::randomize_time(mygsl::rng& ran_, const double time_,
   return spread_time;
 }
 
+double calorimeter_regime::randomize_time(random_stream& ran_, const double time_,
+                                          const double energy_) const {
+  DT_THROW_IF(!is_initialized(), std::logic_error, "Not initialized !");
+  return ran_.gaussian(time_, get_sigma_time(energy_));
+}
+
 double calorimeter_regime::get_sigma_time(const double energy_) const {
   DT_THROW_IF(!is_initialized(), std::logic_error, "Not initialized !");
 
@@ -211,8 +281,7 @@ double calorimeter_regime::get_sigma_time(const double energy_) const {
   // L. Simard parametrization for NEMO3 simulation
   const double scin_time = _scintillator_relaxation_time_;
 
-  const double fwhm2sig = 1.0 / (2 * sqrt(2 * log(2.0)));
-  const double sigma_e = _resolution_ * fwhm2sig;
+  const double sigma_e = _resolution_ * FWHM_TO_SIGMA;
 
   const double sigma_time = scin_time * sigma_e / sqrt(energy_ / CLHEP::MeV);
 
@@ -250,6 +319,8 @@ void calorimeter_regime::tree_dump(std::ostream& out_, const std::string& title_
   out_ << indent << datatools::i_tree_dumpable::tag
        << "Relaxation time       = " << _scintillator_relaxation_time_ / CLHEP::ns << " ns"
        << std::endl;
+  out_ << indent << datatools::i_tree_dumpable::tag
+       << "Alpha quenching       = " << _alpha_quenching_ << std::endl;
   out_ << indent << datatools::i_tree_dumpable::tag
        << "Alpha quenching par0  = " << _alpha_quenching_0_ << std::endl;
   out_ << indent << datatools::i_tree_dumpable::tag
@@ -25,6 +25,9 @@
 // - Bayeux/datatools
 #include <datatools/i_tree_dump.h>
 
+// This project:
+#include <falaise/snemo/processing/uniform_table.h>
+
 namespace datatools {
 class properties;
 }
@@ -37,6 +40,8 @@ namespace snemo {
 
 namespace processing {
 
+class random_stream;
+
 /// \brief Simple modelling of the energy and time measurement with the SuperNEMO calorimeter
 /// optical lines
 class calorimeter_regime : public datatools::i_tree_dumpable {
@@ -68,15 +73,29 @@ class calorimeter_regime : public datatools::i_tree_dumpable {
   /// Randomize the measured energy value given the true energy
   double randomize_energy(mygsl::rng& ran_, const double energy_) const;
 
+  /// Randomize the measured energy value given the true energy, with a counter-based random
+  /// stream
+  double randomize_energy(random_stream& ran_, const double energy_) const;
+
   /// Return the error on energy
   double get_sigma_energy(const double energy_) const;
 
   /// Compute the effective quenched energy for alpha particle
-  double quench_alpha_energy(const double energy_) const;
+  ///
+  /// Mode 0 interpolates the table built at initialization, mode 1 evaluates
+  /// the fitted quenching formula. The table is only built, and the fit
+  /// parameters only checked, if alpha quenching is used (the
+  /// "alpha_quenching" property, true by default); otherwise mode 0 also
+  /// evaluates the formula.
+  double quench_alpha_energy(const double energy_, int mode_ = 0) const;
 
   /// Randomize the measured time value given the true time and energy
   double randomize_time(mygsl::rng& ran_, const double time_, const double energy_) const;
 
+  /// Randomize the measured time value given the true time and energy, with a counter-based
+  /// random stream
+  double randomize_time(random_stream& ran_, const double time_, const double energy_) const;
+
   /// Return the error on time
   double get_sigma_time(const double energy_) const;
 
@@ -99,17 +118,28 @@ class calorimeter_regime : public datatools::i_tree_dumpable {
  private:
   void _init_defaults_();
 
+  /// Compute the quenched energy of an alpha particle with the fitted formula
+  double _compute_quenched_alpha_energy_(const double energy_) const;
+
+  /// Build the alpha quenching table
+  void _build_tables_();
+
  private:
   bool _initialized_;                     //!< Initialization flag
   double _resolution_;                    //!< Energy resolution for electrons at 1 MeV
   double _high_threshold_;                //!< High energy threshold
   double _low_threshold_;                 //!< Low energy threshold
+  bool _alpha_quenching_;                 //!< Flag to use the alpha quenching
   double _alpha_quenching_0_;             //!< Parameter 0 for alpha quenching
   double _alpha_quenching_1_;             //!< Parameter 1 for alpha quenching
   double _alpha_quenching_2_;             //!< Parameter 2 for alpha quenching
   double _scintillator_relaxation_time_;  //!< Scintillator relaxation time
   std::string
       _category_;  //!< The category of the optical modules associated to this calorimeter regime
+
+  // internals:
+  double _sigma_energy_factor_;           //!< Energy resolution sigma at 1 MeV, in energy unit
+  uniform_table _quenched_alpha_energy_;  //!< Quenched alpha energy from the deposited energy
 };
 
 }  // end of namespace processing
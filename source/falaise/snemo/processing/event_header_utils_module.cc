@@ -102,6 +102,13 @@ void event_header_utils_module::initialize(const datatools::properties& setup_,
   if (is_add_header_mode()) {
     _ah_current_run_number_ = _add_header_run_number_;
     _ah_current_event_number_ = _add_header_event_number_;
+    // Parse the external properties once for all events:
+    if (!_add_header_properties_path_.empty()) {
+      datatools::properties::read_config(_add_header_properties_path_, _ah_external_properties_);
+      if (!_add_header_properties_prefix_.empty()) {
+        _ah_external_properties_.erase_all_not_starting_with(_add_header_properties_prefix_);
+      }
+    }
   }
 
   _set_initialized(true);
@@ -132,6 +139,7 @@ void event_header_utils_module::_set_defaults() {
 
   _ah_current_run_number_ = _add_header_run_number_;
   _ah_current_event_number_ = _add_header_event_number_;
+  _ah_external_properties_.clear();
   return;
 }
 
@@ -209,10 +217,10 @@ void event_header_utils_module::_process_add_header(datatools::things& data_reco
   the_event_header.grab_timestamp().set_seconds(0);
   the_event_header.grab_timestamp().set_picoseconds(0);
 
-  // Retrieve properties from external files
+  // Store properties retrieved from external files
   if (!_add_header_properties_path_.empty()) {
     datatools::properties& the_properties = the_event_header.grab_properties();
-    datatools::properties::read_config(_add_header_properties_path_, the_properties);
+    _ah_external_properties_.export_all(the_properties);
     if (!_add_header_properties_prefix_.empty()) {
       the_properties.erase_all_not_starting_with(_add_header_properties_prefix_);
     }
@@ -16,6 +16,8 @@
 #define FALAISE_SNEMO_PROCESSING_EVENT_HEADER_UTILS_MODULE_H 1
 
 // Third party:
+// - Bayeux/datatools:
+#include <datatools/properties.h>
 // - Bayeux/dpp:
 #include <dpp/base_module.h>
 
@@ -89,6 +91,7 @@ class event_header_utils_module : public dpp::base_module {
   // For "add header" mode:
   int _ah_current_run_number_;
   int _ah_current_event_number_;
+  datatools::properties _ah_external_properties_;  //!< Stored external properties, loaded once
 
   // Macro to automate the registration of the module :
   DPP_MODULE_REGISTRATION_INTERFACE(event_header_utils_module)
@@ -17,10 +17,20 @@
 // - Bayeux/mygsl:
 #include <mygsl/rng.h>
 
+// This project:
+#include <falaise/snemo/processing/random_stream.h>
+
 namespace snemo {
 
 namespace processing {
 
+namespace {
+
+/// Number of bins of the drift time <-> drift radius tables
+const size_t NUMBER_OF_TABLE_BINS = 4096;
+
+}  // namespace
+
 bool geiger_regime::is_initialized() const { return _initialized_; }
 
 void geiger_regime::reset() {
@@ -130,24 +140,16 @@ void geiger_regime::initialize(const datatools::properties& config_) {
               "Cut drift time is too short (" << _tcut_ / time_unit << " us < 8 us) !");
 
   const double r_cell = 0.5 * _cell_diameter_;
-  // 2011-05-12 FM : Compute a valid t0 before :
-  double step_drift_time1 = 0.050 * time_unit;
-  bool tune = false;
-  for (double drift_time = 0.0 * time_unit; drift_time < (_tcut_ + 0.5 * step_drift_time1);
-       drift_time += step_drift_time1) {
-    const double drift_radius = base_t_2_r(drift_time, 1);
-    if (drift_radius > r_cell) {
-      if (tune) {
-        _t0_ = drift_time - 0.5 * step_drift_time1;
-        break;
-      } else {
-        drift_time -= 2 * step_drift_time1;
-        step_drift_time1 /= 20;
-        tune = true;
-      }
-    }
-  }
+  // t0 is the drift time at which the prompt regime reaches the cell radius. The prompt
+  // relation is monotonous, so that t0 is found by bisection:
+  DT_THROW_IF(_compute_t_2_r_(_tcut_, false) <= r_cell, std::range_error,
+              "Cell radius is not reached before the cut drift time !");
+  _t0_ = _invert_t_2_r_(r_cell, 0.0, _tcut_, false);
+  _r0_ = r_cell;
+  _rdiag_ = r_cell * sqrt(2.0);
+  _build_tables_();
 
+  // Coarse tabulated function, only kept for the grab_base_rt accessor:
   const double step_drift_time = 0.2 * time_unit;
   for (double drift_time = 0.0 * time_unit; drift_time < (_tcut_ + 0.5 * step_drift_time);
        drift_time += step_drift_time) {
@@ -155,8 +157,6 @@ void geiger_regime::initialize(const datatools::properties& config_) {
     _base_rt_.add_point(drift_radius, drift_time, false);
   }
   _base_rt_.lock_table("linear");
-  _r0_ = r_cell;
-  _rdiag_ = r_cell * sqrt(2.0);
 
   _initialized_ = true;
   return;
@@ -189,6 +189,10 @@ void geiger_regime::_init_defaults_() {
   datatools::invalidate(_r0_);
   datatools::invalidate(_rdiag_);
   _base_rt_.reset();
+  _prompt_t2r_.reset();
+  _late_t2r_.reset();
+  _prompt_r2t_.reset();
+  _late_r2t_.reset();
 
   return;
 }
@@ -294,8 +298,7 @@ double geiger_regime::randomize_r(mygsl::rng& ran_, double r_) const {
   return r;
 }
 
-double geiger_regime::base_t_2_r(double time_, int mode_) const {
-  DT_THROW_IF(time_ < 0.0, std::range_error, "Invalid drift time !");
+double geiger_regime::_compute_t_2_r_(double time_, bool late_) const {
   /* Fit obtained from:
    *   shell> cd <sncore source dir>/doc/geiger_regime
    *   shell> gnuplot calib_t-r_0.gpl
@@ -308,14 +311,74 @@ double geiger_regime::base_t_2_r(double time_, int mode_) const {
   const double B2 = 0.949912427483918;
   const double t_usec = time_ / CLHEP::microsecond;
   const double ut = 10. * t_usec;
-  double r = A1 * ut / (std::pow(ut, B1) + C1);
+  double r;
+  if (late_) {
+    r = A2 * ut / (std::pow(ut, B2));
+  } else {
+    r = A1 * ut / (std::pow(ut, B1) + C1);
+  }
+  r *= CLHEP::cm;
+  return r;
+}
+
+double geiger_regime::_invert_t_2_r_(double radius_, double tmin_, double tmax_,
+                                     bool late_) const {
+  // Both regimes are increasing functions of the drift time:
+  double tlow = tmin_;
+  double thigh = tmax_;
+  for (int i = 0; i < 100 && (thigh - tlow) > 1.e-6 * CLHEP::ns; i++) {
+    const double t = 0.5 * (tlow + thigh);
+    if (_compute_t_2_r_(t, late_) < radius_) {
+      tlow = t;
+    } else {
+      thigh = t;
+    }
+  }
+  return 0.5 * (tlow + thigh);
+}
+
+void geiger_regime::_build_tables_() {
+  _prompt_t2r_.build(0.0, _t0_, NUMBER_OF_TABLE_BINS);
+  for (size_t i = 0; i <= _prompt_t2r_.nbins; i++) {
+    _prompt_t2r_.values[i] = _compute_t_2_r_(_prompt_t2r_.xmin + i * _prompt_t2r_.step, false);
+  }
+  _late_t2r_.build(_t0_, _tcut_, NUMBER_OF_TABLE_BINS);
+  for (size_t i = 0; i <= _late_t2r_.nbins; i++) {
+    _late_t2r_.values[i] = _compute_t_2_r_(_late_t2r_.xmin + i * _late_t2r_.step, true);
+  }
+  _prompt_r2t_.build(0.0, _compute_t_2_r_(_t0_, false), NUMBER_OF_TABLE_BINS);
+  for (size_t i = 0; i <= _prompt_r2t_.nbins; i++) {
+    _prompt_r2t_.values[i] =
+        _invert_t_2_r_(_prompt_r2t_.xmin + i * _prompt_r2t_.step, 0.0, _t0_, false);
+  }
+  _late_r2t_.build(_compute_t_2_r_(_t0_, true), _compute_t_2_r_(_tcut_, true),
+                   NUMBER_OF_TABLE_BINS);
+  for (size_t i = 0; i <= _late_r2t_.nbins; i++) {
+    _late_r2t_.values[i] =
+        _invert_t_2_r_(_late_r2t_.xmin + i * _late_r2t_.step, _t0_, _tcut_, true);
+  }
+  return;
+}
+
+double geiger_regime::base_t_2_r(double time_, int mode_) const {
+  DT_THROW_IF(time_ < 0.0, std::range_error, "Invalid drift time !");
   if (mode_ == 0) {
     if (time_ > _t0_) {
-      r = A2 * ut / (std::pow(ut, B2));
+      if (is_initialized() && time_ <= _tcut_) return _late_t2r_(time_);
+      return _compute_t_2_r_(time_, true);
     }
+    if (is_initialized()) return _prompt_t2r_(time_);
   }
-  r *= CLHEP::cm;
-  return r;
+  return _compute_t_2_r_(time_, false);
+}
+
+double geiger_regime::base_r_2_t(double radius_) const {
+  DT_THROW_IF(!is_initialized(), std::logic_error, "Not initialized !");
+  DT_THROW_IF(radius_ < 0.0, std::range_error, "Invalid drift radius !");
+  if (radius_ <= _prompt_r2t_.xmax) return _prompt_r2t_(radius_);
+  // No drift radius between the prompt and late regimes:
+  if (radius_ < _late_r2t_.xmin) return _t0_;
+  return _late_r2t_(radius_);
 }
 
 void geiger_regime::calibrate_drift_radius_from_drift_time(double drift_time_,
@@ -333,8 +396,46 @@ void geiger_regime::calibrate_drift_radius_from_drift_time(double drift_time_,
   return;
 }
 
+void geiger_regime::calibrate_drift_radii_from_drift_times(size_t nhits_,
+                                                           const double* drift_times_,
+                                                           double* drift_radii_,
+                                                           double* sigma_drift_radii_) const {
+  DT_THROW_IF(!is_initialized(), std::logic_error, "Not initialized !");
+  for (size_t i = 0; i < nhits_; i++) {
+    const double drift_time = drift_times_[i];
+    DT_THROW_IF(drift_time < 0.0, std::range_error,
+                "Invalid drift time (" << drift_time / CLHEP::ns << " ns) !");
+    if (drift_time < _tcut_) {
+      drift_radii_[i] = drift_time > _t0_ ? _late_t2r_(drift_time) : _prompt_t2r_(drift_time);
+    } else {
+      // Also catches invalid drift times:
+      datatools::invalidate(drift_radii_[i]);
+    }
+  }
+  // Same as get_sigma_r, an invalid radius giving an invalid error:
+  const double a = _sigma_r_a_ / CLHEP::mm;
+  const double b = _sigma_r_b_;
+  const double r0 = _sigma_r_r0_ / CLHEP::mm;
+  for (size_t i = 0; i < nhits_; i++) {
+    const double dr = drift_radii_[i] / CLHEP::mm - r0;
+    sigma_drift_radii_[i] = a * (1.0 + b * dr * dr) * CLHEP::mm;
+  }
+  return;
+}
+
 double geiger_regime::randomize_drift_time_from_drift_distance(mygsl::rng& ran_,
                                                                double drift_distance_) const {
+  return _randomize_drift_time_from_drift_distance_(ran_, drift_distance_);
+}
+
+double geiger_regime::randomize_drift_time_from_drift_distance(random_stream& ran_,
+                                                               double drift_distance_) const {
+  return _randomize_drift_time_from_drift_distance_(ran_, drift_distance_);
+}
+
+template <class Random>
+double geiger_regime::_randomize_drift_time_from_drift_distance_(Random& ran_,
+                                                                 double drift_distance_) const {
   DT_THROW_IF(!is_initialized(), std::logic_error, "Not initialized !");
   DT_THROW_IF(drift_distance_ < 0.0, std::range_error, "Invalid drift distance !");
   datatools::logger::priority local_priority = datatools::logger::PRIO_WARNING;
@@ -343,8 +444,8 @@ double geiger_regime::randomize_drift_time_from_drift_distance(mygsl::rng& ran_,
   datatools::invalidate(drift_time);
 
   if (drift_distance_ <= _rdiag_) {
-    const double rcut = _base_rt_.x_max();
-    const double tcut = _base_rt_(rcut);
+    const double rcut = _late_r2t_.xmax;
+    const double tcut = base_r_2_t(rcut);
 
     DT_LOG_TRACE(local_priority, "drift_distance_ = " << drift_distance_ << " "
                                                       << "rdiag = " << _rdiag_ << " "
@@ -356,15 +457,15 @@ double geiger_regime::randomize_drift_time_from_drift_distance(mygsl::rng& ran_,
       if (drift_distance_ > _r0_) sr = get_sigma_r(_r0_);
       double r_min = drift_distance_ - sr;
       if (r_min < 0.0) r_min = 0.0;
-      const double t_min = _base_rt_(r_min);
-      const double t_mean = _base_rt_(drift_distance_);
+      const double t_min = base_r_2_t(r_min);
+      const double t_mean = base_r_2_t(drift_distance_);
       const double mean_time = t_mean;
       const double sigma_time = (t_mean - t_min);
       drift_time = ran_.gaussian(mean_time, sigma_time);
       // protect against pathological times :
       if (drift_distance_ > _r0_) {
         const double sr0 = get_sigma_r(_r0_);
-        const double st0 = _t0_ - _base_rt_(_r0_ - sr0);
+        const double st0 = _t0_ - base_r_2_t(_r0_ - sr0);
         const double tinf = _t0_ - 2 * st0;
         if (drift_time < tinf) {
           drift_time = 2 * tinf - drift_time;
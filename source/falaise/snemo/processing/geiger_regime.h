@@ -27,6 +27,9 @@
 // - Bayeux/mygsl:
 #include <mygsl/tabulated_function.h>
 
+// This project:
+#include <falaise/snemo/processing/uniform_table.h>
+
 namespace datatools {
 class properties;
 }
@@ -39,6 +42,8 @@ namespace snemo {
 
 namespace processing {
 
+class random_stream;
+
 /// \brief Modelling of the Geiger regime of the SuperNEMO drift cell
 class geiger_regime : public datatools::i_tree_dumpable {
  public:
@@ -114,9 +119,19 @@ class geiger_regime : public datatools::i_tree_dumpable {
   /// Randomize the drift time from the drift distance of a Geiger hit
   double randomize_drift_time_from_drift_distance(mygsl::rng& ran_, double drift_distance_) const;
 
+  /// Randomize the drift time from the drift distance of a Geiger hit, with a counter-based
+  /// random stream
+  double randomize_drift_time_from_drift_distance(random_stream& ran_,
+                                                  double drift_distance_) const;
+
   /// Compute the drift radius from the drift time
+  ///
+  /// Once initialized, the mode 0 relation is interpolated from precomputed tables
   double base_t_2_r(double time_, int mode_ = 0) const;
 
+  /// Compute the drift time from the drift radius, inverse of the mode 0 base_t_2_r relation
+  double base_r_2_t(double radius_) const;
+
   /// Return the error on longitudinal position
   double get_sigma_z(double z_, size_t missing_cathodes_ = 0) const;
 
@@ -127,6 +142,15 @@ class geiger_regime : public datatools::i_tree_dumpable {
   void calibrate_drift_radius_from_drift_time(double drift_time_, double& drift_radius_,
                                               double& sigma_drift_radius_) const;
 
+  /// Calibrate the drift radii of many hits from their drift times
+  ///
+  /// Same as calibrate_drift_radius_from_drift_time for each hit, an invalid drift time
+  /// giving an invalid drift radius. The errors are computed in a separate loop free of
+  /// branches, which the compiler can vectorize.
+  void calibrate_drift_radii_from_drift_times(size_t nhits_, const double* drift_times_,
+                                              double* drift_radii_,
+                                              double* sigma_drift_radii_) const;
+
   /// Smart print
   virtual void tree_dump(std::ostream& a_out = std::clog, const std::string& a_title = "",
                          const std::string& a_indent = "", bool a_inherit = false) const;
@@ -159,9 +183,29 @@ class geiger_regime : public datatools::i_tree_dumpable {
   double _rdiag_;  //!< Cut on drift radius (not documented yet)
   double _tcut_;   //!< Cut on drift time (not documented yet)
 
+  // drift time <-> drift radius tables, split at t0 where the base relation is discontinuous:
+  uniform_table _prompt_t2r_;  //!< Drift radius from drift time in [0, t0]
+  uniform_table _late_t2r_;    //!< Drift radius from drift time in [t0, tcut]
+  uniform_table _prompt_r2t_;  //!< Drift time from drift radius in [0, r(t0-)]
+  uniform_table _late_r2t_;    //!< Drift time from drift radius in [r(t0+), r(tcut)]
+
  private:
   /// Set default values for attributes
   void _init_defaults_();
+
+  /// Compute the drift radius from the drift time with the fitted formula of the prompt
+  /// (before t0) or late (after t0) regime
+  double _compute_t_2_r_(double time_, bool late_) const;
+
+  /// Invert the fitted formula of a regime over a drift time range by bisection
+  double _invert_t_2_r_(double radius_, double tmin_, double tmax_, bool late_) const;
+
+  /// Build the drift time <-> drift radius tables
+  void _build_tables_();
+
+  /// Randomize the drift time from the drift distance with any random number generator
+  template <class Random>
+  double _randomize_drift_time_from_drift_distance_(Random& ran_, double drift_distance_) const;
 };
 
 }  // end of namespace processing
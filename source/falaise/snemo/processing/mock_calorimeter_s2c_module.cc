@@ -6,8 +6,10 @@
 #include <falaise/snemo/processing/mock_calorimeter_s2c_module.h>
 
 // Standard library:
+#include <algorithm>
 #include <sstream>
 #include <stdexcept>
+#include <unordered_map>
 
 // Third party:
 // - Bayeux/datatools:
@@ -22,6 +24,9 @@
 
 // This project :
 #include <falaise/snemo/datamodels/data_model.h>
+#include <falaise/snemo/datamodels/event_header.h>
+#include <falaise/snemo/geometry/channel_key.h>
+#include <falaise/snemo/processing/random_stream.h>
 #include <falaise/snemo/processing/services.h>
 
 namespace snemo {
@@ -52,6 +57,10 @@ const geomtools::manager& mock_calorimeter_s2c_module::get_geom_manager() const
 
 bool mock_calorimeter_s2c_module::has_external_random() const { return _external_random_ != 0; }
 
+bool mock_calorimeter_s2c_module::is_counter_based_random() const {
+  return _counter_based_random_;
+}
+
 void mock_calorimeter_s2c_module::reset_external_random() {
   DT_THROW_IF(is_initialized(), std::logic_error,
               "Module '" << get_name() << "' is already initialized ! ");
@@ -127,6 +136,29 @@ void mock_calorimeter_s2c_module::initialize(const datatools::properties& setup_
     _random_.init(random_id, random_seed);
   }
 
+  // Counter-based random streams, reproducible whatever the processing order of the events:
+  if (setup_.has_key("random.counter_based")) {
+    _counter_based_random_ = setup_.fetch_boolean("random.counter_based");
+  }
+  if (_counter_based_random_) {
+    DT_THROW_IF(has_external_random(), std::logic_error,
+                "Module '" << get_name() << "' cannot use both an external PRNG and "
+                           << "counter-based random streams !");
+    int random_seed = 12345;
+    if (setup_.has_key("random.seed")) {
+      random_seed = setup_.fetch_integer("random.seed");
+    }
+    _random_key_ = random_stream::make_key(random_seed, get_name() + ".calibration");
+    if (_EH_label_.empty()) {
+      if (setup_.has_key("EH_label")) {
+        _EH_label_ = setup_.fetch_string("EH_label");
+      }
+    }
+    if (_EH_label_.empty()) {
+      _EH_label_ = snemo::datamodel::data_info::default_event_header_label();
+    }
+  }
+
   // Get the calorimeter categories:
   if (setup_.has_key("hit_categories")) {
     setup_.fetch("hit_categories", _hit_categories_);
@@ -138,6 +170,11 @@ void mock_calorimeter_s2c_module::initialize(const datatools::properties& setup_
     _hit_categories_.push_back("gveto");
   }
 
+  // Get the alpha quenching:
+  if (setup_.has_key("alpha_quenching")) {
+    _alpha_quenching_ = setup_.fetch_boolean("alpha_quenching");
+  }
+
   // Initialize the calorimeter regime utility:
   for (std::vector<std::string>::const_iterator icategory = _hit_categories_.begin();
        icategory != _hit_categories_.end(); ++icategory) {
@@ -150,6 +187,10 @@ void mock_calorimeter_s2c_module::initialize(const datatools::properties& setup_
     a_regime.set_category(the_category);
     datatools::properties per_category_setup;
     setup_.export_and_rename_starting_with(per_category_setup, the_category + ".", "");
+    // The regimes only prepare the alpha quenching if the module uses it:
+    if (!per_category_setup.has_key("alpha_quenching")) {
+      per_category_setup.store_boolean("alpha_quenching", _alpha_quenching_);
+    }
     a_regime.initialize(per_category_setup);
     if (get_logging_priority() >= datatools::logger::PRIO_DEBUG) {
       DT_LOG_DEBUG(get_logging_priority(), "Calorimeter '" << the_category << "' parameters:");
@@ -175,11 +216,6 @@ void mock_calorimeter_s2c_module::initialize(const datatools::properties& setup_
     _store_mc_hit_id_ = true;
   }
 
-  // Get the alpha quenching:
-  if (setup_.has_key("alpha_quenching")) {
-    _alpha_quenching_ = setup_.fetch_boolean("alpha_quenching");
-  }
-
   this->base_module::_set_initialized(true);
   return;
 }
@@ -208,10 +244,14 @@ void mock_calorimeter_s2c_module::reset() {
 
 void mock_calorimeter_s2c_module::_set_defaults() {
   _external_random_ = 0;
+  _counter_based_random_ = false;
+  _random_key_ = 0;
+  _event_id_.reset();
   _geom_manager_ = 0;
   _SD_label_.clear();
   _CD_label_.clear();
   _Geo_label_.clear();
+  _EH_label_.clear();
   datatools::invalidate(_cluster_time_width_);
   _alpha_quenching_ = true;
   _store_mc_hit_id_ = false;
@@ -253,6 +293,14 @@ dpp::base_module::process_status mock_calorimeter_s2c_module::process(
   const mctools::simulated_data& the_simulated_data =
       event_record_.get<mctools::simulated_data>(_SD_label_);
 
+  // The counter-based random streams of the event are keyed by its run and event numbers:
+  if (_counter_based_random_) {
+    DT_THROW_IF(!event_record_.has(_EH_label_), std::logic_error,
+                "Missing event header '" << _EH_label_
+                                         << "' for the counter-based random streams !");
+    _event_id_ = event_record_.get<snemo::datamodel::event_header>(_EH_label_).get_id();
+  }
+
   // Check calibrated data *
   const bool abort_at_former_output = false;
   const bool preserve_former_output = false;
@@ -297,6 +345,24 @@ void mock_calorimeter_s2c_module::_process_calorimeter_digitization(
 
   uint32_t calibrated_calorimeter_hit_id = 0;
 
+  // Index of the last calorimeter hit of each block in the collection:
+  typedef std::unordered_map<snemo::geometry::channel_key, size_t> block_hit_dict_type;
+  block_hit_dict_type hits_by_block;
+  size_t nb_step_hits = 0;
+  for (std::vector<std::string>::const_iterator icategory = _hit_categories_.begin();
+       icategory != _hit_categories_.end(); ++icategory) {
+    if (simulated_data_.has_step_hits(*icategory)) {
+      nb_step_hits += simulated_data_.get_number_of_step_hits(*icategory);
+    }
+  }
+  hits_by_block.reserve(nb_step_hits + calibrated_calorimeter_hits_.size());
+  for (size_t i = 0; i < calibrated_calorimeter_hits_.size(); i++) {
+    const geomtools::geom_id& gid = calibrated_calorimeter_hits_[i].get().get_geom_id();
+    if (snemo::geometry::channel_key::can_pack(gid)) {
+      hits_by_block[snemo::geometry::channel_key(gid)] = i;
+    }
+  }
+
   // Loop over all 'calorimeter hit' categories:
   for (std::vector<std::string>::const_iterator icategory = _hit_categories_.begin();
        icategory != _hit_categories_.end(); ++icategory) {
@@ -337,17 +403,26 @@ void mock_calorimeter_s2c_module::_process_calorimeter_digitization(
       }
 
       // Find if some calorimeter hit already uses this geom ID :
-      geomtools::base_hit::has_geom_id_predicate pred_has_gid(gid);
-      // Wrapper predicates :
-      datatools::mother_to_daughter_predicate<geomtools::base_hit,
-                                              snemo::datamodel::calibrated_calorimeter_hit>
-          pred_M2D(pred_has_gid);
-      datatools::handle_predicate<snemo::datamodel::calibrated_calorimeter_hit> pred_via_handle(
-          pred_M2D);
-
       snemo::datamodel::calibrated_data::calorimeter_hit_collection_type::reverse_iterator found =
-          std::find_if(calibrated_calorimeter_hits_.rbegin(), calibrated_calorimeter_hits_.rend(),
-                       pred_via_handle);
+          calibrated_calorimeter_hits_.rend();
+      if (snemo::geometry::channel_key::can_pack(gid)) {
+        const block_hit_dict_type::const_iterator found_block =
+            hits_by_block.find(snemo::geometry::channel_key(gid));
+        if (found_block != hits_by_block.end()) {
+          found = calibrated_calorimeter_hits_.rbegin() +
+                  (calibrated_calorimeter_hits_.size() - 1 - found_block->second);
+        }
+      } else {
+        geomtools::base_hit::has_geom_id_predicate pred_has_gid(gid);
+        // Wrapper predicates :
+        datatools::mother_to_daughter_predicate<geomtools::base_hit,
+                                                snemo::datamodel::calibrated_calorimeter_hit>
+            pred_M2D(pred_has_gid);
+        datatools::handle_predicate<snemo::datamodel::calibrated_calorimeter_hit>
+            pred_via_handle(pred_M2D);
+        found = std::find_if(calibrated_calorimeter_hits_.rbegin(),
+                             calibrated_calorimeter_hits_.rend(), pred_via_handle);
+      }
 
       if (found == calibrated_calorimeter_hits_.rend()) {
         // This geom_id is not used by any previous calorimeter hit:
@@ -375,6 +450,10 @@ void mock_calorimeter_s2c_module::_process_calorimeter_digitization(
 
         // Append it to the collection :
         calibrated_calorimeter_hits_.push_back(new_handle);
+        if (snemo::geometry::channel_key::can_pack(gid)) {
+          const size_t new_hit_index = calibrated_calorimeter_hits_.size() - 1;
+          hits_by_block[snemo::geometry::channel_key(gid)] = new_hit_index;
+        }
       } else {
         // This geom_id is already used by some previous calorimeter hit:
         // we update this hit !
@@ -429,11 +508,16 @@ void mock_calorimeter_s2c_module::_process_calorimeter_calibration(
         calibrated_calorimeter_hits_) {
   DT_LOG_DEBUG(get_logging_priority(), "Entering...");
 
+  uint32_t ihit = 0;
   for (snemo::datamodel::calibrated_data::calorimeter_hit_collection_type::iterator icalo =
            calibrated_calorimeter_hits_.begin();
-       icalo != calibrated_calorimeter_hits_.end(); ++icalo) {
+       icalo != calibrated_calorimeter_hits_.end(); ++icalo, ++ihit) {
     snemo::datamodel::calibrated_calorimeter_hit& the_calo_cluster = icalo->grab();
 
+    // random stream of the hit, only used with counter-based random streams:
+    random_stream hit_random(_random_key_, _event_id_.get_run_number(),
+                             _event_id_.get_event_number(), ihit);
+
     // Setting category in order to get the correct energy resolution:
     // first recover the calorimeter category
     const std::string& category_name = the_calo_cluster.get_auxiliaries().fetch_string("category");
@@ -442,7 +526,9 @@ void mock_calorimeter_s2c_module::_process_calorimeter_calibration(
     // Compute a random 'experimental' energy taking into account
     // the expected energy resolution of the calorimeter hit:
     const double energy = the_calo_cluster.get_energy();
-    const double exp_energy = the_calo_regime.randomize_energy(_get_random(), energy);
+    const double exp_energy = _counter_based_random_
+                                  ? the_calo_regime.randomize_energy(hit_random, energy)
+                                  : the_calo_regime.randomize_energy(_get_random(), energy);
     const double exp_sigma_energy = the_calo_regime.get_sigma_energy(exp_energy);
     the_calo_cluster.set_energy(exp_energy);
     the_calo_cluster.set_sigma_energy(exp_sigma_energy);
@@ -450,7 +536,9 @@ void mock_calorimeter_s2c_module::_process_calorimeter_calibration(
     // Compute a random 'experimental' time taking into account
     // the expected time resolution of the calorimeter hit:
     const double time = the_calo_cluster.get_time();
-    const double exp_time = the_calo_regime.randomize_time(_get_random(), time, exp_energy);
+    const double exp_time =
+        _counter_based_random_ ? the_calo_regime.randomize_time(hit_random, time, exp_energy)
+                               : the_calo_regime.randomize_time(_get_random(), time, exp_energy);
     const double exp_sigma_time = the_calo_regime.get_sigma_time(exp_energy);
     the_calo_cluster.set_time(exp_time);
     the_calo_cluster.set_sigma_time(exp_sigma_time);
@@ -646,6 +734,47 @@ DOCD_CLASS_IMPLEMENT_LOAD_BEGIN(snemo::processing::mock_calorimeter_s2c_module,
             "                                       \n");
   }
 
+  {
+    // Description of the 'random.counter_based' configuration property :
+    datatools::configuration_property_description& cpd = ocd_.add_property_info();
+    cpd.set_name_pattern("random.counter_based")
+        .set_terse_description("Flag to use counter-based random streams")
+        .set_traits(datatools::TYPE_BOOLEAN)
+        .set_mandatory(false)
+        .set_long_description(
+            "The random numbers of a calorimeter hit are drawn from a     \n"
+            "Philox4x32-10 stream keyed by the seed, the module name, the \n"
+            "run and event numbers of the event header and the index of  \n"
+            "the hit, so that they do not depend on the processing order \n"
+            "of the events. The ``random.id`` property is then ignored.   \n"
+            "Default value: ``false``                                     \n")
+        .set_default_value_boolean(false)
+        .add_example(
+            "Use counter-based random streams::      \n"
+            "                                        \n"
+            "  random.counter_based : boolean = true \n"
+            "                                        \n");
+  }
+
+  {
+    // Description of the 'EH_label' configuration property :
+    datatools::configuration_property_description& cpd = ocd_.add_property_info();
+    cpd.set_name_pattern("EH_label")
+        .set_terse_description("The label/name of the 'event header' bank")
+        .set_traits(datatools::TYPE_STRING)
+        .set_mandatory(false)
+        .set_long_description(
+            "This is the name of the bank which provides the run and \n"
+            "event numbers of the counter-based random streams.      \n")
+        .set_triggered_by_flag("random.counter_based")
+        .set_default_value_string(snemo::datamodel::data_info::default_event_header_label())
+        .add_example(
+            "Use an alternative name for the 'event header' bank:: \n"
+            "                                \n"
+            "  EH_label : string = \"EH2\"   \n"
+            "                                \n");
+  }
+
   {
     // Description of the 'cluster_time_width' configuration property :
     datatools::configuration_property_description& cpd = ocd_.add_property_info();
@@ -749,6 +878,7 @@ DOCD_CLASS_IMPLEMENT_LOAD_BEGIN(snemo::processing::mock_calorimeter_s2c_module,
       "  Geo_label   : string = \"geometry\"                          \n"
       "  random.seed : integer = 314159                               \n"
       "  random.id   : string = \"taus2\"                             \n"
+      "  random.counter_based : boolean = false                       \n"
       "  cluster_time_width : real as time = 100 ns                   \n"
       "  alpha_quenching    : boolean = 1                             \n"
       "  store_mc_hit_id    : boolean = 0                             \n"
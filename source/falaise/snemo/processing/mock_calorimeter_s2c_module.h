@@ -23,6 +23,10 @@
 #include <vector>
 
 // Third party:
+// - Boost :
+#include <boost/cstdint.hpp>
+// - Bayeux/datatools:
+#include <datatools/event_id.h>
 // - Bayeux/mygsl:
 #include <mygsl/rng.h>
 // - Bayeux/dpp:
@@ -65,6 +69,9 @@ class mock_calorimeter_s2c_module : public dpp::base_module {
   /// Check if the module use an external PRNG
   bool has_external_random() const;
 
+  /// Check if the module use counter-based random streams
+  bool is_counter_based_random() const;
+
   /// Constructor
   mock_calorimeter_s2c_module(datatools::logger::priority = datatools::logger::PRIO_FATAL);
 
@@ -112,11 +119,15 @@ class mock_calorimeter_s2c_module : public dpp::base_module {
   const geomtools::manager* _geom_manager_;           //!< The geometry manager
   mygsl::rng _random_;                                //!< PRN generator
   mygsl::rng* _external_random_;                      //!< external PRN generator
+  bool _counter_based_random_;                        //!< Flag to use counter-based random streams
+  uint64_t _random_key_;                              //!< Key of the counter-based random streams
+  datatools::event_id _event_id_;                     //!< Run and event numbers of the event
   std::vector<std::string> _hit_categories_;          //!< Calorimeter hit categories
   calorimeter_regime_col_type _calorimeter_regimes_;  //!< Calorimeter regime tools
   std::string _SD_label_;                             //!< The label of the simulated data bank
   std::string _CD_label_;                             //!< The label of the calibrated data bank
   std::string _Geo_label_;                            //!< The label of the geometry service
+  std::string _EH_label_;                             //!< The label of the event header bank
   double _cluster_time_width_;                        //!< Time width of a calo cluster
   bool _alpha_quenching_;                             //!< Flag to (dis)activate the alpha quenching
   bool _store_mc_hit_id_;                             //!< The flag to reference MC true hit
@@ -6,8 +6,12 @@
 #include <falaise/snemo/processing/mock_tracker_s2c_module.h>
 
 // Standard library:
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <sstream>
 #include <stdexcept>
+#include <unordered_map>
 
 // Third party:
 // - Bayeux/datatools:
@@ -21,6 +25,9 @@
 
 // This project :
 #include <falaise/snemo/datamodels/data_model.h>
+#include <falaise/snemo/datamodels/event_header.h>
+#include <falaise/snemo/geometry/channel_key.h>
+#include <falaise/snemo/processing/random_stream.h>
 #include <falaise/snemo/processing/services.h>
 
 namespace snemo {
@@ -41,6 +48,8 @@ double mock_tracker_s2c_module::get_delayed_drift_time_threshold() const {
 
 bool mock_tracker_s2c_module::has_external_random() const { return _external_random_ != 0; }
 
+bool mock_tracker_s2c_module::is_counter_based_random() const { return _counter_based_random_; }
+
 void mock_tracker_s2c_module::reset_external_random() {
   DT_THROW_IF(is_initialized(), std::logic_error,
               "Module '" << get_name() << "' is already initialized ! ");
@@ -132,6 +141,20 @@ void mock_tracker_s2c_module::initialize(const datatools::properties& setup_,
     _module_category_ = "module";
   }
 
+  // Drift cell geometry category:
+  if (_cell_category_.empty()) {
+    if (setup_.has_key("cell_category")) {
+      _cell_category_ = setup_.fetch_string("cell_category");
+    }
+  }
+  // Default value:
+  if (_cell_category_.empty()) {
+    _cell_category_ = "drift_cell_core";
+  }
+
+  // Precompute the placements of the drift cells:
+  _cells_.initialize(*_geom_manager_, _cell_category_, _module_category_);
+
   // Hit category:
   if (_hit_category_.empty()) {
     if (setup_.has_key("hit_category")) {
@@ -156,6 +179,30 @@ void mock_tracker_s2c_module::initialize(const datatools::properties& setup_,
     _random_.init(random_id, random_seed);
   }
 
+  // Counter-based random streams, reproducible whatever the processing order of the events:
+  if (setup_.has_key("random.counter_based")) {
+    _counter_based_random_ = setup_.fetch_boolean("random.counter_based");
+  }
+  if (_counter_based_random_) {
+    DT_THROW_IF(has_external_random(), std::logic_error,
+                "Module '" << get_name() << "' cannot use both an external PRNG and "
+                           << "counter-based random streams !");
+    int random_seed = 12345;
+    if (setup_.has_key("random.seed")) {
+      random_seed = setup_.fetch_integer("random.seed");
+    }
+    _digitization_random_key_ = random_stream::make_key(random_seed, get_name() + ".digitization");
+    _calibration_random_key_ = random_stream::make_key(random_seed, get_name() + ".calibration");
+    if (_EH_label_.empty()) {
+      if (setup_.has_key("EH_label")) {
+        _EH_label_ = setup_.fetch_string("EH_label");
+      }
+    }
+    if (_EH_label_.empty()) {
+      _EH_label_ = snemo::datamodel::data_info::default_event_header_label();
+    }
+  }
+
   // Initialize the Geiger regime utility:
   _geiger_.initialize(setup_);
 
@@ -219,8 +266,10 @@ void mock_tracker_s2c_module::reset() {
   _external_random_ = 0;
   // Reset the Geiger regime utility:
   _geiger_.reset();
+  _cells_.reset();
   _set_defaults();
   _module_category_.clear();
+  _cell_category_.clear();
   _hit_category_.clear();
   _store_mc_hit_id_ = false;
   _store_mc_truth_track_ids_ = false;
@@ -229,12 +278,18 @@ void mock_tracker_s2c_module::reset() {
 
 void mock_tracker_s2c_module::_set_defaults() {
   _module_category_.clear();
+  _cell_category_.clear();
   _hit_category_.clear();
   _external_random_ = 0;
+  _counter_based_random_ = false;
+  _digitization_random_key_ = 0;
+  _calibration_random_key_ = 0;
+  _event_id_.reset();
   _geom_manager_ = 0;
   _SD_label_.clear();
   _CD_label_.clear();
   _Geo_label_.clear();
+  _EH_label_.clear();
   datatools::invalidate(_peripheral_drift_time_threshold_);
   datatools::invalidate(_delayed_drift_time_threshold_);
   _store_mc_hit_id_ = false;
@@ -276,6 +331,14 @@ dpp::base_module::process_status mock_tracker_s2c_module::process(
   const mctools::simulated_data& the_simulated_data =
       event_record_.get<mctools::simulated_data>(_SD_label_);
 
+  // The counter-based random streams of the event are keyed by its run and event numbers:
+  if (_counter_based_random_) {
+    DT_THROW_IF(!event_record_.has(_EH_label_), std::logic_error,
+                "Missing event header '" << _EH_label_
+                                         << "' for the counter-based random streams !");
+    _event_id_ = event_record_.get<snemo::datamodel::event_header>(_EH_label_).get_id();
+  }
+
   // Check calibrated data *
   const bool abort_at_former_output = false;
   const bool preserve_former_output = false;
@@ -336,6 +399,12 @@ void mock_tracker_s2c_module::_process_tracker_digitization(
 
   // Loop on Geiger step hits:
   const size_t nb_hits = simulated_data_.get_number_of_step_hits(_hit_category_);
+
+  // raw tracker hits already built, by cell:
+  typedef std::unordered_map<snemo::geometry::channel_key, raw_tracker_hit_col_type::iterator>
+      cell_hit_dict_type;
+  cell_hit_dict_type hits_by_cell;
+  hits_by_cell.reserve(std::min(nb_hits, _cells_.get_number_of_entries()));
   for (size_t ihit = 0; ihit < nb_hits; ++ihit) {
     // get a reference to the step hit
     // through the handle :
@@ -367,26 +436,35 @@ void mock_tracker_s2c_module::_process_tracker_digitization(
     // extract the corresponding geom ID:
     const geomtools::geom_id& gid = a_tracker_hit.get_geom_id();
 
-    // extract the geom info of the corresponding cell:
-    const geomtools::geom_info& ginfo = the_mapping.get_geom_info(gid);
-
     // the position of the ion/electron pair creation within the cell volume:
     const geomtools::vector_3d& ionization_world_pos = a_tracker_hit.get_position_start();
 
     // the position of the Geiger avalanche impact on the anode wire:
     const geomtools::vector_3d& avalanche_impact_world_pos = a_tracker_hit.get_position_stop();
 
-    // compute the position of the anode impact in the drift cell coordinates reference frame:
-    geomtools::vector_3d avalanche_impact_cell_pos;
-    ginfo.get_world_placement().mother_to_child(avalanche_impact_world_pos,
-                                                avalanche_impact_cell_pos);
-    // longitudinal position:
-    const double longitudinal_position = avalanche_impact_cell_pos.z();
+    // compute the longitudinal position of the anode impact in the drift cell coordinates
+    // reference frame:
+    double longitudinal_position;
+    const snemo::geometry::geom_info_table::entry* cell = _cells_.find(gid);
+    if (cell != 0) {
+      longitudinal_position = cell->world_to_local_z(avalanche_impact_world_pos);
+    } else {
+      // cell out of the precomputed table, use the geom info from the mapping:
+      const geomtools::geom_info& ginfo = the_mapping.get_geom_info(gid);
+      geomtools::vector_3d avalanche_impact_cell_pos;
+      ginfo.get_world_placement().mother_to_child(avalanche_impact_world_pos,
+                                                  avalanche_impact_cell_pos);
+      longitudinal_position = avalanche_impact_cell_pos.z();
+    }
+
+    // random stream of the step hit, only used with counter-based random streams:
+    random_stream hit_random(_digitization_random_key_, _event_id_.get_run_number(),
+                             _event_id_.get_event_number(), static_cast<uint32_t>(ihit));
 
     // true drift distance:
     const double drift_distance = (avalanche_impact_world_pos - ionization_world_pos).mag();
     const double anode_efficiency = _geiger_.get_anode_efficiency(drift_distance);
-    const double r = _get_random().uniform();
+    const double r = _counter_based_random_ ? hit_random.uniform() : _get_random().uniform();
     if (r > anode_efficiency) {
       // This hit is lost due to anode signal inefficiency:
       DT_LOG_DEBUG(get_logging_priority(), "Geiger cell efficiency below anode efficiency !");
@@ -399,7 +477,9 @@ void mock_tracker_s2c_module::_process_tracker_digitization(
     /*** Anode TDC ***/
     // randomize the expected Geiger drift time:
     const double expected_drift_time =
-        _geiger_.randomize_drift_time_from_drift_distance(_get_random(), drift_distance);
+        _counter_based_random_
+            ? _geiger_.randomize_drift_time_from_drift_distance(hit_random, drift_distance)
+            : _geiger_.randomize_drift_time_from_drift_distance(_get_random(), drift_distance);
     const double anode_time = ionization_time + expected_drift_time;
     const double sigma_anode_time = _geiger_.get_sigma_anode_time(anode_time);
 
@@ -411,30 +491,43 @@ void mock_tracker_s2c_module::_process_tracker_digitization(
     datatools::invalidate(top_cathode_time);
     const double sigma_cathode_time = _geiger_.get_sigma_cathode_time();
     size_t missing_cathodes = 2;
-    const double r1 = _get_random().uniform();
+    const double r1 = _counter_based_random_ ? hit_random.uniform() : _get_random().uniform();
     if (r1 < cathode_efficiency) {
       const double l_bottom = longitudinal_position + 0.5 * _geiger_.get_cell_length();
       const double mean_bottom_cathode_time = l_bottom / _geiger_.get_plasma_longitudinal_speed();
       const double sigma_bottom_cathode_time = 0.0;
       bottom_cathode_time =
-          _get_random().gaussian(mean_bottom_cathode_time, sigma_bottom_cathode_time);
+          _counter_based_random_
+              ? hit_random.gaussian(mean_bottom_cathode_time, sigma_bottom_cathode_time)
+              : _get_random().gaussian(mean_bottom_cathode_time, sigma_bottom_cathode_time);
       if (bottom_cathode_time < 0.0) bottom_cathode_time = 0.0;
       missing_cathodes--;
     }
-    const double r2 = _get_random().uniform();
+    const double r2 = _counter_based_random_ ? hit_random.uniform() : _get_random().uniform();
     if (r2 < cathode_efficiency) {
       const double l_top = 0.5 * _geiger_.get_cell_length() - longitudinal_position;
       const double mean_top_cathode_time = l_top / _geiger_.get_plasma_longitudinal_speed();
       const double sigma_top_cathode_time = 0.0;
-      top_cathode_time = _get_random().gaussian(mean_top_cathode_time, sigma_top_cathode_time);
+      top_cathode_time =
+          _counter_based_random_
+              ? hit_random.gaussian(mean_top_cathode_time, sigma_top_cathode_time)
+              : _get_random().gaussian(mean_top_cathode_time, sigma_top_cathode_time);
       if (top_cathode_time < 0.0) top_cathode_time = 0.0;
       missing_cathodes--;
     }
 
     // find if some tracker hit already uses this geom ID:
-    geomtools::base_hit::has_geom_id_predicate pred_has_gid(gid);
-    raw_tracker_hit_col_type::iterator found =
-        std::find_if(raw_tracker_hits_.begin(), raw_tracker_hits_.end(), pred_has_gid);
+    raw_tracker_hit_col_type::iterator found = raw_tracker_hits_.end();
+    cell_hit_dict_type::iterator found_cell = hits_by_cell.end();
+    if (snemo::geometry::channel_key::can_pack(gid)) {
+      found_cell = hits_by_cell.insert(std::make_pair(snemo::geometry::channel_key(gid),
+                                                      raw_tracker_hits_.end()))
+                       .first;
+      found = found_cell->second;
+    } else {
+      geomtools::base_hit::has_geom_id_predicate pred_has_gid(gid);
+      found = std::find_if(raw_tracker_hits_.begin(), raw_tracker_hits_.end(), pred_has_gid);
+    }
     if (found == raw_tracker_hits_.end()) {
       // This geom_id is not used by any previous tracker hit: we create a new tracker hit !
       {
@@ -442,6 +535,9 @@ void mock_tracker_s2c_module::_process_tracker_digitization(
         // add the new tracker hit in the list:
         raw_tracker_hits_.push_back(dummy);
       }
+      if (found_cell != hits_by_cell.end()) {
+        found_cell->second = --raw_tracker_hits_.end();
+      }
       snemo::datamodel::mock_raw_tracker_hit& new_raw_tracker_hit = raw_tracker_hits_.back();
 
       // assign a hit ID and the geometry ID to the hit:
@@ -523,13 +619,109 @@ void mock_tracker_s2c_module::_process_tracker_digitization(
   return;
 }
 
+void mock_tracker_s2c_module::calibration_buffers::resize(size_t nhits_) {
+  raw_hits.resize(nhits_);
+  cells.resize(nhits_);
+  anode_times.resize(nhits_);
+  bottom_times.resize(nhits_);
+  top_times.resize(nhits_);
+  prompt_times.resize(nhits_);
+  radii.resize(nhits_);
+  sigma_radii.resize(nhits_);
+  missing_cathodes.resize(nhits_);
+  z.resize(nhits_);
+  sigma_z.resize(nhits_);
+  deviates.resize(nhits_);
+  return;
+}
+
 /** Calibrate tracker hits from digitization informations:
+ *
+ *  All the hits of the event are calibrated together, in successive passes
+ *  over struct-of-arrays buffers: the arithmetic passes have no branch nor
+ *  call and can be vectorized, the random draws are done in a separate pass
+ *  in the order of the hits, or drawn in one batch from a counter-based
+ *  random stream, and the calibrated hits are built at the end.
  */
 void mock_tracker_s2c_module::_process_tracker_calibration(
     const mock_tracker_s2c_module::raw_tracker_hit_col_type& raw_tracker_hits_,
     snemo::datamodel::calibrated_data::tracker_hit_collection_type& calibrated_tracker_hits_) {
   DT_LOG_DEBUG(get_logging_priority(), "Entering...");
 
+  const size_t nhits = raw_tracker_hits_.size();
+  calibration_buffers& buffers = _calibration_buffers_;
+  buffers.resize(nhits);
+
+  // Gather the raw tracker hits:
+  size_t ihit = 0;
+  for (raw_tracker_hit_col_type::const_iterator i = raw_tracker_hits_.begin();
+       i != raw_tracker_hits_.end(); i++, ihit++) {
+    buffers.raw_hits[ihit] = &*i;
+    // precomputed placement of the corresponding cell:
+    buffers.cells[ihit] = _cells_.find(i->get_geom_id());
+    buffers.anode_times[ihit] = i->get_drift_time();
+    buffers.bottom_times[ihit] = i->get_bottom_time();
+    buffers.top_times[ihit] = i->get_top_time();
+  }
+
+  // Calibrate the transverse drift distance of the normal/prompt hits only, the radius of
+  // the delayed and noisy hits being invalid:
+  const double invalid_value = std::numeric_limits<double>::quiet_NaN();
+  const double delayed_threshold = _delayed_drift_time_threshold_;
+  for (size_t i = 0; i < nhits; i++) {
+    const double anode_time = buffers.anode_times[i];
+    buffers.prompt_times[i] = anode_time <= delayed_threshold ? anode_time : invalid_value;
+  }
+  _geiger_.calibrate_drift_radii_from_drift_times(nhits, buffers.prompt_times.data(),
+                                                  buffers.radii.data(),
+                                                  buffers.sigma_radii.data());
+
+  // Calibrate the longitudinal drift distance, from the available cathode signals:
+  const double cell_length = _geiger_.get_cell_length();
+  const double half_cell_length = 0.5 * cell_length;
+  const double plasma_propagation_speed = _geiger_.get_plasma_longitudinal_speed();
+  for (size_t i = 0; i < nhits; i++) {
+    const double t1 = buffers.bottom_times[i];
+    const double t2 = buffers.top_times[i];
+    const bool has_t1 = !std::isnan(t1);
+    const bool has_t2 = !std::isnan(t2);
+    // both cathode signals:
+    const double plasma_propagation_speed_2 = cell_length / (t1 + t2);
+    const double mean_z_both = half_cell_length - t2 * plasma_propagation_speed_2;
+    // missing bottom cathode signal:
+    const double mean_z_top = half_cell_length - t2 * plasma_propagation_speed;
+    // missing top cathode signal:
+    const double mean_z_bottom = t1 * plasma_propagation_speed - half_cell_length;
+    // missing top/bottom cathode signals, the hit is set at the middle of the cell:
+    buffers.z[i] = has_t1 ? (has_t2 ? mean_z_both : mean_z_bottom) : (has_t2 ? mean_z_top : 0.0);
+    buffers.missing_cathodes[i] = (has_t1 ? 0 : 1) + (has_t2 ? 0 : 1);
+  }
+
+  if (_counter_based_random_) {
+    // Randomize the longitudinal positions with a batch of deviates, the deviate of a hit
+    // only depending on the event and on the index of the hit:
+    for (size_t i = 0; i < nhits; i++) {
+      buffers.sigma_z[i] = _geiger_.get_sigma_z(buffers.z[i], buffers.missing_cathodes[i]);
+    }
+    random_stream event_random(_calibration_random_key_, _event_id_.get_run_number(),
+                               _event_id_.get_event_number(), 0);
+    event_random.fill_gaussian(nhits, buffers.deviates.data());
+    for (size_t i = 0; i < nhits; i++) {
+      const double random_z = buffers.z[i] + buffers.sigma_z[i] * buffers.deviates[i];
+      buffers.z[i] = buffers.missing_cathodes[i] < 2 ? random_z : buffers.z[i];
+    }
+  } else {
+    // Randomize the longitudinal positions, in the order of the hits:
+    for (size_t i = 0; i < nhits; i++) {
+      const size_t missing_cathodes = buffers.missing_cathodes[i];
+      const double mean_z = buffers.z[i];
+      buffers.sigma_z[i] = _geiger_.get_sigma_z(mean_z, missing_cathodes);
+      if (missing_cathodes < 2) {
+        buffers.z[i] = _geiger_.randomize_z(_get_random(), mean_z, buffers.sigma_z[i]);
+      }
+    }
+  }
+
   // pickup the ID mapping from the geometry manager:
   const geomtools::mapping& the_mapping = _geom_manager_->get_mapping();
   const geomtools::id_mgr& the_id_mgr = _geom_manager_->get_id_mgr();
@@ -539,12 +731,11 @@ void mock_tracker_s2c_module::_process_tracker_calibration(
   const geomtools::geom_info* module_ginfo = 0;
   const geomtools::placement* module_placement = 0;
 
-  int32_t calibrated_tracker_hit_id = 0;
-  // Loop on raw tracker hits:
-  for (raw_tracker_hit_col_type::const_iterator i = raw_tracker_hits_.begin();
-       i != raw_tracker_hits_.end(); i++) {
+  // Build the calibrated tracker hits:
+  calibrated_tracker_hits_.reserve(calibrated_tracker_hits_.size() + nhits);
+  for (size_t i = 0; i < nhits; i++) {
     // get a reference to the tracker hit:
-    const snemo::datamodel::mock_raw_tracker_hit& the_raw_tracker_hit = *i;
+    const snemo::datamodel::mock_raw_tracker_hit& the_raw_tracker_hit = *buffers.raw_hits[i];
 
     // create the calibrated tracker hit to build:
     snemo::datamodel::calibrated_data::tracker_hit_handle_type the_hit_handle(
@@ -553,39 +744,17 @@ void mock_tracker_s2c_module::_process_tracker_calibration(
 
     // extract the corresponding geom ID:
     const geomtools::geom_id& gid = the_raw_tracker_hit.get_geom_id();
-    // int this_cell_module_number = geom_manager_->get_id_mgr().get(gid, "module");
-    const int this_cell_module_number = gid.get(0);
-    if (this_cell_module_number != module_number) {
-      // build the module GID by extraction from the cell GID:
-      geomtools::geom_id module_gid;
-      the_id_mgr.make_id(_module_category_, module_gid);
-      the_id_mgr.extract(gid, module_gid);
-      module_number = this_cell_module_number;
-      module_ginfo = &the_mapping.get_geom_info(module_gid);
-      module_placement = &(module_ginfo->get_world_placement());
-    }
-
-    // extract the geom info of the corresponding cell:
-    const geomtools::geom_info& ginfo = the_mapping.get_geom_info(gid);
 
     // assign a hit ID and the geometry ID to the hit:
-    the_calibrated_tracker_hit.set_hit_id(calibrated_tracker_hit_id);
+    the_calibrated_tracker_hit.set_hit_id(static_cast<int32_t>(i));
     // the_raw_tracker_hit.get_hit_id());
     the_calibrated_tracker_hit.set_geom_id(gid);
 
     // Use the anode time :
-    const double anode_time = the_raw_tracker_hit.get_drift_time();
-
-    // Calibrate the transverse drift distance:
-    double radius;
-    double sigma_radius;
-    datatools::invalidate(radius);
-    datatools::invalidate(sigma_radius);
-
+    const double anode_time = buffers.anode_times[i];
     if (datatools::is_valid(anode_time)) {
       if (anode_time <= _delayed_drift_time_threshold_) {
         // Case of a normal/prompt hit :
-        _geiger_.calibrate_drift_radius_from_drift_time(anode_time, radius, sigma_radius);
         the_calibrated_tracker_hit.set_anode_time(anode_time);
         if (anode_time > _peripheral_drift_time_threshold_) {
           DT_LOG_TRACE(get_logging_priority(), "Peripheral Geiger hit with anode time = "
@@ -600,70 +769,57 @@ void mock_tracker_s2c_module::_process_tracker_calibration(
                                                     _geiger_.get_sigma_anode_time(anode_time));
         // Case of a delayed Geiger hit :
         // 2012-03-29 FM : do no push anymore specific values, let the radius be invalid
-
-        // radius       = _geiger_.get_r0();
-        // sigma_radius = _geiger_.get_sigma_r(radius);
       }
     } else {
       the_calibrated_tracker_hit.set_noisy(true);
       DT_LOG_DEBUG(get_logging_priority(), "Geiger cell is noisy");
     }
-    if (datatools::is_valid(radius)) the_calibrated_tracker_hit.set_r(radius);
-    if (datatools::is_valid(sigma_radius)) the_calibrated_tracker_hit.set_sigma_r(sigma_radius);
-
-    // Calibrate the longitudinal drift distance:
-    const double t1 = the_raw_tracker_hit.get_bottom_time();
-    const double t2 = the_raw_tracker_hit.get_top_time();
-    double z;
-    double sigma_z;
-    datatools::invalidate(z);
-    datatools::invalidate(sigma_z);
-
-    const double plasma_propagation_speed = _geiger_.get_plasma_longitudinal_speed();
-    size_t missing_cathodes = 0;
-    if (!datatools::is_valid(t1) && !datatools::is_valid(t2)) {
-      // missing top/bottom cathode signals:
-      missing_cathodes = 2;
-      sigma_z = _geiger_.get_sigma_z(z, missing_cathodes);
-      z = 0.0;
-      the_calibrated_tracker_hit.set_top_cathode_missing(true);
-      the_calibrated_tracker_hit.set_bottom_cathode_missing(true);
-    } else if (!datatools::is_valid(t1) && datatools::is_valid(t2)) {
-      // missing bottom cathode signal:
-      missing_cathodes = 1;
-      const double mean_z = 0.5 * _geiger_.get_cell_length() - t2 * plasma_propagation_speed;
-      sigma_z = _geiger_.get_sigma_z(mean_z, missing_cathodes);
-      z = _geiger_.randomize_z(_get_random(), mean_z, sigma_z);
-      the_calibrated_tracker_hit.set_bottom_cathode_missing(true);
-    } else if (datatools::is_valid(t1) && !datatools::is_valid(t2)) {
-      // missing top cathode signal:
-      missing_cathodes = 1;
-      const double mean_z = t1 * plasma_propagation_speed - 0.5 * _geiger_.get_cell_length();
-      sigma_z = _geiger_.get_sigma_z(mean_z, missing_cathodes);
-      z = _geiger_.randomize_z(_get_random(), mean_z, sigma_z);
-      the_calibrated_tracker_hit.set_top_cathode_missing(true);
-    } else {
-      missing_cathodes = 0;
-      const double plasma_propagation_speed_2 = _geiger_.get_cell_length() / (t1 + t2);
-      const double mean_z = 0.5 * _geiger_.get_cell_length() - t2 * plasma_propagation_speed_2;
-      sigma_z = _geiger_.get_sigma_z(mean_z, missing_cathodes);
-      z = _geiger_.randomize_z(_get_random(), mean_z, sigma_z);
+    if (datatools::is_valid(buffers.radii[i])) the_calibrated_tracker_hit.set_r(buffers.radii[i]);
+    if (datatools::is_valid(buffers.sigma_radii[i])) {
+      the_calibrated_tracker_hit.set_sigma_r(buffers.sigma_radii[i]);
     }
 
     // set values in the calibrated tracker hit:
-    if (datatools::is_valid(z)) the_calibrated_tracker_hit.set_z(z);
-    if (datatools::is_valid(sigma_z)) the_calibrated_tracker_hit.set_sigma_z(sigma_z);
+    if (!datatools::is_valid(buffers.bottom_times[i])) {
+      the_calibrated_tracker_hit.set_bottom_cathode_missing(true);
+    }
+    if (!datatools::is_valid(buffers.top_times[i])) {
+      the_calibrated_tracker_hit.set_top_cathode_missing(true);
+    }
+    if (datatools::is_valid(buffers.z[i])) the_calibrated_tracker_hit.set_z(buffers.z[i]);
+    if (datatools::is_valid(buffers.sigma_z[i])) {
+      the_calibrated_tracker_hit.set_sigma_z(buffers.sigma_z[i]);
+    }
 
     // store the X-Y position of the cell within the module coordinate system:
-    const double cell_x = 0.0;
-    const double cell_y = 0.0;
-    const double cell_z = 0.0;
-    geomtools::vector_3d cell_self_pos(cell_x, cell_y, cell_z);
-    geomtools::vector_3d cell_world_pos;
-    ginfo.get_world_placement().child_to_mother(cell_self_pos, cell_world_pos);
-    geomtools::vector_3d cell_module_pos;
-    module_placement->mother_to_child(cell_world_pos, cell_module_pos);
-    the_calibrated_tracker_hit.set_xy(cell_module_pos.getX(), cell_module_pos.getY());
+    const snemo::geometry::geom_info_table::entry* cell = buffers.cells[i];
+    if (cell != 0 && geomtools::is_valid(cell->module_position)) {
+      the_calibrated_tracker_hit.set_xy(cell->module_position.getX(),
+                                        cell->module_position.getY());
+    } else {
+      // cell out of the precomputed table, use the geom infos from the mapping:
+      // int this_cell_module_number = geom_manager_->get_id_mgr().get(gid, "module");
+      const int this_cell_module_number = gid.get(0);
+      if (this_cell_module_number != module_number) {
+        // build the module GID by extraction from the cell GID:
+        geomtools::geom_id module_gid;
+        the_id_mgr.make_id(_module_category_, module_gid);
+        the_id_mgr.extract(gid, module_gid);
+        module_number = this_cell_module_number;
+        module_ginfo = &the_mapping.get_geom_info(module_gid);
+        module_placement = &(module_ginfo->get_world_placement());
+      }
+      const geomtools::geom_info& ginfo = the_mapping.get_geom_info(gid);
+      const double cell_x = 0.0;
+      const double cell_y = 0.0;
+      const double cell_z = 0.0;
+      geomtools::vector_3d cell_self_pos(cell_x, cell_y, cell_z);
+      geomtools::vector_3d cell_world_pos;
+      ginfo.get_world_placement().child_to_mother(cell_self_pos, cell_world_pos);
+      geomtools::vector_3d cell_module_pos;
+      module_placement->mother_to_child(cell_world_pos, cell_module_pos);
+      the_calibrated_tracker_hit.set_xy(cell_module_pos.getX(), cell_module_pos.getY());
+    }
 
     // 2012-07-26 FM : suspend this for now :
     // if (the_raw_tracker_hit.has_hit_id())
@@ -685,7 +841,6 @@ void mock_tracker_s2c_module::_process_tracker_calibration(
     // save the calibrate tracker hit:
     calibrated_tracker_hits_.push_back(the_hit_handle);
 
-    calibrated_tracker_hit_id++;
   }  // loop over raw tracker hits
 
   DT_LOG_DEBUG(get_logging_priority(), "Exiting.");
@@ -827,6 +982,47 @@ DOCD_CLASS_IMPLEMENT_LOAD_BEGIN(snemo::processing::mock_tracker_s2c_module, ocd_
             "                                       \n");
   }
 
+  {
+    // Description of the 'random.counter_based' configuration property :
+    datatools::configuration_property_description& cpd = ocd_.add_property_info();
+    cpd.set_name_pattern("random.counter_based")
+        .set_terse_description("Flag to use counter-based random streams")
+        .set_traits(datatools::TYPE_BOOLEAN)
+        .set_mandatory(false)
+        .set_long_description(
+            "The random numbers of a hit are drawn from a Philox4x32-10   \n"
+            "stream keyed by the seed, the module name, the run and event \n"
+            "numbers of the event header and the index of the hit, so    \n"
+            "that they do not depend on the processing order of the      \n"
+            "events. The ``random.id`` property is then ignored.          \n"
+            "Default value: ``false``                                     \n")
+        .set_default_value_boolean(false)
+        .add_example(
+            "Use counter-based random streams::      \n"
+            "                                        \n"
+            "  random.counter_based : boolean = true \n"
+            "                                        \n");
+  }
+
+  {
+    // Description of the 'EH_label' configuration property :
+    datatools::configuration_property_description& cpd = ocd_.add_property_info();
+    cpd.set_name_pattern("EH_label")
+        .set_terse_description("The label/name of the 'event header' bank")
+        .set_traits(datatools::TYPE_STRING)
+        .set_mandatory(false)
+        .set_long_description(
+            "This is the name of the bank which provides the run and \n"
+            "event numbers of the counter-based random streams.      \n")
+        .set_triggered_by_flag("random.counter_based")
+        .set_default_value_string(snemo::datamodel::data_info::default_event_header_label())
+        .add_example(
+            "Use an alternative name for the 'event header' bank:: \n"
+            "                                \n"
+            "  EH_label : string = \"EH2\"   \n"
+            "                                \n");
+  }
+
   {
     // Description of the 'module_category' configuration property :
     datatools::configuration_property_description& cpd = ocd_.add_property_info();
@@ -948,7 +1144,9 @@ DOCD_CLASS_IMPLEMENT_LOAD_BEGIN(snemo::processing::mock_tracker_s2c_module, ocd_
       "  Geo_label       : string = \"geometry\"                    \n"
       "  random.seed     : integer = 314159                         \n"
       "  random.id       : string = \"taus2\"                       \n"
+      "  random.counter_based : boolean = false                     \n"
       "  module_category : string = \"module\"                      \n"
+      "  cell_category   : string = \"drift_cell_core\"             \n"
       "  peripheral_drift_time_threshold : real = 4.0 us            \n"
       "  delayed_drift_time_threshold    : real = 10.0 us           \n"
       "  store_mc_hit_id  : boolean = 0                             \n"
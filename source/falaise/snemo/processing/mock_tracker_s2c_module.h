@@ -23,6 +23,10 @@
 #include <vector>
 
 // Third party:
+// - Boost :
+#include <boost/cstdint.hpp>
+// - Bayeux/datatools:
+#include <datatools/event_id.h>
 // - Bayeux/mygsl:
 #include <mygsl/rng.h>
 // - Bayeux/dpp:
@@ -31,6 +35,7 @@
 // This project :
 #include <falaise/snemo/datamodels/calibrated_data.h>
 #include <falaise/snemo/datamodels/mock_raw_tracker_hit.h>
+#include <falaise/snemo/geometry/geom_info_table.h>
 #include <falaise/snemo/processing/geiger_regime.h>
 
 namespace geomtools {
@@ -67,6 +72,9 @@ class mock_tracker_s2c_module : public dpp::base_module {
   /// Check if the module use an external PRNG
   bool has_external_random() const;
 
+  /// Check if the module use counter-based random streams
+  bool is_counter_based_random() const;
+
   /// Return the drift time threshold for peripheral Geiger hits (far from the anode wire)
   double get_peripheral_drift_time_threshold() const;
 
@@ -111,21 +119,51 @@ class mock_tracker_s2c_module : public dpp::base_module {
       const mctools::simulated_data& simulated_data_,
       snemo::datamodel::calibrated_data::tracker_hit_collection_type& calibrated_tracker_hits_);
 
+ private:
+  /// \brief Struct-of-arrays buffers for the calibration of the tracker hits of an event
+  struct calibration_buffers {
+    /// Resize all the buffers
+    void resize(size_t nhits_);
+
+    /// Raw hits
+    std::vector<const snemo::datamodel::mock_raw_tracker_hit*> raw_hits;
+    /// Precomputed placements of the cells
+    std::vector<const snemo::geometry::geom_info_table::entry*> cells;
+    std::vector<double> anode_times;       //!< Anode drift times
+    std::vector<double> bottom_times;      //!< Bottom cathode times
+    std::vector<double> top_times;         //!< Top cathode times
+    std::vector<double> prompt_times;      //!< Anode times of the prompt hits only
+    std::vector<double> radii;             //!< Calibrated drift radii
+    std::vector<double> sigma_radii;       //!< Errors on the drift radii
+    std::vector<size_t> missing_cathodes;  //!< Numbers of missing cathode signals
+    std::vector<double> z;                 //!< Calibrated longitudinal positions
+    std::vector<double> sigma_z;           //!< Errors on the longitudinal positions
+    std::vector<double> deviates;          //!< Standard gaussian deviates
+  };
+
  private:
   const geomtools::manager* _geom_manager_;  //!< The geometry manager
   std::string _module_category_;             //!< The geometry category of the SuperNEMO module
   std::string _hit_category_;                //!< The category of the input Geiger hits
+  std::string _cell_category_;               //!< The geometry category of the drift cells
+  snemo::geometry::geom_info_table _cells_;  //!< Precomputed placements of the drift cells
   geiger_regime _geiger_;                    //!< Geiger regime tools
   mygsl::rng _random_;                       //!< internal PRN generator
   mygsl::rng* _external_random_;             //!< external PRN generator
+  bool _counter_based_random_;               //!< Flag to use counter-based random streams
+  uint64_t _digitization_random_key_;        //!< Key of the random streams of the digitization
+  uint64_t _calibration_random_key_;         //!< Key of the random streams of the calibration
+  datatools::event_id _event_id_;            //!< Run and event numbers of the current event
   double _peripheral_drift_time_threshold_;  //!< Peripheral drift time threshold
   double _delayed_drift_time_threshold_;     //!< Delayed drift time threshold
   std::string _SD_label_;                    //!< The label of the simulated data bank
   std::string _CD_label_;                    //!< The label of the calibrated data bank
   std::string _Geo_label_;                   //!< The label of the geometry service
+  std::string _EH_label_;                    //!< The label of the event header bank
   bool _store_mc_hit_id_;                    //!< Flag to store the MC true hit ID
   bool _store_mc_truth_track_ids_;  //!< The flag to reference the MC engine track and parent track
                                     //!< IDs associated to this calibrated Geiger hit
+  calibration_buffers _calibration_buffers_;  //!< Buffers reused by the calibration of events
 
   // Macro to automate the registration of the module :
   DPP_MODULE_REGISTRATION_INTERFACE(mock_tracker_s2c_module)
@@ -0,0 +1,172 @@
+// falaise/snemo/processing/random_stream.cc
+
+// Ourselves:
+#include <falaise/snemo/processing/random_stream.h>
+
+// Standard library:
+#include <cmath>
+
+namespace snemo {
+
+namespace processing {
+
+namespace {
+
+// Multipliers and key increments (Weyl sequence) of the Philox4x32 rounds:
+const uint32_t PHILOX_M0 = 0xD2511F53;
+const uint32_t PHILOX_M1 = 0xCD9E8D57;
+const uint32_t PHILOX_W0 = 0x9E3779B9;
+const uint32_t PHILOX_W1 = 0xBB67AE85;
+
+/// Number of rounds of the Philox4x32-10 function
+const unsigned int PHILOX_ROUNDS = 10;
+
+/// Return the uniform deviate in ]0, 1[ made of the 52 leading bits of two random words
+inline double to_uniform(uint32_t high_, uint32_t low_) {
+  const uint64_t bits = (static_cast<uint64_t>(high_) << 20) | (low_ >> 12);
+  return (bits + 0.5) * (1.0 / 4503599627370496.0);  // 2^-52
+}
+
+}  // namespace
+
+void philox4x32::generate(const uint32_t counter_[4], const uint32_t key_[2],
+                          uint32_t values_[4]) {
+  uint32_t c0 = counter_[0];
+  uint32_t c1 = counter_[1];
+  uint32_t c2 = counter_[2];
+  uint32_t c3 = counter_[3];
+  uint32_t k0 = key_[0];
+  uint32_t k1 = key_[1];
+  for (unsigned int round = 0; round < PHILOX_ROUNDS; round++) {
+    if (round != 0) {
+      k0 += PHILOX_W0;
+      k1 += PHILOX_W1;
+    }
+    const uint64_t p0 = static_cast<uint64_t>(PHILOX_M0) * c0;
+    const uint64_t p1 = static_cast<uint64_t>(PHILOX_M1) * c2;
+    const uint32_t hi0 = static_cast<uint32_t>(p0 >> 32);
+    const uint32_t lo0 = static_cast<uint32_t>(p0);
+    const uint32_t hi1 = static_cast<uint32_t>(p1 >> 32);
+    const uint32_t lo1 = static_cast<uint32_t>(p1);
+    c0 = hi1 ^ c1 ^ k0;
+    c1 = lo1;
+    c2 = hi0 ^ c3 ^ k1;
+    c3 = lo0;
+  }
+  values_[0] = c0;
+  values_[1] = c1;
+  values_[2] = c2;
+  values_[3] = c3;
+  return;
+}
+
+// static
+uint64_t random_stream::make_key(uint32_t seed_, const std::string& stage_) {
+  // 32 bits FNV-1a hash of the stage name:
+  uint32_t hash = 2166136261U;
+  for (size_t i = 0; i < stage_.size(); i++) {
+    hash ^= static_cast<unsigned char>(stage_[i]);
+    hash *= 16777619U;
+  }
+  return (static_cast<uint64_t>(seed_) << 32) | hash;
+}
+
+random_stream::random_stream(uint64_t key_, int32_t run_, int32_t event_, uint32_t hit_) {
+  _key_[0] = static_cast<uint32_t>(key_);
+  _key_[1] = static_cast<uint32_t>(key_ >> 32);
+  _counter_[0] = static_cast<uint32_t>(run_);
+  _counter_[1] = static_cast<uint32_t>(event_);
+  _counter_[2] = hit_;
+  _counter_[3] = 0;
+  for (size_t i = 0; i < 4; i++) {
+    _block_[i] = 0;
+  }
+  _next_uniform_ = 2;
+  _has_spare_ = false;
+  _spare_gaussian_ = 0.0;
+}
+
+void random_stream::_next_block_() {
+  philox4x32::generate(_counter_, _key_, _block_);
+  _counter_[3]++;
+  _next_uniform_ = 0;
+  return;
+}
+
+double random_stream::uniform() {
+  if (_next_uniform_ == 2) {
+    _next_block_();
+  }
+  const uint32_t* words = _block_ + 2 * _next_uniform_;
+  _next_uniform_++;
+  return to_uniform(words[0], words[1]);
+}
+
+double random_stream::flat(double min_, double max_) { return min_ + (max_ - min_) * uniform(); }
+
+double random_stream::_standard_gaussian_() {
+  if (_has_spare_) {
+    _has_spare_ = false;
+    return _spare_gaussian_;
+  }
+  // Box-Muller transform:
+  const double u1 = uniform();
+  const double u2 = uniform();
+  const double r = std::sqrt(-2.0 * std::log(u1));
+  const double phi = 2.0 * M_PI * u2;
+  _spare_gaussian_ = r * std::sin(phi);
+  _has_spare_ = true;
+  return r * std::cos(phi);
+}
+
+double random_stream::gaussian(double mean_, double sigma_) {
+  return mean_ + sigma_ * _standard_gaussian_();
+}
+
+void random_stream::fill_uniform(size_t n_, double* values_) {
+  size_t i = 0;
+  // End of the current block:
+  for (; i < n_ && _next_uniform_ != 2; i++) {
+    values_[i] = uniform();
+  }
+  // Whole blocks:
+  uint32_t words[4];
+  for (; i + 2 <= n_; i += 2) {
+    philox4x32::generate(_counter_, _key_, words);
+    _counter_[3]++;
+    values_[i] = to_uniform(words[0], words[1]);
+    values_[i + 1] = to_uniform(words[2], words[3]);
+  }
+  // Last deviate:
+  for (; i < n_; i++) {
+    values_[i] = uniform();
+  }
+  return;
+}
+
+void random_stream::fill_gaussian(size_t n_, double* values_) {
+  size_t i = 0;
+  if (i < n_ && _has_spare_) {
+    values_[i++] = _standard_gaussian_();
+  }
+  // Whole blocks, when the stream is at a block boundary:
+  if (_next_uniform_ == 2) {
+    uint32_t words[4];
+    for (; i + 2 <= n_; i += 2) {
+      philox4x32::generate(_counter_, _key_, words);
+      _counter_[3]++;
+      const double r = std::sqrt(-2.0 * std::log(to_uniform(words[0], words[1])));
+      const double phi = 2.0 * M_PI * to_uniform(words[2], words[3]);
+      values_[i] = r * std::cos(phi);
+      values_[i + 1] = r * std::sin(phi);
+    }
+  }
+  for (; i < n_; i++) {
+    values_[i] = _standard_gaussian_();
+  }
+  return;
+}
+
+}  // end of namespace processing
+
+}  // end of namespace snemo
@@ -0,0 +1,118 @@
+/// \file falaise/snemo/processing/random_stream.h
+/* Creation date: 2026-10-18
+ * Last modified: 2026-10-18
+ *
+ * License:
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public  License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Description:
+ *
+ *   Counter-based reproducible random streams for the processing modules
+ *
+ * History:
+ *
+ */
+
+#ifndef FALAISE_SNEMO_PROCESSING_RANDOM_STREAM_H
+#define FALAISE_SNEMO_PROCESSING_RANDOM_STREAM_H 1
+
+// Standard library:
+#include <cstddef>
+#include <string>
+
+// Third party:
+// - Boost :
+#include <boost/cstdint.hpp>
+
+namespace snemo {
+
+namespace processing {
+
+/// \brief The Philox4x32-10 counter-based pseudo-random function
+///
+/// J. K. Salmon et al., "Parallel random numbers: as easy as 1, 2, 3",
+/// SC'11, doi:10.1145/2063384.2063405
+struct philox4x32 {
+  /// Compute the 4 random words of a 128 bits counter with a 64 bits key
+  static void generate(const uint32_t counter_[4], const uint32_t key_[2], uint32_t values_[4]);
+};
+
+/** \brief Reproducible stream of random numbers for a hit of an event
+ *
+ *  The numbers of a stream are the Philox4x32-10 function of a counter
+ *  made of the run number, the event number, the hit index and the index
+ *  of the drawn block, encrypted with a key made of a seed and of a
+ *  processing stage identifier. They only depend on these values, and not
+ *  on the order in which the events and the hits are processed, nor on the
+ *  thread that processes them.
+ *
+ *  The interface follows the one of mygsl::rng for the distributions used
+ *  by the processing modules. Each block of 128 bits gives two uniform
+ *  deviates with 52 bits of precision, or two gaussian deviates through
+ *  the Box-Muller transform. The fill methods draw whole arrays with the
+ *  same result as successive scalar draws.
+ */
+class random_stream {
+ public:
+  /// Build the key of the streams of a processing stage from a seed and a stage name
+  static uint64_t make_key(uint32_t seed_, const std::string& stage_);
+
+  /// Constructor
+  random_stream(uint64_t key_, int32_t run_, int32_t event_, uint32_t hit_);
+
+  /// Return a uniform deviate in ]0, 1[
+  double uniform();
+
+  /// Return a uniform deviate in ]min_, max_[
+  double flat(double min_, double max_);
+
+  /// Return a gaussian deviate
+  double gaussian(double mean_, double sigma_);
+
+  /// Fill an array with uniform deviates in ]0, 1[
+  void fill_uniform(size_t n_, double* values_);
+
+  /// Fill an array with standard gaussian deviates
+  void fill_gaussian(size_t n_, double* values_);
+
+ private:
+  /// Draw the next block of random words
+  void _next_block_();
+
+  /// Return a standard gaussian deviate
+  double _standard_gaussian_();
+
+ private:
+  uint32_t _key_[2];        //!< Key of the stream
+  uint32_t _counter_[4];    //!< Counter of the next block
+  uint32_t _block_[4];      //!< Random words of the current block
+  size_t _next_uniform_;    //!< Index of the next uniform deviate of the block (0, 1 or 2)
+  bool _has_spare_;         //!< Flag for a spare gaussian deviate
+  double _spare_gaussian_;  //!< Second gaussian deviate of the last Box-Muller transform
+};
+
+}  // end of namespace processing
+
+}  // end of namespace snemo
+
+#endif  // FALAISE_SNEMO_PROCESSING_RANDOM_STREAM_H
+
+// Local Variables: --
+// mode: c++ --
+// c-file-style: "gnu" --
+// tab-width: 2 --
+// End: --
@@ -0,0 +1,43 @@
+// falaise/snemo/processing/uniform_table.cc
+
+// Ourselves:
+#include <falaise/snemo/processing/uniform_table.h>
+
+// Standard library:
+#include <stdexcept>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+#include <datatools/utils.h>
+
+namespace snemo {
+
+namespace processing {
+
+uniform_table::uniform_table() { reset(); }
+
+void uniform_table::build(double xmin_, double xmax_, size_t nbins_) {
+  DT_THROW_IF(!(xmax_ > xmin_) || nbins_ == 0, std::range_error, "Invalid table binning !");
+  xmin = xmin_;
+  xmax = xmax_;
+  nbins = nbins_;
+  step = (xmax - xmin) / nbins;
+  inv_step = 1.0 / step;
+  values.assign(nbins + 1, 0.0);
+  return;
+}
+
+void uniform_table::reset() {
+  datatools::invalidate(xmin);
+  datatools::invalidate(xmax);
+  datatools::invalidate(step);
+  datatools::invalidate(inv_step);
+  nbins = 0;
+  values.clear();
+  return;
+}
+
+}  // end of namespace processing
+
+}  // end of namespace snemo
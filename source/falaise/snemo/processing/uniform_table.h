@@ -0,0 +1,95 @@
+/// \file falaise/snemo/processing/uniform_table.h
+/* Creation date: 2026-10-18
+ * Last modified: 2026-10-18
+ *
+ * License:
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public  License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Description:
+ *
+ *   Uniformly binned table of a function of one variable
+ *
+ * History:
+ *
+ */
+
+#ifndef FALAISE_SNEMO_PROCESSING_UNIFORM_TABLE_H
+#define FALAISE_SNEMO_PROCESSING_UNIFORM_TABLE_H 1
+
+// Standard library:
+#include <cstddef>
+#include <vector>
+
+namespace snemo {
+
+namespace processing {
+
+/** \brief Uniformly binned table of a function, linearly interpolated
+ *
+ *  The table is filled by the user at the nbins + 1 nodes xmin + i * step
+ *  after a call to build(). The interpolation needs no search and is meant
+ *  to replace the evaluation of costly analytic models in the per hit loops
+ *  of the processing modules.
+ */
+struct uniform_table {
+  /// Default constructor
+  uniform_table();
+
+  /// Build the table with a given number of bins over [xmin_, xmax_]
+  void build(double xmin_, double xmax_, size_t nbins_);
+
+  /// Reset
+  void reset();
+
+  /// Check if the table is built
+  bool is_built() const { return nbins != 0; }
+
+  /// Return the abscissa of a node
+  double node(size_t i_) const { return xmin + i_ * step; }
+
+  /// Check if a value lies in the range of the table
+  bool contains(double x_) const { return x_ >= xmin && x_ <= xmax; }
+
+  /// Return the interpolated value, clamped at the bounds of the table
+  double operator()(double x_) const {
+    double u = (x_ - xmin) * inv_step;
+    if (u < 0.0) u = 0.0;
+    size_t i = static_cast<size_t>(u);
+    if (i >= nbins) i = nbins - 1;
+    if (u > nbins) u = nbins;
+    return values[i] + (u - i) * (values[i + 1] - values[i]);
+  }
+
+  double xmin;                 //!< Lower bound
+  double xmax;                 //!< Upper bound
+  double step;                 //!< Bin width
+  double inv_step;             //!< Inverse of the bin width
+  size_t nbins;                //!< Number of bins
+  std::vector<double> values;  //!< Values at the nbins + 1 nodes
+};
+
+}  // end of namespace processing
+
+}  // end of namespace snemo
+
+#endif  // FALAISE_SNEMO_PROCESSING_UNIFORM_TABLE_H
+
+// Local Variables: --
+// mode: c++ --
+// c-file-style: "gnu" --
+// tab-width: 2 --
+// End: --
@@ -19,6 +19,27 @@ MCTOOLS_STEP_HIT_PROCESSOR_REGISTRATION_IMPLEMENT(
 bool calorimeter_step_hit_processor::locate_calorimeter_block(const geomtools::vector_3d& position_,
                                                               geomtools::geom_id& gid_) const {
   bool located = false;
+  if (_locator_plugin_->has_detector_index()) {
+    // The index points to the block whose box, widened by its tolerance, contains the step.
+    // Only the locator of this block type checks that the step really is inside it:
+    switch (_locator_plugin_->get_detector_index().find_element(position_, gid_)) {
+      case snemo::geometry::detector_index::ELEMENT_CALO_BLOCK:
+        located = _locator_plugin_->get_calo_locator().find_block_geom_id(position_, gid_);
+        break;
+      case snemo::geometry::detector_index::ELEMENT_XCALO_BLOCK:
+        located = _locator_plugin_->get_xcalo_locator().find_block_geom_id(position_, gid_);
+        break;
+      case snemo::geometry::detector_index::ELEMENT_GVETO_BLOCK:
+        located = _locator_plugin_->get_gveto_locator().find_block_geom_id(position_, gid_);
+        break;
+      default:
+        break;
+    }
+    if (located) {
+      DT_LOG_TRACE(get_logging_priority(), "Found step with the detector index.");
+    }
+  }
+  // Otherwise, the step is on a boundary or out of the indexed blocks:
   if (!located) {
     if (_locator_plugin_->get_calo_locator().find_block_geom_id(position_, gid_)) {
       DT_LOG_TRACE(get_logging_priority(), "Found step with the main wall calorimeter locator.");
@@ -26,6 +26,7 @@
 #include <fstream>
 #include <iostream>
 #include <list>
+#include <stdexcept>
 #include <string>
 
 // Third party:
@@ -306,6 +307,24 @@ void test5(geomtools::manager& a_mgr) {
       }
       clog << endl << endl;
     }
+
+    {
+      // Precomputed world placements must match the module positions:
+      for (uint32_t column = 0; column < CL.get_number_of_columns(side); column++) {
+        for (uint32_t row = 0; row < CL.get_number_of_rows(side); row++) {
+          if (CL.get_block_index(side, column, row) >= CL.get_number_of_blocks()) {
+            throw std::logic_error("test5: Invalid block index !");
+          }
+          geomtools::vector_3d world_position;
+          CL.transform_module_to_world(CL.get_block_position(side, column, row), world_position);
+          const geomtools::placement& world_placement =
+              CL.get_block_world_placement(side, column, row);
+          if ((world_placement.get_translation() - world_position).mag() > 1.0e-3 * CLHEP::mm) {
+            throw std::logic_error("test5: Block world placement does not match its position !");
+          }
+        }
+      }
+    }
   }
 
   return;
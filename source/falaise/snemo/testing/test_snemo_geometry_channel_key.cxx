@@ -0,0 +1,91 @@
+// test_snemo_geometry_channel_key.cxx
+
+// Standard library:
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+// - Bayeux/geomtools:
+#include <geomtools/geom_id.h>
+
+// This project:
+#include <falaise/snemo/geometry/channel_key.h>
+
+int main(/* int argc_, char ** argv_ */) {
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for class 'snemo::geometry::channel_key'!" << std::endl;
+
+    namespace sg = snemo::geometry;
+
+    // Drift cell (type, module, side, layer, row):
+    const geomtools::geom_id cell_gid(1204, 0, 1, 8, 112);
+    const sg::channel_key cell_key(cell_gid);
+    std::clog << "Cell key: " << cell_key << " = " << std::hex << cell_key.get_value() << std::dec
+              << std::endl;
+    DT_THROW_IF(!cell_key.is_valid(), std::logic_error, "Check failed: cell key is valid");
+    DT_THROW_IF(cell_key.get_type() != 1204, std::logic_error, "Check failed: cell key type");
+    DT_THROW_IF(cell_key.get_depth() != 4, std::logic_error, "Check failed: cell key depth");
+    DT_THROW_IF(cell_key.get(3) != 112, std::logic_error, "Check failed: cell key row");
+    DT_THROW_IF(cell_key.to_geom_id() != cell_gid, std::logic_error,
+                "Check failed: cell key round trip");
+    DT_THROW_IF(cell_key != sg::channel_key(1204, {0, 1, 8, 112}), std::logic_error,
+                "Check failed: cell key from address");
+
+    // Calorimeter block (type, module, side, column, row, part) with any part:
+    const geomtools::geom_id calo_gid(1302, 0, 0, 19, 12, geomtools::geom_id::ANY_ADDRESS);
+    const sg::channel_key calo_key(calo_gid);
+    std::clog << "Calorimeter key: " << calo_key << std::endl;
+    DT_THROW_IF(calo_key.get(4) != geomtools::geom_id::ANY_ADDRESS, std::logic_error,
+                "Check failed: calorimeter key any part");
+    DT_THROW_IF(calo_key.to_geom_id() != calo_gid, std::logic_error,
+                "Check failed: calorimeter key round trip");
+    DT_THROW_IF(calo_key == cell_key, std::logic_error, "Check failed: different keys");
+    DT_THROW_IF(!(cell_key < calo_key), std::logic_error, "Check failed: keys ordered by type");
+
+    // Invalid key:
+    const sg::channel_key invalid_key;
+    DT_THROW_IF(invalid_key.is_valid(), std::logic_error, "Check failed: default key is invalid");
+    DT_THROW_IF(invalid_key.to_geom_id().is_valid(), std::logic_error,
+                "Check failed: invalid key round trip");
+    DT_THROW_IF(sg::channel_key(geomtools::geom_id()) != invalid_key, std::logic_error,
+                "Check failed: invalid geometry ID");
+
+    // Non packable geometry IDs:
+    DT_THROW_IF(sg::channel_key::can_pack(geomtools::geom_id(1204, 0, 1, 8, 300)), std::logic_error,
+                "Check failed: large address");
+    DT_THROW_IF(sg::channel_key::can_pack(geomtools::geom_id(5000, 0)), std::logic_error,
+                "Check failed: large type");
+    bool thrown = false;
+    try {
+      sg::channel_key bad_key(geomtools::geom_id(1204, 0, 1, 8, 300));
+    } catch (std::exception&) {
+      thrown = true;
+    }
+    DT_THROW_IF(!thrown, std::logic_error, "Check failed: non packable geometry ID throws");
+
+    // Use in a hash map:
+    std::unordered_map<sg::channel_key, int> counts;
+    counts[cell_key]++;
+    counts[sg::channel_key(cell_gid)]++;
+    counts[calo_key]++;
+    DT_THROW_IF(!(counts.size() == 2 && counts[cell_key] == 2), std::logic_error,
+                "Check failed: hash map of keys");
+
+    std::clog << "The end." << std::endl;
+  } catch (std::exception& x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: "
+              << "unexpected error!" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return (error_code);
+}
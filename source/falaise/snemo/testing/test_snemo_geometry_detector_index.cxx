@@ -0,0 +1,167 @@
+// test_snemo_geometry_detector_index.cxx
+
+// Standard library:
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/clhep_units.h>
+#include <datatools/exception.h>
+#include <datatools/properties.h>
+#include <datatools/utils.h>
+// - Bayeux/geomtools:
+#include <geomtools/geom_id.h>
+#include <geomtools/manager.h>
+
+// This project:
+#include <falaise/falaise.h>
+#include <falaise/snemo/geometry/calo_locator.h>
+#include <falaise/snemo/geometry/detector_index.h>
+#include <falaise/snemo/geometry/gg_locator.h>
+#include <falaise/snemo/geometry/gveto_locator.h>
+#include <falaise/snemo/geometry/xcalo_locator.h>
+
+int main(int argc_, char** argv_) {
+  falaise::initialize(argc_, argv_);
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for class 'snemo::geometry::detector_index'!" << std::endl;
+
+    namespace sg = snemo::geometry;
+    typedef sg::detector_index di;
+
+    std::string manager_config_file =
+        "@falaise:config/snemo/demonstrator/geometry/4.0/manager.conf";
+    datatools::fetch_path_with_env(manager_config_file);
+    datatools::properties manager_config;
+    datatools::properties::read_config(manager_config_file, manager_config);
+    manager_config.update("build_mapping", true);
+    if (manager_config.has_key("mapping.excluded_categories")) {
+      manager_config.erase("mapping.excluded_categories");
+    }
+    std::vector<std::string> only_categories;
+    for (const char* category :
+         {"hall", "module", "source_pad", "source_strip", "tracker_submodule", "tracker_volume",
+          "drift_cell_core", "xcalo_block", "xcalo_wrapper", "gveto_block", "gveto_wrapper",
+          "calorimeter_submodule", "calorimeter_block", "calorimeter_wrapper"}) {
+      only_categories.push_back(category);
+    }
+    manager_config.update("mapping.only_categories", only_categories);
+    geomtools::manager geo_manager;
+    geo_manager.initialize(manager_config);
+
+    const int module_number = 0;
+    sg::gg_locator ggl(geo_manager, module_number);
+    ggl.initialize();
+    sg::calo_locator cl(geo_manager, module_number);
+    cl.initialize();
+    sg::xcalo_locator xcl(geo_manager, module_number);
+    xcl.initialize();
+    sg::gveto_locator gvl(geo_manager, module_number);
+    gvl.initialize();
+
+    sg::detector_index index;
+    index.initialize(&ggl, &cl, &xcl, &gvl);
+    index.tree_dump(std::clog, "Detector index:");
+    const size_t ncells = 2 * ggl.get_number_of_layers(0) * ggl.get_number_of_rows(0);
+    DT_THROW_IF(!(index.get_number_of_elements() > ncells), std::logic_error,
+                "Check failed: number of elements");
+
+    geomtools::geom_id gid;
+    geomtools::geom_id expected_gid;
+    geomtools::vector_3d world_position;
+
+    // Drift cells:
+    for (uint32_t side = 0; side < ggl.get_number_of_sides(); side++) {
+      for (uint32_t layer = 0; layer < ggl.get_number_of_layers(side); layer++) {
+        for (uint32_t row = 0; row < ggl.get_number_of_rows(side); row++) {
+          ggl.make_cell_geom_id(sg::gg_locator::make_cell_id(side, layer, row), expected_gid);
+          ggl.transform_module_to_world(ggl.get_cell_position(side, layer, row), world_position);
+          DT_THROW_IF(index.find_element(world_position, gid) != di::ELEMENT_DRIFT_CELL,
+                      std::logic_error, "Check failed: cell type");
+          DT_THROW_IF(gid != expected_gid, std::logic_error, "Check failed: cell geometry ID");
+          DT_THROW_IF(index.get_element_type(gid) != di::ELEMENT_DRIFT_CELL, std::logic_error,
+                      "Check failed: cell classification");
+        }
+      }
+    }
+
+    // Main wall blocks:
+    for (uint32_t side = 0; side < cl.get_number_of_sides(); side++) {
+      for (uint32_t column = 0; column < cl.get_number_of_columns(side); column++) {
+        for (uint32_t row = 0; row < cl.get_number_of_rows(side); row++) {
+          world_position = cl.get_block_world_placement(side, column, row).get_translation();
+          DT_THROW_IF(!cl.find_block_geom_id(world_position, expected_gid), std::logic_error,
+                      "Check failed: calo locator");
+          DT_THROW_IF(index.find_element(world_position, gid) != di::ELEMENT_CALO_BLOCK,
+                      std::logic_error, "Check failed: calo type");
+          DT_THROW_IF(gid != expected_gid, std::logic_error, "Check failed: calo geometry ID");
+          DT_THROW_IF(index.get_element_type(gid) != di::ELEMENT_CALO_BLOCK, std::logic_error,
+                      "Check failed: calo classification");
+          gid.set(cl.get_module_address_index(), cl.get_module_number() + 1);
+          DT_THROW_IF(index.get_element_type(gid) != di::ELEMENT_INVALID, std::logic_error,
+                      "Check failed: calo of another module");
+        }
+      }
+    }
+
+    // X-wall blocks:
+    for (uint32_t side = 0; side < xcl.get_number_of_sides(); side++) {
+      for (uint32_t wall = 0; wall < xcl.get_number_of_walls(); wall++) {
+        for (uint32_t column = 0; column < xcl.get_number_of_columns(side, wall); column++) {
+          for (uint32_t row = 0; row < xcl.get_number_of_rows(side, wall); row++) {
+            world_position =
+                xcl.get_block_world_placement(side, wall, column, row).get_translation();
+            DT_THROW_IF(!xcl.find_block_geom_id(world_position, expected_gid), std::logic_error,
+                        "Check failed: xcalo locator");
+            DT_THROW_IF(index.find_element(world_position, gid) != di::ELEMENT_XCALO_BLOCK,
+                        std::logic_error, "Check failed: xcalo type");
+            DT_THROW_IF(gid != expected_gid, std::logic_error, "Check failed: xcalo geometry ID");
+          }
+        }
+      }
+    }
+
+    // Gamma-veto blocks:
+    for (uint32_t side = 0; side < gvl.get_number_of_sides(); side++) {
+      for (uint32_t wall = 0; wall < gvl.get_number_of_walls(); wall++) {
+        for (uint32_t column = 0; column < gvl.get_number_of_columns(side, wall); column++) {
+          world_position = gvl.get_block_world_placement(side, wall, column).get_translation();
+          DT_THROW_IF(!gvl.find_block_geom_id(world_position, expected_gid), std::logic_error,
+                      "Check failed: gveto locator");
+          DT_THROW_IF(index.find_element(world_position, gid) != di::ELEMENT_GVETO_BLOCK,
+                      std::logic_error, "Check failed: gveto type");
+          DT_THROW_IF(gid != expected_gid, std::logic_error, "Check failed: gveto geometry ID");
+        }
+      }
+    }
+
+    // Positions out of any element:
+    ggl.transform_module_to_world(geomtools::vector_3d(0.0, 0.0, 0.0), world_position);
+    DT_THROW_IF(index.find_element(world_position) != di::INVALID_ELEMENT, std::logic_error,
+                "Check failed: source foil");
+    ggl.transform_module_to_world(geomtools::vector_3d(0.0, 0.0, 100. * CLHEP::m),
+                                  world_position);
+    DT_THROW_IF(index.find_element(world_position, gid) != di::ELEMENT_INVALID, std::logic_error,
+                "Check failed: far away");
+    DT_THROW_IF(gid.is_valid(), std::logic_error, "Check failed: far away geometry ID");
+    DT_THROW_IF(index.get_element_type(geomtools::geom_id()) != di::ELEMENT_INVALID,
+                std::logic_error, "Check failed: invalid ID");
+
+    std::clog << "The end." << std::endl;
+  } catch (std::exception& x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: "
+              << "unexpected error!" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  falaise::terminate();
+  return (error_code);
+}
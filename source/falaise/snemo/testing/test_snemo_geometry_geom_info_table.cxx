@@ -0,0 +1,150 @@
+// test_snemo_geometry_geom_info_table.cxx
+
+// Standard library:
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/clhep_units.h>
+#include <datatools/exception.h>
+#include <datatools/properties.h>
+#include <datatools/utils.h>
+// - Bayeux/geomtools:
+#include <geomtools/geom_id.h>
+#include <geomtools/manager.h>
+#include <geomtools/mapping.h>
+
+// This project:
+#include <falaise/falaise.h>
+#include <falaise/snemo/geometry/channel_key.h>
+#include <falaise/snemo/geometry/geom_info_table.h>
+
+namespace {
+bool same_position(const geomtools::vector_3d& a_, const geomtools::vector_3d& b_) {
+  return (a_ - b_).mag() < 1.e-6 * CLHEP::mm;
+}
+
+/// Compare the table with the mapping for all the volumes of its category
+void check_table(const geomtools::manager& geo_manager_,
+                 const snemo::geometry::geom_info_table& table_) {
+  namespace sg = snemo::geometry;
+  const geomtools::mapping& the_mapping = geo_manager_.get_mapping();
+  geomtools::geom_id module_gid;
+  geo_manager_.get_id_mgr().make_id("module", module_gid);
+  const geomtools::geom_info_dict_type& ginfos = the_mapping.get_geom_infos();
+  size_t nentries = 0;
+  for (geomtools::geom_info_dict_type::const_iterator it = ginfos.begin(); it != ginfos.end();
+       ++it) {
+    const geomtools::geom_id& gid = it->first;
+    if (gid.get_type() != table_.get_type()) continue;
+    const sg::geom_info_table::entry* e = table_.find(sg::channel_key(gid));
+    DT_THROW_IF(e == 0, std::logic_error, "Check failed: registered volume");
+    DT_THROW_IF(e != table_.find(gid), std::logic_error, "Check failed: lookup by geometry ID");
+    DT_THROW_IF(e->ginfo != &it->second, std::logic_error, "Check failed: geometry info");
+    const geomtools::placement& world_placement = it->second.get_world_placement();
+    DT_THROW_IF(!same_position(e->world_position, world_placement.get_translation()),
+                std::logic_error, "Check failed: world position");
+    geo_manager_.get_id_mgr().extract(gid, module_gid);
+    geomtools::vector_3d module_position;
+    the_mapping.get_geom_info(module_gid)
+        .get_world_placement()
+        .mother_to_child(e->world_position, module_position);
+    DT_THROW_IF(!same_position(e->module_position, module_position), std::logic_error,
+                "Check failed: module position");
+    // A few points around the center of the volume:
+    for (int i = 0; i < 4; i++) {
+      const geomtools::vector_3d world_position =
+          e->world_position + geomtools::vector_3d((i - 1.5) * 11. * CLHEP::mm,
+                                                   (2 - i) * 7. * CLHEP::mm,
+                                                   (i - 1) * 530. * CLHEP::mm);
+      geomtools::vector_3d expected_local_position;
+      world_placement.mother_to_child(world_position, expected_local_position);
+      geomtools::vector_3d local_position;
+      e->world_to_local(world_position, local_position);
+      DT_THROW_IF(!same_position(local_position, expected_local_position), std::logic_error,
+                  "Check failed: local position");
+      DT_THROW_IF(!(std::abs(e->world_to_local_z(world_position) - expected_local_position.z()) <
+                    1.e-6 * CLHEP::mm),
+                  std::logic_error, "Check failed: local Z");
+    }
+    nentries++;
+  }
+  DT_THROW_IF(nentries != table_.get_number_of_entries(), std::logic_error,
+              "Check failed: number of entries");
+  DT_THROW_IF(!(nentries <= table_.get_number_of_slots()), std::logic_error,
+              "Check failed: number of slots");
+}
+}  // namespace
+
+int main(int argc_, char** argv_) {
+  falaise::initialize(argc_, argv_);
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for class 'snemo::geometry::geom_info_table'!" << std::endl;
+
+    namespace sg = snemo::geometry;
+
+    std::string manager_config_file =
+        "@falaise:config/snemo/demonstrator/geometry/4.0/manager.conf";
+    datatools::fetch_path_with_env(manager_config_file);
+    datatools::properties manager_config;
+    datatools::properties::read_config(manager_config_file, manager_config);
+    manager_config.update("build_mapping", true);
+    if (manager_config.has_key("mapping.excluded_categories")) {
+      manager_config.erase("mapping.excluded_categories");
+    }
+    std::vector<std::string> only_categories;
+    for (const char* category : {"hall", "module", "tracker_submodule", "tracker_volume",
+                                 "drift_cell_core", "calorimeter_submodule", "calorimeter_block",
+                                 "calorimeter_wrapper"}) {
+      only_categories.push_back(category);
+    }
+    manager_config.update("mapping.only_categories", only_categories);
+    geomtools::manager geo_manager;
+    geo_manager.initialize(manager_config);
+
+    sg::geom_info_table cells;
+    cells.initialize(geo_manager, "drift_cell_core");
+    cells.tree_dump(std::clog, "Drift cells:");
+    DT_THROW_IF(!(cells.get_number_of_entries() == 2 * 9 * 113), std::logic_error,
+                "Check failed: number of drift cells");
+    check_table(geo_manager, cells);
+
+    sg::geom_info_table blocks;
+    blocks.initialize(geo_manager, "calorimeter_block");
+    blocks.tree_dump(std::clog, "Main wall blocks:");
+    check_table(geo_manager, blocks);
+
+    // Volumes of another category or out of the table:
+    DT_THROW_IF(cells.find(sg::channel_key(blocks.get_type(), {0, 0, 0, 0, 0})) != 0,
+                std::logic_error, "Check failed: other category");
+    DT_THROW_IF(cells.find(sg::channel_key(cells.get_type(), {0, 0, 0, 200})) != 0,
+                std::logic_error, "Check failed: out of range");
+    DT_THROW_IF(cells.find(geomtools::geom_id()) != 0, std::logic_error,
+                "Check failed: invalid geometry ID");
+    bool thrown = false;
+    try {
+      cells.get(sg::channel_key(cells.get_type(), {0, 0, 0, 200}));
+    } catch (std::exception&) {
+      thrown = true;
+    }
+    DT_THROW_IF(!thrown, std::logic_error, "Check failed: get out of range");
+
+    std::clog << "The end." << std::endl;
+  } catch (std::exception& x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: "
+              << "unexpected error!" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  falaise::terminate();
+  return (error_code);
+}
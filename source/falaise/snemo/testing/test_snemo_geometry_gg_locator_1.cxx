@@ -26,7 +26,9 @@
 #include <fstream>
 #include <iostream>
 #include <list>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 // Third party:
 // - Boost:
@@ -302,6 +304,23 @@ void test5(geomtools::manager& a_mgr) {
       }
       clog << endl << endl;
     }
+
+    {
+      // Packed neighbour identifiers must match the geometry IDs:
+      GGL.get_neighbours_ids(side, 6, 54, ids, true);
+      const snemo::geometry::gg_locator::cell_id_range neighbours =
+          GGL.get_neighbour_cell_ids(snemo::geometry::gg_locator::make_cell_id(side, 6, 54), true);
+      if (neighbours.size() != ids.size()) {
+        throw std::logic_error("test5: Unexpected number of packed neighbour identifiers !");
+      }
+      for (unsigned int i = 0; i < neighbours.size(); i++) {
+        geomtools::geom_id gid;
+        GGL.make_cell_geom_id(neighbours[i], gid);
+        if (gid != ids[i]) {
+          throw std::logic_error("test5: Packed neighbour identifier mismatch !");
+        }
+      }
+    }
   }
 
   return;
@@ -558,6 +577,48 @@ void test6(geomtools::manager& a_mgr, bool draw_) {
   return;
 }
 
+void test7(geomtools::manager& a_mgr, size_t a_nhits) {
+  clog << "********** test7..." << endl;
+  int32_t my_module_number = 0;
+  snemo::geometry::gg_locator GGL;
+  GGL.set_geo_manager(a_mgr);
+  GGL.set_module_number(my_module_number);
+  GGL.initialize();
+
+  // Random positions around the tracking chamber:
+  vector<geomtools::vector_3d> hit_positions;
+  hit_positions.reserve(a_nhits);
+  for (unsigned int i = 0; i < a_nhits; i++) {
+    double dim = 5 * CLHEP::m;
+    double x = dim * (-1 + 2 * drand48());
+    double y = dim * (-1 + 2 * drand48());
+    double z = 0.5 * GGL.get_cell_length() * (-1.1 + 2.2 * drand48());
+    hit_positions.push_back(geomtools::vector_3d(x, y, z));
+  }
+
+  vector<snemo::geometry::gg_locator::cell_id_type> cell_ids;
+  size_t counts = GGL.find_cell_ids(hit_positions, cell_ids);
+  clog << "Counts (batch) = " << counts << endl;
+
+  // The batch lookup must agree with the point-by-point lookup, except for
+  // positions inside the wires which are only excluded by the latter:
+  size_t mismatches = 0;
+  for (unsigned int i = 0; i < a_nhits; i++) {
+    geomtools::geom_id gid;
+    GGL.find_cell_geom_id(hit_positions[i], gid);
+    geomtools::geom_id batch_gid;
+    GGL.make_cell_geom_id(cell_ids[i], batch_gid);
+    if (gid.is_valid() != batch_gid.is_valid() || (gid.is_valid() && !(gid == batch_gid))) {
+      mismatches++;
+    }
+  }
+  clog << "Mismatches = " << mismatches << endl;
+  if (mismatches * 1000 > counts) {
+    throw std::logic_error("Batch and single cell lookups disagree !");
+  }
+  return;
+}
+
 int main(int argc_, char** argv_) {
   falaise::initialize(argc_, argv_);
   int error_code = EXIT_SUCCESS;
@@ -578,6 +639,7 @@ int main(int argc_, char** argv_) {
     bool do_test4 = true;
     bool do_test5 = true;
     bool do_test6 = true;
+    bool do_test7 = true;
 
     int iarg = 1;
     while (iarg < argc_) {
@@ -601,6 +663,8 @@ int main(int argc_, char** argv_) {
           do_test5 = true;
         } else if ((option == "-t6") || (option == "--test6")) {
           do_test6 = true;
+        } else if ((option == "-t7") || (option == "--test7")) {
+          do_test7 = true;
         } else if ((option == "-T1") || (option == "--no-test1")) {
           do_test1 = false;
         } else if ((option == "-T2") || (option == "--no-test2")) {
@@ -613,6 +677,8 @@ int main(int argc_, char** argv_) {
           do_test5 = false;
         } else if ((option == "-T6") || (option == "--no-test6")) {
           do_test6 = false;
+        } else if ((option == "-T7") || (option == "--no-test7")) {
+          do_test7 = false;
         } else if ((option == "-V") || (option == "--verbose")) {
           verbose = true;
         } else if ((option == "-F") || (option == "--file")) {
@@ -723,6 +789,10 @@ int main(int argc_, char** argv_) {
       test6(my_manager, draw);
     }
 
+    if (do_test7) {
+      test7(my_manager, nhits);
+    }
+
   } catch (exception& x) {
     cerr << "ERROR: " << x.what() << endl;
     error_code = EXIT_FAILURE;
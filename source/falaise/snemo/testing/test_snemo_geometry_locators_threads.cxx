@@ -0,0 +1,222 @@
+// test_snemo_geometry_locators_threads.cxx
+//
+// Check that initialized locators can be shared by concurrent threads
+// through their const interface.
+
+// Standard library:
+#include <atomic>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/properties.h>
+#include <datatools/utils.h>
+// - Bayeux/geomtools:
+#include <geomtools/geom_id.h>
+#include <geomtools/manager.h>
+
+// This project:
+#include <falaise/falaise.h>
+#include <falaise/snemo/geometry/calo_locator.h>
+#include <falaise/snemo/geometry/gg_locator.h>
+#include <falaise/snemo/geometry/gveto_locator.h>
+#include <falaise/snemo/geometry/xcalo_locator.h>
+
+namespace {
+
+/// Locate a world position and compute the neighbours of the located channel
+typedef std::function<void(const geomtools::vector_3d&, geomtools::geom_id&,
+                           std::vector<geomtools::geom_id>&)>
+    lookup_type;
+
+/// A world position with the expected result of its lookup
+struct probe {
+  const lookup_type* lookup;
+  geomtools::vector_3d position;
+  geomtools::geom_id gid;
+  std::vector<geomtools::geom_id> neighbours;
+};
+
+void add_probe(std::vector<probe>& probes_, const lookup_type& lookup_,
+               const geomtools::vector_3d& position_) {
+  probe p;
+  p.lookup = &lookup_;
+  p.position = position_;
+  lookup_(p.position, p.gid, p.neighbours);
+  probes_.push_back(p);
+}
+
+}  // namespace
+
+int main(int argc_, char** argv_) {
+  falaise::initialize(argc_, argv_);
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for concurrent use of the geometry locators!" << std::endl;
+
+    namespace sg = snemo::geometry;
+
+    std::string manager_config_file =
+        "@falaise:config/snemo/demonstrator/geometry/4.0/manager.conf";
+    datatools::fetch_path_with_env(manager_config_file);
+    datatools::properties manager_config;
+    datatools::properties::read_config(manager_config_file, manager_config);
+    manager_config.update("build_mapping", true);
+    if (manager_config.has_key("mapping.excluded_categories")) {
+      manager_config.erase("mapping.excluded_categories");
+    }
+    std::vector<std::string> only_categories;
+    for (const char* category :
+         {"hall", "module", "source_pad", "source_strip", "tracker_submodule", "tracker_volume",
+          "drift_cell_core", "xcalo_block", "xcalo_wrapper", "gveto_block", "gveto_wrapper",
+          "calorimeter_submodule", "calorimeter_block", "calorimeter_wrapper"}) {
+      only_categories.push_back(category);
+    }
+    manager_config.update("mapping.only_categories", only_categories);
+    geomtools::manager geo_manager;
+    geo_manager.initialize(manager_config);
+
+    const int module_number = 0;
+    sg::gg_locator ggl;
+    ggl.set_geo_manager(geo_manager);
+    ggl.set_module_number(module_number);
+    ggl.initialize();
+    sg::calo_locator cl;
+    cl.set_geo_manager(geo_manager);
+    cl.set_module_number(module_number);
+    cl.initialize();
+    sg::xcalo_locator xcl;
+    xcl.set_geo_manager(geo_manager);
+    xcl.set_module_number(module_number);
+    xcl.initialize();
+    sg::gveto_locator gvl;
+    gvl.set_geo_manager(geo_manager);
+    gvl.set_module_number(module_number);
+    gvl.initialize();
+
+    const lookup_type gg_lookup = [&ggl](const geomtools::vector_3d& position_,
+                                         geomtools::geom_id& gid_,
+                                         std::vector<geomtools::geom_id>& ids_) {
+      ids_.clear();
+      if (ggl.find_cell_geom_id(position_, gid_)) ggl.get_neighbours_ids(gid_, ids_, true);
+    };
+    const lookup_type calo_lookup = [&cl](const geomtools::vector_3d& position_,
+                                          geomtools::geom_id& gid_,
+                                          std::vector<geomtools::geom_id>& ids_) {
+      ids_.clear();
+      if (cl.find_block_geom_id(position_, gid_)) {
+        cl.get_neighbours_ids(gid_, ids_, sg::utils::NEIGHBOUR_FIRST | sg::utils::NEIGHBOUR_SECOND);
+      }
+    };
+    const lookup_type xcalo_lookup = [&xcl](const geomtools::vector_3d& position_,
+                                            geomtools::geom_id& gid_,
+                                            std::vector<geomtools::geom_id>& ids_) {
+      ids_.clear();
+      if (xcl.find_block_geom_id(position_, gid_)) xcl.get_neighbours_ids(gid_, ids_);
+    };
+    const lookup_type gveto_lookup = [&gvl](const geomtools::vector_3d& position_,
+                                            geomtools::geom_id& gid_,
+                                            std::vector<geomtools::geom_id>& ids_) {
+      ids_.clear();
+      if (gvl.find_block_geom_id(position_, gid_)) gvl.get_neighbours_ids(gid_, ids_);
+    };
+
+    // Reference results computed serially:
+    std::vector<probe> probes;
+    for (uint32_t side = 0; side < ggl.get_number_of_sides(); side++) {
+      for (uint32_t layer = 0; layer < ggl.get_number_of_layers(side); layer++) {
+        for (uint32_t row = 0; row < ggl.get_number_of_rows(side); row += 7) {
+          geomtools::vector_3d world_position;
+          ggl.transform_module_to_world(ggl.get_cell_position(side, layer, row), world_position);
+          add_probe(probes, gg_lookup, world_position);
+        }
+      }
+    }
+    for (uint32_t side = 0; side < cl.get_number_of_sides(); side++) {
+      for (uint32_t column = 0; column < cl.get_number_of_columns(side); column++) {
+        for (uint32_t row = 0; row < cl.get_number_of_rows(side); row++) {
+          add_probe(probes, calo_lookup,
+                    cl.get_block_world_placement(side, column, row).get_translation());
+        }
+      }
+    }
+    for (uint32_t side = 0; side < xcl.get_number_of_sides(); side++) {
+      for (uint32_t wall = 0; wall < xcl.get_number_of_walls(); wall++) {
+        for (uint32_t column = 0; column < xcl.get_number_of_columns(side, wall); column++) {
+          for (uint32_t row = 0; row < xcl.get_number_of_rows(side, wall); row++) {
+            add_probe(probes, xcalo_lookup,
+                      xcl.get_block_world_placement(side, wall, column, row).get_translation());
+          }
+        }
+      }
+    }
+    for (uint32_t side = 0; side < gvl.get_number_of_sides(); side++) {
+      for (uint32_t wall = 0; wall < gvl.get_number_of_walls(); wall++) {
+        for (uint32_t column = 0; column < gvl.get_number_of_columns(side, wall); column++) {
+          add_probe(probes, gveto_lookup,
+                    gvl.get_block_world_placement(side, wall, column).get_translation());
+        }
+      }
+    }
+    std::size_t nlocated = 0;
+    for (const probe& p : probes) {
+      if (p.gid.is_valid()) nlocated++;
+    }
+    std::clog << "Number of probes = " << probes.size() << " (" << nlocated << " located)"
+              << std::endl;
+    if (nlocated == 0) {
+      throw std::logic_error("No probe could be located!");
+    }
+
+    // Concurrent lookups through the shared locators:
+    const unsigned int nthreads = 8;
+    const unsigned int nloops = 5;
+    std::atomic<std::size_t> nmismatches(0);
+    std::atomic<std::size_t> nexceptions(0);
+    std::vector<std::thread> workers;
+    for (unsigned int ithread = 0; ithread < nthreads; ithread++) {
+      workers.emplace_back([&probes, &nmismatches, &nexceptions, ithread, nthreads, nloops]() {
+        geomtools::geom_id gid;
+        std::vector<geomtools::geom_id> ids;
+        for (unsigned int iloop = 0; iloop < nloops; iloop++) {
+          // Each thread walks the probes from a different starting point:
+          for (std::size_t i = 0; i < probes.size(); i++) {
+            const probe& p = probes[(i + ithread * probes.size() / nthreads) % probes.size()];
+            try {
+              (*p.lookup)(p.position, gid, ids);
+              if (gid != p.gid || ids != p.neighbours) nmismatches++;
+            } catch (std::exception&) {
+              nexceptions++;
+            }
+          }
+        }
+      });
+    }
+    for (std::thread& worker : workers) {
+      worker.join();
+    }
+    std::clog << "Number of mismatches = " << nmismatches << std::endl;
+    std::clog << "Number of exceptions = " << nexceptions << std::endl;
+    if (nmismatches != 0 || nexceptions != 0) {
+      throw std::logic_error("Concurrent lookups differ from the serial ones!");
+    }
+
+    std::clog << "The end." << std::endl;
+  } catch (std::exception& x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: "
+              << "unexpected error!" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  falaise::terminate();
+  return (error_code);
+}
@@ -23,16 +23,25 @@
 #include <falaise/snemo/geometry/mapped_magnetic_field.h>
 
 // Standard library:
+#include <cstdio>
 #include <cstdlib>
 #include <exception>
+#include <fstream>
 #include <iostream>
+#include <stdexcept>
 #include <string>
+#include <vector>
+// - POSIX:
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 // Third party:
 // - Bayeux:
 #include <bayeux/bayeux.h>
 // - Bayeux/datatools:
 #include <datatools/clhep_units.h>
+#include <datatools/exception.h>
 #include <datatools/ioutils.h>
 #include <datatools/library_loader.h>
 #include <datatools/properties.h>
@@ -52,6 +61,147 @@
 // This project:
 #include <falaise/falaise.h>
 
+namespace {
+
+/// Write a 4x4x4 CSV map whose values are shifted by an offset
+void write_csv_map(const std::string& filename_, int offset_) {
+  std::ofstream fout(filename_.c_str());
+  const int n = 4;
+  fout << n << ',' << n << ',' << n << ",0,0,0,1,1,1\n";
+  for (int ax = 0; ax < 3; ax++) {
+    for (int iz = 0; iz < n; iz++) {
+      for (int iy = 0; iy < n; iy++) {
+        fout << ax << ',' << iy << ',' << iz;
+        for (int ix = 0; ix < n; ix++) {
+          fout << ',' << 1000 * ax + 100 * iz + 10 * iy + ix + offset_;
+        }
+        fout << '\n';
+      }
+    }
+  }
+  fout.close();
+  DT_THROW_IF(!fout, std::runtime_error, "Cannot write map file '" << filename_ << "'!");
+}
+
+/// Compute the B-field of a CSV map at positions spanning the whole map
+std::vector<geomtools::vector_3d> compute_map_fields(const std::string& map_filename_,
+                                                     bool map_cache_,
+                                                     const std::string& cache_directory_) {
+  snemo::geometry::mapped_magnetic_field mmf;
+  mmf.set_mapping_mode(snemo::geometry::mapped_magnetic_field::MM_IMPORT_CSV_MAP_0);
+  mmf.set_map_filename(map_filename_);
+  mmf.set_zero_field_outside_map(false);
+  mmf.set_map_cache(map_cache_);
+  mmf.set_map_cache_directory(cache_directory_);
+  mmf.initialize_simple();
+  std::vector<geomtools::vector_3d> positions;
+  for (double x = 0.1; x < 3.0; x += 0.7) {
+    for (double y = 0.2; y < 3.0; y += 0.7) {
+      for (double z = 0.3; z < 3.0; z += 0.7) {
+        positions.push_back(geomtools::vector_3d(x, -y, z) * CLHEP::m);
+      }
+    }
+  }
+  std::vector<geomtools::vector_3d> fields;
+  DT_THROW_IF(mmf.compute_magnetic_fields(positions, 0.0, fields) !=
+                  snemo::geometry::mapped_magnetic_field::STATUS_SUCCESS,
+              std::logic_error, "Cannot compute the B-field of map '" << map_filename_ << "'!");
+  mmf.reset();
+  return fields;
+}
+
+/// Return the paths of the map cache files of a directory
+std::vector<std::string> list_cache_files(const std::string& directory_) {
+  std::vector<std::string> files;
+  DIR* dir = ::opendir(directory_.c_str());
+  DT_THROW_IF(dir == 0, std::runtime_error, "Cannot open directory '" << directory_ << "'!");
+  while (const struct dirent* entry = ::readdir(dir)) {
+    const std::string name = entry->d_name;
+    if (name.size() > 5 && name.compare(name.size() - 5, 5, ".bmap") == 0) {
+      files.push_back(directory_ + "/" + name);
+    }
+  }
+  ::closedir(dir);
+  return files;
+}
+
+/// Return the size of a file
+off_t file_size(const std::string& filename_) {
+  struct stat file_status;
+  DT_THROW_IF(::stat(filename_.c_str(), &file_status) != 0, std::runtime_error,
+              "Cannot stat file '" << filename_ << "'!");
+  return file_status.st_size;
+}
+
+/// Check that B-fields computed from the binary cache match the ones parsed from the CSV map,
+/// and that stale, corrupted or truncated caches are not used
+void test_map_cache() {
+  std::clog << "Test of the binary map cache..." << std::endl;
+  char directory_template[] = "/tmp/test_snemo_geometry_mapped_magnetic_field_XXXXXX";
+  DT_THROW_IF(::mkdtemp(directory_template) == 0, std::runtime_error,
+              "Cannot create a temporary directory!");
+  const std::string cache_directory = directory_template;
+  const std::string map_filename = cache_directory + "/map.csv";
+
+  // CSV -> cache -> memory mapped cache:
+  write_csv_map(map_filename, 0);
+  const std::vector<geomtools::vector_3d> parsed =
+      compute_map_fields(map_filename, false, cache_directory);
+  DT_THROW_IF(!list_cache_files(cache_directory).empty(), std::logic_error,
+              "Cache written while disabled!");
+  DT_THROW_IF(compute_map_fields(map_filename, true, cache_directory) != parsed, std::logic_error,
+              "B-field differs when writing the cache!");
+  DT_THROW_IF(list_cache_files(cache_directory).size() != 1, std::logic_error,
+              "Cache not written!");
+  DT_THROW_IF(compute_map_fields(map_filename, true, cache_directory) != parsed, std::logic_error,
+              "B-field differs when read from the cache!");
+
+  // A change of the CSV map selects a new cache:
+  write_csv_map(map_filename, 7);
+  const std::vector<geomtools::vector_3d> reparsed =
+      compute_map_fields(map_filename, false, cache_directory);
+  DT_THROW_IF(reparsed == parsed, std::logic_error, "B-field unchanged by the new map!");
+  DT_THROW_IF(compute_map_fields(map_filename, true, cache_directory) != reparsed,
+              std::logic_error, "B-field from a stale cache!");
+  std::vector<std::string> cache_files = list_cache_files(cache_directory);
+  DT_THROW_IF(cache_files.size() != 2, std::logic_error, "Cache of the new map not written!");
+
+  // Corrupted values in the caches:
+  for (size_t i = 0; i < cache_files.size(); i++) {
+    const off_t size = file_size(cache_files[i]);
+    std::fstream cache_file(cache_files[i].c_str(),
+                            std::ios::in | std::ios::out | std::ios::binary);
+    cache_file.seekp(size / 2);
+    cache_file << std::string(size - size / 2, 'U');
+  }
+  DT_THROW_IF(compute_map_fields(map_filename, true, cache_directory) != reparsed,
+              std::logic_error, "B-field from a corrupted cache!");
+
+  // Truncated caches:
+  cache_files = list_cache_files(cache_directory);
+  for (size_t i = 0; i < cache_files.size(); i++) {
+    DT_THROW_IF(::truncate(cache_files[i].c_str(), file_size(cache_files[i]) - 4) != 0,
+                std::runtime_error, "Cannot truncate file '" << cache_files[i] << "'!");
+  }
+  DT_THROW_IF(compute_map_fields(map_filename, true, cache_directory) != reparsed,
+              std::logic_error, "B-field from a truncated cache!");
+
+  // Rewritten caches are private to the user:
+  cache_files = list_cache_files(cache_directory);
+  for (size_t i = 0; i < cache_files.size(); i++) {
+    struct stat file_status;
+    DT_THROW_IF(::stat(cache_files[i].c_str(), &file_status) != 0 ||
+                    (file_status.st_mode & (S_IRWXG | S_IRWXO)) != 0,
+                std::logic_error, "Cache file '" << cache_files[i] << "' is not private!");
+    std::remove(cache_files[i].c_str());
+  }
+  std::remove(map_filename.c_str());
+  ::rmdir(cache_directory.c_str());
+  std::clog << "Binary map cache is consistent with the CSV map" << std::endl;
+}
+
+}  // namespace
+
 int main(int argc_, char** argv_) {
   falaise::initialize(argc_, argv_);
   int error_code = EXIT_SUCCESS;
@@ -98,6 +248,8 @@ int main(int argc_, char** argv_) {
       iarg++;
     }
 
+    test_map_cache();
+
     if (map_filename.empty()) {
       map_filename =
           "@falaise:config/snemo/demonstrator/geometry/4.0/plugins/magnetic_field/data/csv_map_0/"
@@ -181,6 +333,29 @@ int main(int argc_, char** argv_) {
       std::clog << "|B| = " << B.mag() / b_unit << " mG" << std::endl;
     }
 
+    {
+      // Batch computation must match the point by point one:
+      std::vector<geomtools::vector_3d> positions;
+      for (double x = -0.5 * CLHEP::m; x <= +0.5 * CLHEP::m; x += 0.1 * CLHEP::m) {
+        for (double y = -2.5 * CLHEP::m; y <= +2.5 * CLHEP::m; y += 0.5 * CLHEP::m) {
+          for (double z = -1.5 * CLHEP::m; z <= +1.5 * CLHEP::m; z += 0.3 * CLHEP::m) {
+            positions.push_back(geomtools::vector_3d(x, y, z));
+          }
+        }
+      }
+      positions.push_back(geomtools::vector_3d(0.0, 0.0, 100.0 * CLHEP::m));
+      std::vector<geomtools::vector_3d> fields;
+      mmf.compute_magnetic_fields(positions, 0.0, fields);
+      DT_THROW_IF(fields.size() != positions.size(), std::logic_error, "Invalid batch size!");
+      for (size_t i = 0; i < positions.size(); i++) {
+        geomtools::vector_3d B;
+        mmf.compute_magnetic_field(positions[i], 0.0, B);
+        DT_THROW_IF(!(B == fields[i]), std::logic_error,
+                    "Batch B-field differs at " << positions[i] / CLHEP::m << " m!");
+      }
+      std::clog << "Batch B-field computed at " << positions.size() << " positions" << std::endl;
+    }
+
     mmf.reset();
 
     if (draw) {
@@ -0,0 +1,111 @@
+// test_snemo_processing_calorimeter_regime.cxx
+//
+// Usage: test_snemo_processing_calorimeter_regime [relative tolerance]
+
+// Standard library:
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/clhep_units.h>
+#include <datatools/exception.h>
+#include <datatools/properties.h>
+// - Bayeux/mygsl:
+#include <mygsl/rng.h>
+
+// This project:
+#include <falaise/snemo/processing/calorimeter_regime.h>
+
+namespace {
+/// Check the tabulated quenched alpha energy against the fitted formula
+void check_alpha_quenching(const snemo::processing::calorimeter_regime& regime_,
+                           double tolerance_) {
+  double max_deviation = 0.0;
+  for (double e = 0.1 * CLHEP::keV; e < 15. * CLHEP::MeV; e += 0.77 * CLHEP::keV) {
+    const double analytic = regime_.quench_alpha_energy(e, 1);
+    const double deviation = std::abs(regime_.quench_alpha_energy(e) / analytic - 1.0);
+    if (deviation > max_deviation) max_deviation = deviation;
+  }
+  std::clog << "Maximum relative deviation of the quenched alpha energy = " << max_deviation
+            << std::endl;
+  DT_THROW_IF(!(max_deviation < tolerance_), std::logic_error,
+              "Check failed: quenched alpha energy");
+}
+}  // namespace
+
+int main(int argc_, char** argv_) {
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for class 'snemo::processing::calorimeter_regime'!" << std::endl;
+
+    double tolerance = 1.e-5;
+    if (argc_ > 1) {
+      tolerance = std::atof(argv_[1]);
+      DT_THROW_IF(!(tolerance > 0.0), std::logic_error, "Check failed: positive tolerance");
+    }
+    std::clog << "Relative tolerance = " << tolerance << std::endl;
+
+    // Default parameters:
+    snemo::processing::calorimeter_regime calo_regime;
+    datatools::properties config;
+    calo_regime.initialize(config);
+    calo_regime.tree_dump(std::clog, "Calorimeter regime:");
+    check_alpha_quenching(calo_regime, tolerance);
+
+    const double fwhm2sig = 1.0 / (2 * std::sqrt(2 * std::log(2.0)));
+    for (double e = 0.0; e < 5. * CLHEP::MeV; e += 13.1 * CLHEP::keV) {
+      const double sigma = 8. * CLHEP::perCent * fwhm2sig * std::sqrt(e / CLHEP::MeV);
+      DT_THROW_IF(!(std::abs(calo_regime.get_sigma_energy(e) - sigma) <= tolerance * sigma),
+                  std::logic_error, "Check failed: energy resolution");
+    }
+
+    // Same draws as a gaussian with the analytic resolution:
+    mygsl::rng random_1("taus2", 314159);
+    mygsl::rng random_2("taus2", 314159);
+    for (double e = 10. * CLHEP::keV; e < 3. * CLHEP::MeV; e += 71. * CLHEP::keV) {
+      const double expected = random_2.gaussian(e, calo_regime.get_sigma_energy(e));
+      DT_THROW_IF(calo_regime.randomize_energy(random_1, e) != (expected < 0.0 ? 0.0 : expected),
+                  std::logic_error, "Check failed: randomized energy");
+    }
+
+    // Other resolution and quenching parameters:
+    snemo::processing::calorimeter_regime xcalo_regime;
+    datatools::properties xconfig;
+    xconfig.store("energy.resolution", 12.0);  // in %
+    std::vector<double> quenching_parameters;
+    quenching_parameters.push_back(60.0);
+    quenching_parameters.push_back(0.5);
+    quenching_parameters.push_back(2.0);
+    xconfig.store("alpha_quenching_parameters", quenching_parameters);
+    xcalo_regime.initialize(xconfig);
+    check_alpha_quenching(xcalo_regime, tolerance);
+    DT_THROW_IF(!(std::abs(xcalo_regime.get_sigma_energy(1. * CLHEP::MeV) -
+                           1.5 * calo_regime.get_sigma_energy(1. * CLHEP::MeV)) <
+                  1.e-12 * CLHEP::MeV),
+                std::logic_error, "Check failed: resolution scaling");
+
+    // Quenching parameters are not checked if alpha quenching is not used:
+    snemo::processing::calorimeter_regime gveto_regime;
+    datatools::properties gveto_config;
+    gveto_config.store("alpha_quenching", false);
+    quenching_parameters.assign(3, 0.0);
+    gveto_config.store("alpha_quenching_parameters", quenching_parameters);
+    gveto_regime.initialize(gveto_config);
+
+    std::clog << "The end." << std::endl;
+  } catch (std::exception& x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: "
+              << "unexpected error!" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return (error_code);
+}
@@ -0,0 +1,90 @@
+// test_snemo_processing_geiger_regime.cxx
+
+// Standard library:
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/clhep_units.h>
+#include <datatools/exception.h>
+#include <datatools/properties.h>
+#include <datatools/utils.h>
+// - Bayeux/mygsl:
+#include <mygsl/rng.h>
+
+// This project:
+#include <falaise/snemo/processing/geiger_regime.h>
+
+int main(/* int argc_, char ** argv_ */) {
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for class 'snemo::processing::geiger_regime'!" << std::endl;
+
+    datatools::properties config;
+    snemo::processing::geiger_regime gg_regime;
+    gg_regime.initialize(config);
+    gg_regime.tree_dump(std::clog, "Geiger regime:");
+
+    const double t0 = gg_regime.get_t0();
+    const double tcut = gg_regime.get_tcut();
+    const double r0 = gg_regime.get_r0();
+    std::clog << "t0 = " << t0 / CLHEP::microsecond << " us" << std::endl;
+    DT_THROW_IF(!(t0 > 0.0 && t0 < tcut), std::logic_error, "Check failed: t0 range");
+    DT_THROW_IF(!(std::abs(gg_regime.base_t_2_r(t0, 1) - r0) < 1.e-6 * CLHEP::mm), std::logic_error,
+                "Check failed: t0 at cell radius");
+
+    // Tabulated prompt regime against the fitted formula:
+    double previous_radius = -1.0;
+    for (double t = 0.0; t <= t0; t += 1.7 * CLHEP::ns) {
+      const double r = gg_regime.base_t_2_r(t);
+      DT_THROW_IF(!(std::abs(r - gg_regime.base_t_2_r(t, 1)) < 1.e-3 * CLHEP::mm), std::logic_error,
+                  "Check failed: prompt radius");
+      DT_THROW_IF(!(r > previous_radius), std::logic_error, "Check failed: increasing radius");
+      previous_radius = r;
+    }
+
+    // Round trips over the full drift time range:
+    for (double t = 0.0; t <= tcut; t += 3.1 * CLHEP::ns) {
+      const double r = gg_regime.base_t_2_r(t);
+      DT_THROW_IF(!(std::abs(gg_regime.base_r_2_t(r) - t) < 1.0 * CLHEP::ns), std::logic_error,
+                  "Check failed: drift time round trip");
+    }
+
+    // Calibration and randomization:
+    double radius;
+    double sigma_radius;
+    gg_regime.calibrate_drift_radius_from_drift_time(1.0 * CLHEP::microsecond, radius,
+                                                      sigma_radius);
+    DT_THROW_IF(!(datatools::is_valid(radius) && datatools::is_valid(sigma_radius)),
+                std::logic_error, "Check failed: calibration");
+    DT_THROW_IF(
+        !(std::abs(radius - gg_regime.base_t_2_r(1.0 * CLHEP::microsecond)) < 1.e-9 * CLHEP::mm),
+        std::logic_error, "Check failed: calibrated radius");
+    gg_regime.calibrate_drift_radius_from_drift_time(tcut + 1.0 * CLHEP::microsecond, radius,
+                                                      sigma_radius);
+    DT_THROW_IF(datatools::is_valid(radius), std::logic_error,
+                "Check failed: calibration beyond tcut");
+
+    mygsl::rng random("taus2", 314159);
+    for (double r = 0.0; r <= gg_regime.get_rdiag(); r += 0.37 * CLHEP::mm) {
+      const double t = gg_regime.randomize_drift_time_from_drift_distance(random, r);
+      DT_THROW_IF(!(datatools::is_valid(t) && t >= 0.0), std::logic_error,
+                  "Check failed: random drift time");
+    }
+
+    std::clog << "The end." << std::endl;
+  } catch (std::exception& x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: "
+              << "unexpected error!" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return (error_code);
+}
@@ -0,0 +1,137 @@
+// test_snemo_processing_random_stream.cxx
+
+// Standard library:
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+
+// This project:
+#include <falaise/snemo/processing/random_stream.h>
+
+namespace {
+/// Check the Philox4x32-10 function against a known answer
+void check_philox(uint32_t c0_, uint32_t c1_, uint32_t c2_, uint32_t c3_, uint32_t k0_,
+                  uint32_t k1_, uint32_t v0_, uint32_t v1_, uint32_t v2_, uint32_t v3_) {
+  const uint32_t counter[4] = {c0_, c1_, c2_, c3_};
+  const uint32_t key[2] = {k0_, k1_};
+  uint32_t values[4];
+  snemo::processing::philox4x32::generate(counter, key, values);
+  DT_THROW_IF(!(values[0] == v0_ && values[1] == v1_ && values[2] == v2_ && values[3] == v3_),
+              std::logic_error, "Check failed: Philox4x32-10 known answer");
+}
+}  // namespace
+
+int main(/* int argc_, char ** argv_ */) {
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for class 'snemo::processing::random_stream'!" << std::endl;
+
+    namespace sp = snemo::processing;
+
+    // Known answers of the reference implementation (Random123):
+    check_philox(0, 0, 0, 0, 0, 0, 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8);
+    check_philox(0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+                 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd);
+    check_philox(0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344, 0xa4093822, 0x299f31d0,
+                 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1);
+
+    const uint64_t key = sp::random_stream::make_key(314159, "test.calibration");
+    DT_THROW_IF(key == sp::random_stream::make_key(314159, "test.digitization"), std::logic_error,
+                "Check failed: stage keys");
+    DT_THROW_IF(key == sp::random_stream::make_key(271828, "test.calibration"), std::logic_error,
+                "Check failed: seed keys");
+
+    // Same numbers for the same hit of an event, whatever the other streams drawn before:
+    {
+      sp::random_stream hit_3(key, 1, 42, 3);
+      const double u = hit_3.uniform();
+      const double g = hit_3.gaussian(0.0, 1.0);
+      sp::random_stream hit_4(key, 1, 42, 4);
+      DT_THROW_IF(hit_4.uniform() == u, std::logic_error, "Check failed: independent hits");
+      sp::random_stream other_event(key, 1, 43, 3);
+      DT_THROW_IF(other_event.uniform() == u, std::logic_error, "Check failed: independent events");
+      sp::random_stream hit_3_again(key, 1, 42, 3);
+      DT_THROW_IF(hit_3_again.uniform() != u, std::logic_error,
+                  "Check failed: reproducible uniform deviate");
+      DT_THROW_IF(hit_3_again.gaussian(0.0, 1.0) != g, std::logic_error,
+                  "Check failed: reproducible gaussian deviate");
+    }
+
+    // Batches give the same numbers as successive draws:
+    for (size_t n = 0; n < 9; n++) {
+      for (size_t skip = 0; skip < 3; skip++) {
+        std::vector<double> batch(n + 1);
+        sp::random_stream scalar_random(key, 2, 7, 11);
+        sp::random_stream batch_random(key, 2, 7, 11);
+        for (size_t i = 0; i < skip; i++) {
+          scalar_random.uniform();
+          batch_random.uniform();
+        }
+        batch_random.fill_uniform(n, batch.data());
+        for (size_t i = 0; i < n; i++) {
+          DT_THROW_IF(batch[i] != scalar_random.uniform(), std::logic_error,
+                      "Check failed: batch of uniform deviates");
+        }
+        DT_THROW_IF(batch_random.uniform() != scalar_random.uniform(), std::logic_error,
+                    "Check failed: uniform after batch");
+        for (size_t i = 0; i < skip; i++) {
+          scalar_random.gaussian(0.0, 1.0);
+          batch_random.gaussian(0.0, 1.0);
+        }
+        batch_random.fill_gaussian(n, batch.data());
+        for (size_t i = 0; i < n; i++) {
+          DT_THROW_IF(batch[i] != scalar_random.gaussian(0.0, 1.0), std::logic_error,
+                      "Check failed: batch of gaussian deviates");
+        }
+        DT_THROW_IF(batch_random.gaussian(0.0, 1.0) != scalar_random.gaussian(0.0, 1.0),
+                    std::logic_error, "Check failed: gaussian after batch");
+      }
+    }
+
+    // Moments:
+    {
+      const size_t n = 1000000;
+      std::vector<double> values(n);
+      sp::random_stream random(key, 0, 0, 0);
+      random.fill_uniform(n, values.data());
+      double sum = 0.0;
+      for (size_t i = 0; i < n; i++) {
+        DT_THROW_IF(!(values[i] > 0.0 && values[i] < 1.0), std::logic_error,
+                    "Check failed: uniform deviate range");
+        sum += values[i];
+      }
+      DT_THROW_IF(!(std::abs(sum / n - 0.5) < 0.002), std::logic_error,
+                  "Check failed: uniform mean");
+      random.fill_gaussian(n, values.data());
+      double sum2 = 0.0;
+      sum = 0.0;
+      for (size_t i = 0; i < n; i++) {
+        sum += values[i];
+        sum2 += values[i] * values[i];
+      }
+      const double mean = sum / n;
+      const double variance = sum2 / n - mean * mean;
+      std::clog << "Gaussian mean = " << mean << ", variance = " << variance << std::endl;
+      DT_THROW_IF(!(std::abs(mean) < 0.005 && std::abs(variance - 1.0) < 0.01), std::logic_error,
+                  "Check failed: gaussian moments");
+    }
+
+    std::clog << "The end." << std::endl;
+  } catch (std::exception& x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: "
+              << "unexpected error!" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return (error_code);
+}
@@ -3,11 +3,14 @@
 
 // Standard Library
 #include <set>
+#include <string>
 #include <vector>
 
 // Third Party
 // - Boost
+#include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
 #include "boost/program_options.hpp"
 #include "boost/version.hpp"
 // - Bayeux
@@ -37,6 +40,13 @@ FLReconstructCommandLine FLReconstructCommandLine::makeDefault() {
   FLReconstructCommandLine frArgs;
   frArgs.logLevel = datatools::logger::PRIO_FATAL;
   frArgs.moduloEvents = 0;
+  frArgs.numberOfThreads = 1;
+  frArgs.asynchronousIO = false;
+  frArgs.recycleBanks = false;
+  frArgs.profileReport = "";
+  frArgs.numberOfJobs = 1;
+  frArgs.firstEvent = 0;
+  frArgs.endEvent = 0;
   frArgs.userProfile = "normal";
   frArgs.pipelineScript = "";
   frArgs.inputMetadataFile = "";
@@ -157,6 +167,8 @@ FLDialogState do_cldialog(int argc, char* argv[], FLReconstructCommandLine& clAr
 
   // Bind command line parser to exposed parameters
   std::string verbosityLabel;
+  std::string eventRange;
+  std::string banksList;
   // Application specific options:
   bpo::options_description optDesc("Options");
   optDesc.add_options()("help,h", "print this help message")
@@ -183,6 +195,33 @@ FLDialogState do_cldialog(int argc, char* argv[], FLReconstructCommandLine& clAr
            bpo::value<uint32_t>(&clArgs.moduloEvents)->default_value(0)->value_name("period"),
            "progress modulo on number of events")
 
+          ("threads,t",
+           bpo::value<uint32_t>(&clArgs.numberOfThreads)->default_value(1)->value_name("n"),
+           "number of worker threads running the pipeline")
+
+          ("jobs,j",
+           bpo::value<uint32_t>(&clArgs.numberOfJobs)->default_value(1)->value_name("n"),
+           "number of processes sharing the input entries")
+
+          ("first-event", bpo::value<uint64_t>(&clArgs.firstEvent)->value_name("index"),
+           "index of the first input event to process")
+
+          ("event-range", bpo::value<std::string>(&eventRange)->value_name("begin:end"),
+           "range of input events to process (end excluded, may be omitted)")
+
+          ("async-io", bpo::bool_switch(&clArgs.asynchronousIO),
+           "read and write event records in dedicated threads")
+
+          ("keep-banks", bpo::value<std::string>(&banksList)->value_name("labels"),
+           "comma separated labels of the input banks to keep (default: all)")
+
+          ("recycle-banks", bpo::bool_switch(&clArgs.recycleBanks),
+           "reuse the storage of the data banks from one event to the next "
+           "(empty CD, TCD and TTD banks are then seen by all modules)")
+
+          ("profile-report", bpo::value<std::string>(&clArgs.profileReport)->value_name("file"),
+           "time each pipeline module and write the profiling report in file (JSON)")
+
               ("user-profile,u",
                bpo::value<std::string>(&clArgs.userProfile)
                    ->value_name("name")
@@ -272,6 +311,41 @@ FLDialogState do_cldialog(int argc, char* argv[], FLReconstructCommandLine& clAr
     }
   }
 
+  if (vMap.count("event-range")) {
+    if (vMap.count("first-event")) {
+      do_error(std::cerr, "Options '--first-event' and '--event-range' are exclusive!");
+      return DIALOG_ERROR;
+    }
+    std::vector<std::string> bounds;
+    boost::algorithm::split(bounds, eventRange, boost::algorithm::is_any_of(":"));
+    bool validRange = bounds.size() == 2 && !bounds[0].empty();
+    try {
+      if (validRange) {
+        clArgs.firstEvent = boost::lexical_cast<uint64_t>(bounds[0]);
+        if (!bounds[1].empty()) {
+          clArgs.endEvent = boost::lexical_cast<uint64_t>(bounds[1]);
+          validRange = clArgs.endEvent > clArgs.firstEvent;
+        }
+      }
+    } catch (const boost::bad_lexical_cast&) {
+      validRange = false;
+    }
+    if (!validRange) {
+      do_error(std::cerr, "Invalid event range '" + eventRange + "'!");
+      return DIALOG_ERROR;
+    }
+  }
+
+  if (vMap.count("keep-banks")) {
+    boost::algorithm::split(clArgs.keptBanks, banksList, boost::algorithm::is_any_of(","));
+    for (const std::string& label : clArgs.keptBanks) {
+      if (label.empty()) {
+        do_error(std::cerr, "Invalid list of banks '" + banksList + "'!");
+        return DIALOG_ERROR;
+      }
+    }
+  }
+
   if (!falaise::common::supported_user_profiles().count(clArgs.userProfile)) {
     do_error(std::cerr, "Invalid user profile '" + clArgs.userProfile + "'!");
     return DIALOG_ERROR;
@@ -18,6 +18,7 @@
 // Standard Library:
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 // Third Party
 // - Boost
@@ -38,10 +39,18 @@ namespace FLReconstruct {
 struct FLReconstructCommandLine {
   datatools::logger::priority logLevel;  //!< Verbosity level
   uint32_t moduloEvents;                 //!< Event modulo
+  uint32_t numberOfThreads;              //!< Number of worker threads
+  bool asynchronousIO;                   //!< Flag to read/write event records in dedicated threads
+  bool recycleBanks;                     //!< Flag to reuse the data banks storage across events
+  std::string profileReport;             //!< Path for the per-module profiling report
+  uint32_t numberOfJobs;                 //!< Number of processes
+  uint64_t firstEvent;                   //!< Index of the first input event to process
+  uint64_t endEvent;                     //!< Index after the last input event to process (0: none)
   std::string userProfile;               //!< User profile
   std::string pipelineScript;            //!< Path of the processing pipeline configuration script
   std::string inputMetadataFile;         //!< Path for loading metadata
   std::string inputFile;                 //!< Path for the input module
+  std::vector<std::string> keptBanks;    //!< Labels of the input banks to keep (all if empty)
   std::string outputMetadataFile;        //!< Path for saving metadata
   bool embeddedMetadata;                 //!< Flag to embed metadata in the output data file
   std::string outputFile;                //!< Path for the output module
@@ -64,9 +64,19 @@ void do_configure(int argc, char* argv[], FLReconstructParams& flRecParameters)
   // Import parameters from the command line:
   flRecParameters.logLevel = clArgs.logLevel;
   flRecParameters.moduloEvents = clArgs.moduloEvents;
+  flRecParameters.numberOfThreads = clArgs.numberOfThreads;
+  flRecParameters.asynchronousIO = clArgs.asynchronousIO;
+  flRecParameters.recycleBanks = clArgs.recycleBanks;
+  flRecParameters.profileReport = clArgs.profileReport;
+  flRecParameters.numberOfJobs = clArgs.numberOfJobs;
   flRecParameters.userProfile = clArgs.userProfile;
   flRecParameters.inputMetadataFile = clArgs.inputMetadataFile;
   flRecParameters.inputFile = clArgs.inputFile;
+  flRecParameters.keptBanks = clArgs.keptBanks;
+  flRecParameters.inputFirstEntry = clArgs.firstEvent;
+  if (clArgs.endEvent > 0) {
+    flRecParameters.inputNumberOfEntries = clArgs.endEvent - clArgs.firstEvent;
+  }
   flRecParameters.outputMetadataFile = clArgs.outputMetadataFile;
   flRecParameters.embeddedMetadata = clArgs.embeddedMetadata;
   flRecParameters.outputFile = clArgs.outputFile;
@@ -109,6 +119,30 @@ void do_configure(int argc, char* argv[], FLReconstructParams& flRecParameters)
     flRecParameters.moduloEvents = falaise::properties::getValueOrDefault<int>(
         basicSystem, "moduloEvents", flRecParameters.moduloEvents);
 
+    // Number of worker threads:
+    flRecParameters.numberOfThreads = falaise::properties::getValueOrDefault<int>(
+        basicSystem, "numberOfThreads", flRecParameters.numberOfThreads);
+
+    // Number of processes:
+    flRecParameters.numberOfJobs = falaise::properties::getValueOrDefault<int>(
+        basicSystem, "numberOfJobs", flRecParameters.numberOfJobs);
+
+    // Asynchronous input/output of event records:
+    flRecParameters.asynchronousIO = falaise::properties::getValueOrDefault<bool>(
+        basicSystem, "asynchronousIO", flRecParameters.asynchronousIO);
+
+    // Recycling of the data banks storage:
+    flRecParameters.recycleBanks = falaise::properties::getValueOrDefault<bool>(
+        basicSystem, "recycleBanks", flRecParameters.recycleBanks);
+
+    // Labels of the input banks to keep:
+    flRecParameters.keptBanks = falaise::properties::getValueOrDefault<std::vector<std::string>>(
+        basicSystem, "keptBanks", flRecParameters.keptBanks);
+
+    // Per-module profiling report:
+    flRecParameters.profileReport = falaise::properties::getValueOrDefault<std::string>(
+        basicSystem, "profileReport", flRecParameters.profileReport);
+
     // Printing rate for events:
     flRecParameters.userProfile = falaise::properties::getValueOrDefault<std::string>(
         basicSystem, "userprofile", flRecParameters.userProfile);
@@ -132,6 +166,13 @@ void do_configure(int argc, char* argv[], FLReconstructParams& flRecParameters)
     //                                                                       flRecParameters.expectedOutputBanks);
   }
 
+  if (flRecParameters.numberOfThreads == 0) {
+    DT_THROW(FLConfigUserError, "Number of worker threads must be at least 1!");
+  }
+  if (flRecParameters.numberOfJobs == 0) {
+    DT_THROW(FLConfigUserError, "Number of processes must be at least 1!");
+  }
+
   // Fetch variant service configuration:
   if (flRecConfig.has_key_with_meta("flreconstruct.variantService", "flreconstruct::section")) {
     datatools::properties variantSubsystem =
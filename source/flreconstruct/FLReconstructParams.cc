@@ -1,6 +1,10 @@
 // Ourselves
 #include "FLReconstructParams.h"
 
+// Third Party
+// - Boost
+#include <boost/algorithm/string/join.hpp>
+
 namespace FLReconstruct {
 
 // static
@@ -16,8 +20,13 @@ FLReconstructParams FLReconstructParams::makeDefault() {
   // Application specific parameters:
   params.logLevel = datatools::logger::PRIO_ERROR;
   params.userProfile = "normal";
-  params.numberOfEvents = 0;  // 0 == no limit on event loop
-  params.moduloEvents = 0;    // 0 == no print
+  params.numberOfEvents = 0;   // 0 == no limit on event loop
+  params.moduloEvents = 0;     // 0 == no print
+  params.numberOfThreads = 1;  // 1 == sequential processing
+  params.asynchronousIO = false;
+  params.recycleBanks = false;
+  params.profileReport = "";  // "" == no profiling
+  params.numberOfJobs = 1;    // 1 == single process
 
   // Experimental setup:
   params.experimentalSetupUrn = "";  // "urn:snemo:demonstrator:setup:1.0";
@@ -40,6 +49,10 @@ FLReconstructParams FLReconstructParams::makeDefault() {
   // I/O:
   params.inputMetadataFile = "";
   params.inputFile = "";
+  params.inputFiles.clear();
+  params.inputFirstEntry = 0;
+  params.inputNumberOfEntries = 0;  // 0 == all entries
+  params.keptBanks.clear();         // empty == all banks
   params.outputMetadataFile = "";
   params.embeddedMetadata = true;
   params.outputFile = "";
@@ -78,6 +91,12 @@ void FLReconstructParams::print(std::ostream& out_) const {
   out_ << tag << "userProfile                = " << userProfile << std::endl;
   out_ << tag << "numberOfEvents               = " << numberOfEvents << std::endl;
   out_ << tag << "moduloEvents                 = " << moduloEvents << std::endl;
+  out_ << tag << "numberOfThreads              = " << numberOfThreads << std::endl;
+  out_ << tag << "asynchronousIO               = " << std::boolalpha << asynchronousIO
+       << std::endl;
+  out_ << tag << "recycleBanks                 = " << std::boolalpha << recycleBanks << std::endl;
+  out_ << tag << "profileReport                = " << profileReport << std::endl;
+  out_ << tag << "numberOfJobs                 = " << numberOfJobs << std::endl;
   out_ << tag << "experimentalSetupUrn         = " << experimentalSetupUrn << std::endl;
   out_ << tag << "reconstructionPipelineUrn    = " << reconstructionPipelineUrn << std::endl;
   out_ << tag << "reconstructionPipelineConfig = " << reconstructionPipelineConfig << std::endl;
@@ -90,6 +109,11 @@ void FLReconstructParams::print(std::ostream& out_) const {
   out_ << tag << "servicesSubsystemConfig      = " << servicesSubsystemConfig << std::endl;
   out_ << tag << "inputMetadataFile            = " << inputMetadataFile << std::endl;
   out_ << tag << "inputFile                    = " << inputFile << std::endl;
+  out_ << tag << "inputFiles                   = " << inputFiles.size() << std::endl;
+  out_ << tag << "inputFirstEntry              = " << inputFirstEntry << std::endl;
+  out_ << tag << "inputNumberOfEntries         = " << inputNumberOfEntries << std::endl;
+  out_ << tag << "keptBanks                    = " << boost::algorithm::join(keptBanks, ",")
+       << std::endl;
   out_ << tag << "outputMetadataFile           = " << outputMetadataFile << std::endl;
   out_ << tag << "embeddedMetadata             = " << std::boolalpha << embeddedMetadata
        << std::endl;
@@ -16,7 +16,9 @@
 #define FLRECONSTRUCTPARAMS_H
 
 // Standard Library:
+#include <cstddef>
 #include <string>
+#include <vector>
 
 // Third Party
 // - Bayeux
@@ -33,6 +35,12 @@ struct FLReconstructParams {
   std::string userProfile;               //!< User profile
   unsigned int numberOfEvents;           //!< Number of events to be processed in the pipeline
   unsigned int moduloEvents;             //!< Number of events progress modulo
+  unsigned int numberOfThreads;          //!< Number of worker threads running the pipeline
+  bool asynchronousIO;                   //!< Flag to read/write event records in dedicated threads
+  bool recycleBanks;                     //!< Flag to reuse the data banks storage across events
+  std::string profileReport;             //!< JSON file for the per-module profiling report
+                                         //!< (no profiling if empty)
+  unsigned int numberOfJobs;             //!< Number of processes sharing the input entries
 
   // Required experimental setup and versioning:
   std::string experimentalSetupUrn;  //!< The URN of the experimental setup
@@ -48,11 +56,15 @@ struct FLReconstructParams {
   std::string servicesSubsystemConfig;     //!< The main configuration file for the service manager
 
   // Reconstruction control:
-  std::string inputMetadataFile;   //!< Input metadata file
-  std::string inputFile;           //!< Input data file for the input module
-  std::string outputMetadataFile;  //!< Output metadata file
-  bool embeddedMetadata;           //!< Flag to embed metadata in the output data file
-  std::string outputFile;          //!< Output data file for the output module
+  std::string inputMetadataFile;        //!< Input metadata file
+  std::string inputFile;                //!< Input data file for the input module
+  std::vector<std::string> inputFiles;  //!< Input data files (used instead of inputFile if set)
+  std::size_t inputFirstEntry;          //!< Index of the first input entry to process
+  std::size_t inputNumberOfEntries;     //!< Number of input entries to process (0 == all)
+  std::vector<std::string> keptBanks;   //!< Labels of the input banks to keep (all if empty)
+  std::string outputMetadataFile;       //!< Output metadata file
+  bool embeddedMetadata;                //!< Flag to embed metadata in the output data file
+  std::string outputFile;               //!< Output data file for the output module
 
   // // Description of the data to be processed by the FLReconstruct script:
   // std::string dataType;              //!< The type of data ("Real", "MC")
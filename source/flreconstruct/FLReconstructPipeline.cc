@@ -3,7 +3,13 @@
 
 // Standard Library
 #include <exception>
+#include <fstream>
+#include <iostream>
 #include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
 
 // Third Party
 // - Boost
@@ -24,11 +30,158 @@
 
 // This Project:
 #include "FLReconstructImpl.h"
+#include "FLReconstructProfiler.h"
+#include "FLReconstructRecordIO.h"
+#include "FLReconstructWorkerPool.h"
 #include "falaise/resource.h"
 #include "falaise/snemo/processing/services.h"
 
 namespace FLReconstruct {
 
+namespace {
+
+//! Load the processing modules in a module manager
+void load_pipeline_modules(const FLReconstructParams& flRecParameters,
+                           dpp::module_manager& moduleManager) {
+  if (!flRecParameters.modulesConfig.empty()) {
+    moduleManager.load_modules(flRecParameters.modulesConfig);
+  } else {
+    // Hand configure a dumb dump module
+    datatools::properties dumbConfig;
+    dumbConfig.store("title", "flreconstruct::default");
+    dumbConfig.store("output", "cout");
+    moduleManager.load_module(flRecParameters.reconstructionPipelineModule, "dpp::dump_module",
+                              dumbConfig);
+  }
+}
+
+//! Return the names of the modules chained by the pipeline module, or the name
+//! of the pipeline module itself if it is not a dpp::chain_module
+std::vector<std::string> get_pipeline_module_names(const FLReconstructParams& flRecParameters) {
+  const std::string& pipelineName = flRecParameters.reconstructionPipelineModule;
+  std::vector<std::string> moduleNames;
+  if (flRecParameters.modulesConfig.has_key_with_meta(pipelineName, "dpp::chain_module")) {
+    const datatools::properties& chainConfig =
+        flRecParameters.modulesConfig.get_section(pipelineName);
+    if (chainConfig.has_key("modules")) {
+      chainConfig.fetch("modules", moduleNames);
+    }
+  }
+  if (moduleNames.empty()) {
+    moduleNames.push_back(pipelineName);
+  }
+  return moduleNames;
+}
+
+//! Check the status of a processed record, write it and count it
+//! Return false if the event loop must be stopped
+bool handle_record(const FLReconstructParams& flRecParameters, const dpp::base_module& pipeline,
+                   dpp::base_module::process_status pStatus,
+                   std::unique_ptr<datatools::things> workItem, RecordPool& recordPool,
+                   RecordSink& recordSink, std::size_t& eventCounter) {
+  DT_THROW_IF(pStatus == dpp::base_module::PROCESS_INVALID, std::logic_error,
+              "Bug!!! Module '" << pipeline.get_name()
+                                << "' did not return a valid processing status!");
+
+  // FATAL, ERROR and ERROR_STOP status triggers the abortion of the processing loop.
+  // This is a very conservative approach, but it is compatible with the default behaviour of
+  // the bxdpp_processing executable.
+  if (pStatus == dpp::base_module::PROCESS_FATAL) return false;
+  if (pStatus == dpp::base_module::PROCESS_ERROR) return false;
+  if (pStatus == dpp::base_module::PROCESS_ERROR_STOP) return false;
+
+  // STOP means the current event should not be processed anymore nor saved
+  // but the loop can continue with other items
+  if (pStatus == dpp::base_module::PROCESS_STOP) {
+    recordPool.release(std::move(workItem));
+    return true;
+  }
+
+  // Check post-conditions on event model (expectedOutputBanks) ?
+
+  // Write item
+  if (!recordSink.write(std::move(workItem))) {
+    return false;
+  }
+  if (flRecParameters.moduloEvents > 0) {
+    if (eventCounter % flRecParameters.moduloEvents == 0) {
+      DT_LOG_NOTICE(datatools::logger::PRIO_NOTICE, "Event #" << eventCounter);
+    }
+  }
+  eventCounter++;
+  if (flRecParameters.numberOfEvents > 0 && eventCounter > flRecParameters.numberOfEvents) {
+    return false;
+  }
+  return true;
+}
+
+//! Run the event loop with a single pipeline instance in the calling thread
+void run_event_loop(const FLReconstructParams& flRecParameters, dpp::base_module& pipeline,
+                    RecordSource& recordSource, RecordPool& recordPool, RecordSink& recordSink) {
+  std::size_t eventCounter = 0;
+  while (true) {
+    // Prepare and read work
+    std::unique_ptr<datatools::things> workItem = recordSource.next();
+    if (!workItem) break;
+
+    // Check pre-conditions on event model (requiredInputBanks) ?
+
+    // Feed through pipeline
+    dpp::base_module::process_status pStatus = pipeline.process(*workItem);
+    if (!handle_record(flRecParameters, pipeline, pStatus, std::move(workItem), recordPool,
+                       recordSink, eventCounter)) {
+      break;
+    }
+  }
+}
+
+//! Run the event loop with one pipeline instance per worker thread
+//!
+//! Records are fetched from the source and handed to the sink by the
+//! calling thread, in input order.
+void run_parallel_event_loop(const FLReconstructParams& flRecParameters,
+                             const std::vector<dpp::base_module*>& pipelines,
+                             RecordSource& recordSource, RecordPool& recordPool,
+                             RecordSink& recordSink) {
+  // Bound the number of records read ahead of the writer, so that a slow
+  // event cannot make the reorder buffer grow without limit:
+  const std::size_t maxInFlight = 4 * pipelines.size();
+  WorkerPool workers(pipelines);
+  std::size_t eventCounter = 0;
+  bool inputDone = false;
+  while (true) {
+    // Keep the workers fed while there is room for more records
+    if (!inputDone && workers.in_flight() < maxInFlight) {
+      std::unique_ptr<datatools::things> workItem = recordSource.next();
+      if (!workItem) {
+        inputDone = true;
+      } else {
+        workers.submit(std::move(workItem));
+      }
+    }
+
+    if (workers.in_flight() == 0) {
+      if (inputDone) break;
+      continue;
+    }
+
+    // Write back processed records in input order, only waiting for
+    // the workers when no more records can be read
+    bool mustWait = inputDone || workers.in_flight() >= maxInFlight;
+    if (!mustWait && !workers.has_next()) continue;
+    EventSlot slot = workers.next();
+    if (slot.error) {
+      std::rethrow_exception(slot.error);
+    }
+    if (!handle_record(flRecParameters, *pipelines.front(), slot.status, std::move(slot.item),
+                       recordPool, recordSink, eventCounter)) {
+      break;
+    }
+  }
+}
+
+}  // namespace
+
 //! Configure and run the pipeline
 falaise::exit_code do_pipeline(const FLReconstructParams& flRecParameters) {
   DT_LOG_TRACE_ENTERING(flRecParameters.logLevel);
@@ -99,16 +252,7 @@ falaise::exit_code do_pipeline(const FLReconstructParams& flRecParameters) {
     DT_LOG_DEBUG(flRecParameters.logLevel, "Service manager is now plugged in the module manager.");
 
     // Configure the modules themselves
-    if (!flRecParameters.modulesConfig.empty()) {
-      moduleManager->load_modules(flRecParameters.modulesConfig);
-    } else {
-      // Hand configure a dumb dump module
-      datatools::properties dumbConfig;
-      dumbConfig.store("title", "flreconstruct::default");
-      dumbConfig.store("output", "cout");
-      moduleManager->load_module(flRecParameters.reconstructionPipelineModule, "dpp::dump_module",
-                                 dumbConfig);
-    }
+    load_pipeline_modules(flRecParameters, *moduleManager);
 
     datatools::library_loader altLibLoader;
     // Load a Things2Root module in the manager before initialization
@@ -131,7 +275,11 @@ falaise::exit_code do_pipeline(const FLReconstructParams& flRecParameters) {
     std::unique_ptr<dpp::input_module> recInput(new dpp::input_module);
     DT_LOG_DEBUG(flRecParameters.logLevel, "Configuring the input module...");
     recInput->set_logging_priority(flRecParameters.logLevel);
-    recInput->set_single_input_file(flRecParameters.inputFile);
+    if (!flRecParameters.inputFiles.empty()) {
+      recInput->set_list_of_input_files(flRecParameters.inputFiles);
+    } else {
+      recInput->set_single_input_file(flRecParameters.inputFile);
+    }
     recInput->initialize_simple();
 
     DT_LOG_DEBUG(flRecParameters.logLevel,
@@ -157,6 +305,44 @@ falaise::exit_code do_pipeline(const FLReconstructParams& flRecParameters) {
       return falaise::EXIT_UNAVAILABLE;
     }
 
+    // Additional pipeline instances for worker threads, each one from its own module manager
+    // (the output module only lives in the main one):
+    std::vector<std::unique_ptr<dpp::module_manager>> workerModuleManagers;
+    std::vector<dpp::base_module*> workerPipelines{pipeline};
+    for (unsigned int iWorker = 1; iWorker < flRecParameters.numberOfThreads; iWorker++) {
+      DT_LOG_DEBUG(flRecParameters.logLevel,
+                   "Configuring the module manager for worker #" << iWorker << "...");
+      std::unique_ptr<dpp::module_manager> workerManager(new dpp::module_manager);
+      workerManager->set_service_manager(recServices);
+      load_pipeline_modules(flRecParameters, *workerManager);
+      workerManager->initialize_simple();
+      workerPipelines.push_back(
+          &(workerManager->grab(flRecParameters.reconstructionPipelineModule)));
+      workerModuleManagers.push_back(std::move(workerManager));
+    }
+
+    // Per-module profiling: each worker runs the modules of the pipeline through
+    // its own timing wrapper, recording in its own profiler
+    std::vector<std::unique_ptr<ModuleProfiler>> profilers;
+    std::vector<std::unique_ptr<ProfiledPipeline>> profiledPipelines;
+    if (!flRecParameters.profileReport.empty()) {
+      DT_LOG_DEBUG(flRecParameters.logLevel, "Setting up per-module profiling...");
+      const std::string& pipelineName = flRecParameters.reconstructionPipelineModule;
+      std::vector<std::string> moduleNames = get_pipeline_module_names(flRecParameters);
+      for (std::size_t iWorker = 0; iWorker < workerPipelines.size(); iWorker++) {
+        dpp::module_manager& workerManager =
+            (iWorker == 0 ? *moduleManager : *workerModuleManagers[iWorker - 1]);
+        std::vector<dpp::base_module*> modules;
+        for (const std::string& moduleName : moduleNames) {
+          modules.push_back(&workerManager.grab(moduleName));
+        }
+        profilers.emplace_back(new ModuleProfiler(pipelineName, moduleNames));
+        profiledPipelines.emplace_back(
+            new ProfiledPipeline(pipelineName, modules, *profilers.back()));
+        workerPipelines[iWorker] = profiledPipelines.back().get();
+      }
+    }
+
     // Output module... only if added in the module manager
     dpp::base_module* recOutputHandle = nullptr;
     std::unique_ptr<dpp::output_module> flRecOutput;
@@ -187,60 +373,87 @@ falaise::exit_code do_pipeline(const FLReconstructParams& flRecParameters) {
 
     // - Now the actual event loop
     DT_LOG_DEBUG(flRecParameters.logLevel, "begin event loop");
-    datatools::things workItem;
-    std::size_t eventCounter = 0;
-    while (true) {
-      // Prepare and read work
-      workItem.clear();
-      if (recInput->is_terminated()) break;
-      if (recInput->process(workItem) != dpp::base_module::PROCESS_OK) {
-        DT_LOG_FATAL(flRecParameters.logLevel, "Failed to read data record from input source");
-        break;
-      }
-
-      // Check pre-conditions on event model (requiredInputBanks) ?
-
-      // Feed through pipeline
-      dpp::base_module::process_status pStatus = pipeline->process(workItem);
-      DT_THROW_IF(pStatus == dpp::base_module::PROCESS_INVALID, std::logic_error,
-                  "Bug!!! Module '" << pipeline->get_name()
-                                    << "' did not return a valid processing status!");
-
-      // FATAL, ERROR and ERROR_STOP status triggers the abortion of the processing loop.
-      // This is a very conservative approach, but it is compatible with the default behaviour of
-      // the bxdpp_processing executable.
-      if (pStatus == dpp::base_module::PROCESS_FATAL) break;
-      if (pStatus == dpp::base_module::PROCESS_ERROR) break;
-      if (pStatus == dpp::base_module::PROCESS_ERROR_STOP) break;
-
-      // STOP means the current event should not be processed anymore nor saved
-      // but the loop can continue with other items
-      if (pStatus == dpp::base_module::PROCESS_STOP) continue;
-
-      // Check post-conditions on event model (expectedOutputBanks) ?
-
-      // Write item
-      if (recOutputHandle) {
-        pStatus = recOutputHandle->process(workItem);
-        if (pStatus != dpp::base_module::PROCESS_OK) {
-          DT_LOG_FATAL(flRecParameters.logLevel, "Failed to write data record to output sink");
-          break;
+    {
+      // Records are read and written either in the event loop thread or, with asynchronous
+      // I/O, in dedicated threads overlapping with the processing:
+      RecordPool recordPool(flRecParameters.recycleBanks,
+                            std::set<std::string>(flRecParameters.keptBanks.begin(),
+                                                  flRecParameters.keptBanks.end()));
+      std::unique_ptr<RecordSource> recordSource;
+      std::unique_ptr<RecordSink> recordSink;
+      // Restrict the input to the requested range of entries, seeking directly to the
+      // first one when the input format allows it:
+      if (flRecParameters.inputFirstEntry > 0 && flRecParameters.inputFiles.empty() &&
+          is_seekable_input(flRecParameters.inputFile)) {
+        DT_LOG_DEBUG(flRecParameters.logLevel,
+                     "Starting at input entry #" << flRecParameters.inputFirstEntry);
+        recordSource.reset(new BrioInput(flRecParameters.inputFile, recordPool,
+                                         flRecParameters.logLevel, flRecParameters.inputFirstEntry,
+                                         flRecParameters.inputNumberOfEntries));
+      } else {
+        if (flRecParameters.inputFirstEntry > 0) {
+          DT_LOG_NOTICE(flRecParameters.logLevel,
+                        "Input format is not seekable, skipping the first "
+                            << flRecParameters.inputFirstEntry << " input entries...");
+          skip_records(*recInput, flRecParameters.inputFirstEntry);
         }
+        recordSource.reset(new DirectInput(*recInput, recordPool, flRecParameters.logLevel,
+                                           flRecParameters.inputNumberOfEntries));
       }
-      if (flRecParameters.moduloEvents > 0) {
-        if (eventCounter % flRecParameters.moduloEvents == 0) {
-          DT_LOG_NOTICE(datatools::logger::PRIO_NOTICE, "Event #" << eventCounter);
+      if (flRecParameters.asynchronousIO) {
+        const std::size_t queueCapacity = 4 * workerPipelines.size();
+        DT_LOG_DEBUG(flRecParameters.logLevel, "using asynchronous input/output");
+        recordSource.reset(new ReadAheadInput(std::move(recordSource), queueCapacity));
+        if (recOutputHandle != nullptr) {
+          recordSink.reset(new WriteBehindOutput(*recOutputHandle, recordPool, queueCapacity,
+                                                 flRecParameters.logLevel));
         }
       }
-      eventCounter++;
-      if (flRecParameters.numberOfEvents > 0 && eventCounter > flRecParameters.numberOfEvents) {
-        break;
+      if (!recordSink) {
+        recordSink.reset(new DirectOutput(recOutputHandle, recordPool, flRecParameters.logLevel));
+      }
+
+      if (workerPipelines.size() > 1) {
+        DT_LOG_DEBUG(flRecParameters.logLevel,
+                     "using " << workerPipelines.size() << " worker threads");
+        run_parallel_event_loop(flRecParameters, workerPipelines, *recordSource, recordPool,
+                                *recordSink);
+      } else {
+        run_event_loop(flRecParameters, *workerPipelines.front(), *recordSource, recordPool,
+                       *recordSink);
+      }
+      // Stop reading ahead and write all pending records before closing the output
+      recordSource.reset();
+      if (!recordSink->finish()) {
+        DT_LOG_ERROR(flRecParameters.logLevel, "Failed to write all data records!");
+        code = falaise::EXIT_UNAVAILABLE;
       }
     }
     DT_LOG_DEBUG(flRecParameters.logLevel, "event loop completed");
 
-    // - MUST delete the module manager BEFORE the library loader clears
-    // in case the manager is holding resources created from a shared lib
+    // Profiling report:
+    if (!profilers.empty()) {
+      ModuleProfiler& profile = *profilers.front();
+      for (std::size_t iWorker = 1; iWorker < profilers.size(); iWorker++) {
+        profile.merge(*profilers[iWorker]);
+      }
+      profile.print(std::cout);
+      std::string reportPath = flRecParameters.profileReport;
+      datatools::fetch_path_with_env(reportPath);
+      std::ofstream reportFile(reportPath.c_str());
+      DT_THROW_IF(!reportFile, std::runtime_error,
+                  "Cannot open profiling report file '" << reportPath << "'!");
+      profile.write_json(reportFile);
+    }
+
+    // - MUST delete the module managers BEFORE the library loader clears
+    // in case the managers are holding resources created from a shared lib
+    for (std::unique_ptr<dpp::module_manager>& workerManager : workerModuleManagers) {
+      if (workerManager->is_initialized()) {
+        workerManager->reset();
+      }
+      workerManager.reset();
+    }
     if (moduleManager.get() != nullptr) {
       if (moduleManager->is_initialized()) {
         moduleManager->reset();
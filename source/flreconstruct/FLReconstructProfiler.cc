@@ -0,0 +1,228 @@
+// Ourselves
+#include "FLReconstructProfiler.h"
+
+// Standard Library
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <stdexcept>
+#include <time.h>
+
+// Third Party
+// - Boost
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+// - Bayeux
+#include "bayeux/datatools/exception.h"
+
+namespace FLReconstruct {
+
+namespace {
+
+//! Lower edge of the latency histograms
+const double kMinTime = 1.0e-7;
+//! Number of histogram bins per decade of time
+const std::size_t kBinsPerDecade = 10;
+//! Number of histogram bins, including underflow (first) and overflow (last)
+const std::size_t kNumberOfBins = 10 * kBinsPerDecade + 2;
+
+std::size_t bin_index(double t) {
+  if (t < kMinTime) return 0;
+  double position = std::log10(t / kMinTime) * kBinsPerDecade;
+  return std::min(static_cast<std::size_t>(position) + 1, kNumberOfBins - 1);
+}
+
+//! Return the CPU time consumed by the calling thread, in seconds
+double thread_cpu_time() {
+  struct timespec ts;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+    return 0.0;
+  }
+  return ts.tv_sec + 1.0e-9 * ts.tv_nsec;
+}
+
+//! Return a string quoted and escaped as a JSON string
+std::string json_quote(const std::string& text) {
+  std::string quoted = "\"";
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      quoted += '\\';
+    }
+    quoted += c;
+  }
+  quoted += '"';
+  return quoted;
+}
+
+}  // namespace
+
+ModuleProfiler::ModuleProfiler(const std::string& pipelineName,
+                               const std::vector<std::string>& moduleNames) {
+  entries_.resize(moduleNames.size() + 1);
+  entries_[0].name = pipelineName;
+  for (std::size_t i = 0; i < moduleNames.size(); i++) {
+    entries_[i + 1].name = moduleNames[i];
+  }
+  for (Entry& entry : entries_) {
+    entry.wallHistogram.assign(kNumberOfBins, 0);
+  }
+}
+
+std::size_t ModuleProfiler::size() const { return entries_.size(); }
+
+void ModuleProfiler::record(std::size_t index, double wallTime, double cpuTime) {
+  Entry& entry = entries_[index];
+  entry.count++;
+  entry.wallSum += wallTime;
+  entry.wallMax = std::max(entry.wallMax, wallTime);
+  entry.cpuSum += cpuTime;
+  entry.wallHistogram[bin_index(wallTime)]++;
+}
+
+void ModuleProfiler::merge(const ModuleProfiler& other) {
+  DT_THROW_IF(other.entries_.size() != entries_.size(), std::logic_error,
+              "Cannot merge profiles of different pipelines!");
+  for (std::size_t i = 0; i < entries_.size(); i++) {
+    Entry& entry = entries_[i];
+    const Entry& otherEntry = other.entries_[i];
+    entry.count += otherEntry.count;
+    entry.wallSum += otherEntry.wallSum;
+    entry.wallMax = std::max(entry.wallMax, otherEntry.wallMax);
+    entry.cpuSum += otherEntry.cpuSum;
+    for (std::size_t bin = 0; bin < kNumberOfBins; bin++) {
+      entry.wallHistogram[bin] += otherEntry.wallHistogram[bin];
+    }
+  }
+}
+
+// static
+double ModuleProfiler::quantile(const Entry& entry, double fraction) {
+  if (entry.count == 0) return 0.0;
+  std::size_t threshold = static_cast<std::size_t>(std::ceil(fraction * entry.count));
+  std::size_t cumulated = 0;
+  std::size_t bin = 0;
+  for (; bin < kNumberOfBins; bin++) {
+    cumulated += entry.wallHistogram[bin];
+    if (cumulated >= threshold) break;
+  }
+  if (bin == 0) return std::min(kMinTime, entry.wallMax);
+  // Geometric center of the bin, never beyond the observed maximum
+  double center = kMinTime * std::pow(10.0, (bin - 0.5) / kBinsPerDecade);
+  return std::min(center, entry.wallMax);
+}
+
+void ModuleProfiler::print(std::ostream& out) const {
+  const double ms = 1.0e3;
+  const std::ios_base::fmtflags flags = out.flags();
+  const std::streamsize precision = out.precision();
+  out << "Pipeline profile (times per event in ms):" << std::endl;
+  out << std::left << std::setw(32) << "module" << std::right << std::setw(10) << "events"
+      << std::setw(12) << "mean" << std::setw(12) << "p50" << std::setw(12) << "p99"
+      << std::setw(12) << "max" << std::setw(12) << "cpu mean" << std::endl;
+  out << std::fixed << std::setprecision(3);
+  for (const Entry& entry : entries_) {
+    double n = entry.count > 0 ? entry.count : 1.0;
+    out << std::left << std::setw(32) << entry.name << std::right << std::setw(10)
+        << entry.count << std::setw(12) << ms * entry.wallSum / n << std::setw(12)
+        << ms * quantile(entry, 0.50) << std::setw(12) << ms * quantile(entry, 0.99)
+        << std::setw(12) << ms * entry.wallMax << std::setw(12) << ms * entry.cpuSum / n
+        << std::endl;
+  }
+  out.flags(flags);
+  out.precision(precision);
+}
+
+void ModuleProfiler::write_json(std::ostream& out) const {
+  const std::streamsize precision = out.precision();
+  out << "{\n  \"unit\": \"s\",\n  \"modules\": [";
+  out << std::setprecision(9);
+  for (std::size_t i = 0; i < entries_.size(); i++) {
+    const Entry& entry = entries_[i];
+    double n = entry.count > 0 ? entry.count : 1.0;
+    out << (i > 0 ? ",\n" : "\n") << "    {\"name\": " << json_quote(entry.name)
+        << ", \"pipeline\": " << (i == 0 ? "true" : "false") << ", \"events\": " << entry.count
+        << ", \"wall_mean\": " << entry.wallSum / n << ", \"wall_p50\": " << quantile(entry, 0.50)
+        << ", \"wall_p99\": " << quantile(entry, 0.99) << ", \"wall_max\": " << entry.wallMax
+        << ", \"wall_total\": " << entry.wallSum << ", \"cpu_mean\": " << entry.cpuSum / n
+        << ", \"cpu_total\": " << entry.cpuSum << ", \"wall_histogram\": [";
+    for (std::size_t bin = 0; bin < kNumberOfBins; bin++) {
+      out << (bin > 0 ? "," : "") << entry.wallHistogram[bin];
+    }
+    out << "]}";
+  }
+  out << "\n  ]\n}\n";
+  out.precision(precision);
+}
+
+// static
+ModuleProfiler ModuleProfiler::read_json(std::istream& in) {
+  boost::property_tree::ptree report;
+  boost::property_tree::read_json(in, report);
+  std::vector<Entry> entries;
+  for (const auto& module : report.get_child("modules")) {
+    const boost::property_tree::ptree& fields = module.second;
+    Entry entry;
+    entry.name = fields.get<std::string>("name");
+    entry.count = fields.get<std::size_t>("events");
+    entry.wallSum = fields.get<double>("wall_total");
+    entry.wallMax = fields.get<double>("wall_max");
+    entry.cpuSum = fields.get<double>("cpu_total");
+    for (const auto& bin : fields.get_child("wall_histogram")) {
+      entry.wallHistogram.push_back(bin.second.get_value<std::size_t>());
+    }
+    DT_THROW_IF(entry.wallHistogram.size() != kNumberOfBins, std::runtime_error,
+                "Invalid latency histogram of module '" << entry.name << "'!");
+    entries.push_back(entry);
+  }
+  DT_THROW_IF(entries.empty(), std::runtime_error, "No pipeline in profiling report!");
+  ModuleProfiler profiler(entries.front().name, std::vector<std::string>(entries.size() - 1));
+  profiler.entries_ = entries;
+  return profiler;
+}
+
+ProfiledPipeline::ProfiledPipeline(const std::string& name,
+                                   const std::vector<dpp::base_module*>& modules,
+                                   ModuleProfiler& profiler)
+    : modules_(modules), profiler_(profiler) {
+  DT_THROW_IF(profiler_.size() != modules_.size() + 1, std::logic_error,
+              "Profiler does not match the modules of pipeline '" << name << "'!");
+  set_name(name);
+  _set_initialized(true);
+}
+
+ProfiledPipeline::~ProfiledPipeline() {
+  if (is_initialized()) {
+    ProfiledPipeline::reset();
+  }
+}
+
+void ProfiledPipeline::initialize(const datatools::properties& /*setup*/,
+                                  datatools::service_manager& /*services*/,
+                                  dpp::module_handle_dict_type& /*modules*/) {
+  DT_THROW_IF(is_initialized(), std::logic_error,
+              "Module '" << get_name() << "' is already initialized ! ");
+  _set_initialized(true);
+}
+
+void ProfiledPipeline::reset() { _set_initialized(false); }
+
+dpp::base_module::process_status ProfiledPipeline::process(datatools::things& data) {
+  typedef std::chrono::steady_clock clock_type;
+  const clock_type::time_point pipelineStart = clock_type::now();
+  const double pipelineCpuStart = thread_cpu_time();
+  process_status status = PROCESS_OK;
+  for (std::size_t i = 0; i < modules_.size(); i++) {
+    const clock_type::time_point start = clock_type::now();
+    const double cpuStart = thread_cpu_time();
+    status = modules_[i]->process(data);
+    const std::chrono::duration<double> wallTime = clock_type::now() - start;
+    profiler_.record(i + 1, wallTime.count(), thread_cpu_time() - cpuStart);
+    if (status != PROCESS_OK) break;
+  }
+  const std::chrono::duration<double> pipelineWallTime = clock_type::now() - pipelineStart;
+  profiler_.record(0, pipelineWallTime.count(), thread_cpu_time() - pipelineCpuStart);
+  return status;
+}
+
+}  // namespace FLReconstruct
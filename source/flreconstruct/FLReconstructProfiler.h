@@ -0,0 +1,108 @@
+// FLReconstructProfiler.h - Per-module profiling of the FLReconstruct pipeline
+
+// Distributed under the OSI-approved BSD 3-Clause License (the "License");
+// see accompanying file License.txt for details.
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even the
+// implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the License for more information.
+
+#ifndef FLRECONSTRUCTPROFILER_H
+#define FLRECONSTRUCTPROFILER_H
+
+// Standard Library
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Third Party
+// - Bayeux
+#include "bayeux/datatools/things.h"
+#include "bayeux/dpp/base_module.h"
+
+namespace FLReconstruct {
+
+//! \brief Per-event wall-clock and CPU time statistics of pipeline modules
+//!
+//! Wall-clock latencies are accumulated in logarithmic bins (from 100 ns
+//! to 1000 s) so that percentiles can be estimated with bounded memory.
+//! The first entry always describes the whole pipeline.
+class ModuleProfiler {
+ public:
+  //! Construct for the given pipeline and module names
+  ModuleProfiler(const std::string& pipelineName, const std::vector<std::string>& moduleNames);
+
+  //! Return the number of profiled entries (pipeline first, then modules)
+  std::size_t size() const;
+
+  //! Record the times (in seconds) spent by one entry on one event
+  void record(std::size_t index, double wallTime, double cpuTime);
+
+  //! Add the statistics collected by another profiler of the same pipeline
+  void merge(const ModuleProfiler& other);
+
+  //! Print a human readable report
+  void print(std::ostream& out) const;
+
+  //! Write the report in JSON format, with the latency histograms
+  void write_json(std::ostream& out) const;
+
+  //! \brief Read a report written by write_json
+  //!
+  //! The returned profiler holds the statistics of the report and can be
+  //! merged with the profilers of the same pipeline.
+  static ModuleProfiler read_json(std::istream& in);
+
+ private:
+  struct Entry {
+    std::string name;
+    std::size_t count = 0;
+    double wallSum = 0.0;
+    double wallMax = 0.0;
+    double cpuSum = 0.0;
+    std::vector<std::size_t> wallHistogram;
+  };
+
+  //! Return the estimated wall-clock time quantile of an entry
+  static double quantile(const Entry& entry, double fraction);
+
+  std::vector<Entry> entries_;
+};
+
+//! \brief Pipeline wrapper timing each module of a chain
+//!
+//! Runs the given modules in sequence on each record, stopping at the first
+//! one not returning PROCESS_OK, and records their timings in a profiler.
+//! It is not registered in the module factory and is not meant to be
+//! configured from a pipeline script.
+class ProfiledPipeline : public dpp::base_module {
+ public:
+  //! Construct from the ordered modules of a chain and the profiler that
+  //! collects their timings (neither is owned)
+  ProfiledPipeline(const std::string& name, const std::vector<dpp::base_module*>& modules,
+                   ModuleProfiler& profiler);
+
+  ~ProfiledPipeline() override;
+
+  void initialize(const datatools::properties& setup, datatools::service_manager& services,
+                  dpp::module_handle_dict_type& modules) override;
+
+  void reset() override;
+
+  process_status process(datatools::things& data) override;
+
+ private:
+  std::vector<dpp::base_module*> modules_;
+  ModuleProfiler& profiler_;
+};
+
+}  // namespace FLReconstruct
+
+#endif  // FLRECONSTRUCTPROFILER_H
+
+// Local Variables: --
+// mode: c++ --
+// c-file-style: "gnu" --
+// tab-width: 2 --
+// End: --
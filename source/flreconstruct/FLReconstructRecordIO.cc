@@ -0,0 +1,300 @@
+// Ourselves
+#include "FLReconstructRecordIO.h"
+
+// Standard Library
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+// Third Party
+// - Boost
+#include <boost/algorithm/string.hpp>
+// - Bayeux
+#include "bayeux/datatools/exception.h"
+#include "bayeux/datatools/utils.h"
+#include "bayeux/dpp/brio_common.h"
+
+namespace FLReconstruct {
+
+namespace {
+
+//! Clear the banks of type T of a record and move their storage into the store
+template <typename T>
+void stash_banks(datatools::things& item, std::map<std::string, T>& store) {
+  std::vector<std::string> labels;
+  item.get_names(labels);
+  for (const std::string& label : labels) {
+    if (!item.is_a<T>(label) || item.is_constant(label)) continue;
+    T& bank = item.grab<T>(label);
+    bank.clear();
+    bank.swap(store[label]);
+  }
+}
+
+//! Add the stored banks of type T missing from a record and list their labels
+template <typename T>
+void restore_banks(datatools::things& item, std::map<std::string, T>& store,
+                   std::vector<std::string>& labels) {
+  for (auto& stored : store) {
+    if (item.has(stored.first)) continue;
+    item.add<T>(stored.first).swap(stored.second);
+    labels.push_back(stored.first);
+  }
+}
+
+//! Check if a bank holds no data
+bool is_empty_bank(const snemo::datamodel::calibrated_data& bank) {
+  return !bank.has_data() && bank.get_properties().empty();
+}
+
+bool is_empty_bank(const snemo::datamodel::tracker_clustering_data& bank) {
+  return !bank.has_solutions() && bank.get_auxiliaries().empty();
+}
+
+bool is_empty_bank(const snemo::datamodel::tracker_trajectory_data& bank) {
+  return !bank.has_solutions() && bank.get_auxiliaries().empty();
+}
+
+//! Move a bank of type T from a record back into the store if it is still empty
+template <typename T>
+bool return_empty_bank(datatools::things& item, const std::string& label,
+                    std::map<std::string, T>& store) {
+  if (!item.is_a<T>(label)) return false;
+  T& bank = item.grab<T>(label);
+  if (is_empty_bank(bank)) {
+    bank.swap(store[label]);
+    item.remove(label);
+  }
+  return true;
+}
+
+}  // namespace
+
+RecordPool::RecordPool(bool recycleBanks, const std::set<std::string>& keptBanks)
+    : recycleBanks_(recycleBanks), keptBanks_(keptBanks) {}
+
+std::unique_ptr<datatools::things> RecordPool::acquire() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (items_.empty()) {
+    return std::unique_ptr<datatools::things>(new datatools::things);
+  }
+  std::unique_ptr<datatools::things> item = std::move(items_.back());
+  items_.pop_back();
+  return item;
+}
+
+void RecordPool::release(std::unique_ptr<datatools::things> item) {
+  if (!item) return;
+  std::lock_guard<std::mutex> lock(mutex_);
+  restoredBanks_.erase(item.get());
+  if (recycleBanks_) {
+    stash_banks(*item, calibratedData_);
+    stash_banks(*item, trackerClusteringData_);
+    stash_banks(*item, trackerTrajectoryData_);
+  }
+  item->clear();
+  items_.push_back(std::move(item));
+}
+
+void RecordPool::prepare(datatools::things& item) {
+  if (!keptBanks_.empty()) {
+    std::vector<std::string> labels;
+    item.get_names(labels);
+    for (const std::string& label : labels) {
+      if (keptBanks_.count(label) == 0) {
+        item.remove(label);
+      }
+    }
+  }
+  if (!recycleBanks_) return;
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<std::string> labels;
+  restore_banks(item, calibratedData_, labels);
+  restore_banks(item, trackerClusteringData_, labels);
+  restore_banks(item, trackerTrajectoryData_, labels);
+  if (!labels.empty()) {
+    restoredBanks_[&item].swap(labels);
+  }
+}
+
+void RecordPool::finalize(datatools::things& item) {
+  if (!recycleBanks_) return;
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto found = restoredBanks_.find(&item);
+  if (found == restoredBanks_.end()) return;
+  for (const std::string& label : found->second) {
+    if (!item.has(label) || item.is_constant(label)) continue;
+    if (return_empty_bank(item, label, calibratedData_)) continue;
+    if (return_empty_bank(item, label, trackerClusteringData_)) continue;
+    return_empty_bank(item, label, trackerTrajectoryData_);
+  }
+  restoredBanks_.erase(found);
+}
+
+std::size_t skip_records(dpp::input_module& input, std::size_t count) {
+  datatools::things record;
+  std::size_t skipped = 0;
+  while (skipped < count && !input.is_terminated()) {
+    record.clear();
+    if (input.process(record) != dpp::base_module::PROCESS_OK) break;
+    skipped++;
+  }
+  return skipped;
+}
+
+DirectInput::DirectInput(dpp::input_module& input, RecordPool& pool,
+                         datatools::logger::priority logLevel, std::size_t maxRecords)
+    : input_(input), pool_(pool), logLevel_(logLevel), maxRecords_(maxRecords), readRecords_(0) {}
+
+std::unique_ptr<datatools::things> DirectInput::next() {
+  if (input_.is_terminated()) {
+    return nullptr;
+  }
+  if (maxRecords_ > 0 && readRecords_ >= maxRecords_) {
+    return nullptr;
+  }
+  std::unique_ptr<datatools::things> item = pool_.acquire();
+  if (input_.process(*item) != dpp::base_module::PROCESS_OK) {
+    DT_LOG_FATAL(logLevel_, "Failed to read data record from input source");
+    return nullptr;
+  }
+  pool_.prepare(*item);
+  readRecords_++;
+  return item;
+}
+
+bool is_seekable_input(const std::string& inputFile) {
+  return boost::algorithm::ends_with(inputFile, ".brio");
+}
+
+BrioInput::BrioInput(const std::string& inputFile, RecordPool& pool,
+                     datatools::logger::priority logLevel, std::size_t firstEntry,
+                     std::size_t maxRecords)
+    : pool_(pool), logLevel_(logLevel) {
+  const std::string& storeLabel = dpp::brio_common::event_record_store_label();
+  std::string inputPath = inputFile;
+  datatools::fetch_path_with_env(inputPath);
+  reader_.set_logging_priority(logLevel);
+  reader_.open(inputPath);
+  DT_THROW_IF(!reader_.has_store(storeLabel), std::runtime_error,
+              "No event record store in brio file '" << inputPath << "'!");
+  numberOfEntries_ = std::max<int64_t>(reader_.get_number_of_entries(storeLabel), 0);
+  nextEntry_ = std::min(firstEntry, numberOfEntries_);
+  lastEntry_ = numberOfEntries_;
+  if (maxRecords > 0) {
+    lastEntry_ = std::min(lastEntry_, nextEntry_ + maxRecords);
+  }
+}
+
+BrioInput::~BrioInput() {
+  if (reader_.is_opened()) {
+    reader_.close();
+  }
+}
+
+std::size_t BrioInput::get_number_of_entries() const { return numberOfEntries_; }
+
+std::unique_ptr<datatools::things> BrioInput::next() {
+  if (nextEntry_ >= lastEntry_) {
+    return nullptr;
+  }
+  std::unique_ptr<datatools::things> item = pool_.acquire();
+  try {
+    reader_.load(*item, dpp::brio_common::event_record_store_label(), nextEntry_);
+  } catch (std::exception& e) {
+    DT_LOG_FATAL(logLevel_, "Failed to read data record #" << nextEntry_ << " from input source: "
+                                                           << e.what());
+    return nullptr;
+  }
+  pool_.prepare(*item);
+  nextEntry_++;
+  return item;
+}
+
+ReadAheadInput::ReadAheadInput(std::unique_ptr<RecordSource> reader, std::size_t capacity)
+    : reader_(std::move(reader)), queue_(capacity) {
+  thread_ = std::thread(&ReadAheadInput::run_, this);
+}
+
+ReadAheadInput::~ReadAheadInput() {
+  queue_.close();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+std::unique_ptr<datatools::things> ReadAheadInput::next() {
+  std::unique_ptr<datatools::things> item;
+  queue_.pop(item);
+  return item;
+}
+
+void ReadAheadInput::run_() {
+  while (true) {
+    std::unique_ptr<datatools::things> item = reader_->next();
+    if (!item || !queue_.push(std::move(item))) {
+      break;
+    }
+  }
+  // End of input (or consumer gone): let next() return null once drained
+  queue_.close();
+}
+
+DirectOutput::DirectOutput(dpp::base_module* output, RecordPool& pool,
+                           datatools::logger::priority logLevel)
+    : output_(output), pool_(pool), logLevel_(logLevel) {}
+
+bool DirectOutput::write(std::unique_ptr<datatools::things> item) {
+  if (failed_) {
+    return false;
+  }
+  pool_.finalize(*item);
+  if (output_ != nullptr && output_->process(*item) != dpp::base_module::PROCESS_OK) {
+    DT_LOG_FATAL(logLevel_, "Failed to write data record to output sink");
+    failed_ = true;
+  }
+  pool_.release(std::move(item));
+  return !failed_;
+}
+
+bool DirectOutput::finish() { return !failed_; }
+
+WriteBehindOutput::WriteBehindOutput(dpp::base_module& output, RecordPool& pool,
+                                     std::size_t capacity, datatools::logger::priority logLevel)
+    : writer_(&output, pool, logLevel), pool_(pool), queue_(capacity), failed_(false) {
+  thread_ = std::thread(&WriteBehindOutput::run_, this);
+}
+
+WriteBehindOutput::~WriteBehindOutput() { finish(); }
+
+bool WriteBehindOutput::write(std::unique_ptr<datatools::things> item) {
+  if (failed_) {
+    pool_.release(std::move(item));
+    return false;
+  }
+  return queue_.push(std::move(item));
+}
+
+bool WriteBehindOutput::finish() {
+  queue_.close();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  return !failed_;
+}
+
+void WriteBehindOutput::run_() {
+  std::unique_ptr<datatools::things> item;
+  while (queue_.pop(item)) {
+    if (failed_) {
+      // Drain the queue without writing after a failure
+      pool_.release(std::move(item));
+      continue;
+    }
+    if (!writer_.write(std::move(item))) {
+      failed_ = true;
+    }
+  }
+}
+
+}  // namespace FLReconstruct
@@ -0,0 +1,297 @@
+// FLReconstructRecordIO.h - Event record input/output for FLReconstruct
+
+// Distributed under the OSI-approved BSD 3-Clause License (the "License");
+// see accompanying file License.txt for details.
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even the
+// implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the License for more information.
+
+#ifndef FLRECONSTRUCTRECORDIO_H
+#define FLRECONSTRUCTRECORDIO_H
+
+// Standard Library
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Third Party
+// - Bayeux
+#include "bayeux/brio/reader.h"
+#include "bayeux/datatools/logger.h"
+#include "bayeux/datatools/things.h"
+#include "bayeux/dpp/base_module.h"
+#include "bayeux/dpp/input_module.h"
+
+// This Project
+#include "falaise/snemo/datamodels/calibrated_data.h"
+#include "falaise/snemo/datamodels/tracker_clustering_data.h"
+#include "falaise/snemo/datamodels/tracker_trajectory_data.h"
+
+namespace FLReconstruct {
+
+//! \brief Blocking FIFO queue with a maximum capacity
+//!
+//! push() blocks while the queue is full, pop() blocks while it is empty.
+//! Once closed, push() refuses new values and pop() returns false as soon
+//! as the queue is drained.
+template <typename T>
+class BoundedQueue {
+ public:
+  explicit BoundedQueue(std::size_t capacity) : capacity_(capacity > 0 ? capacity : 1) {}
+
+  //! Append a value, return false if the queue has been closed
+  bool push(T value) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    notFull_.wait(lock, [this] { return closed_ || values_.size() < capacity_; });
+    if (closed_) {
+      return false;
+    }
+    values_.push_back(std::move(value));
+    notEmpty_.notify_one();
+    return true;
+  }
+
+  //! Extract the oldest value, return false if the queue is closed and empty
+  bool pop(T& value) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    notEmpty_.wait(lock, [this] { return closed_ || !values_.empty(); });
+    if (values_.empty()) {
+      return false;
+    }
+    value = std::move(values_.front());
+    values_.pop_front();
+    notFull_.notify_one();
+    return true;
+  }
+
+  //! Refuse further values and wake up all waiting threads
+  void close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    notFull_.notify_all();
+    notEmpty_.notify_all();
+  }
+
+ private:
+  std::size_t capacity_;
+  bool closed_ = false;
+  std::deque<T> values_;
+  std::mutex mutex_;
+  std::condition_variable notFull_;
+  std::condition_variable notEmpty_;
+};
+
+//! \brief Thread-safe store of cleared event records available for reuse
+//!
+//! Records must be emptied before being read again, so their banks are
+//! destroyed on release. In bank recycling mode, the hit and solution
+//! collections of the calibrated data, tracker clustering data and tracker
+//! trajectory data banks are cleared and kept by the pool instead, and handed
+//! back by prepare() to the banks of the same labels in the records read
+//! afterwards. Modules then refill these banks without reallocating them.
+//! Only the storage of the collections is recycled: the hits and solutions
+//! they hold are still allocated anew for each event. The banks added by
+//! prepare() and left empty by the modules are removed by finalize() before
+//! the record is written, so the output only holds the banks produced for
+//! each event. However, all modules see the banks added by prepare(), even
+//! before any module filled them: a bank label being present does not mean
+//! that the bank was produced for the current event.
+//!
+//! If a selection of kept banks is set, prepare() also removes the other
+//! banks from the records just read. This only filters what the modules see,
+//! what is written out and the memory held while processing: the records are
+//! still read and decoded whole, so it does not make reading any faster.
+class RecordPool {
+ public:
+  //! \brief Construct a pool
+  //!
+  //! The storage of the data banks is kept if recycleBanks is true. Only the
+  //! input banks whose labels are in keptBanks are kept, unless it is empty.
+  explicit RecordPool(bool recycleBanks = false, const std::set<std::string>& keptBanks = {});
+
+  //! Return an empty record, recycled if possible
+  std::unique_ptr<datatools::things> acquire();
+
+  //! Clear a record and keep it for later reuse
+  void release(std::unique_ptr<datatools::things> item);
+
+  //! \brief Prepare a record just read for processing
+  //!
+  //! Input banks not selected are removed, then the recycled banks missing
+  //! from the record are added empty, with the storage kept from previous
+  //! records.
+  void prepare(datatools::things& item);
+
+  //! \brief Finalize a processed record before it is written
+  //!
+  //! The recycled banks added to the record by prepare() and still empty are
+  //! removed from the record, and their storage is kept by the pool.
+  void finalize(datatools::things& item);
+
+ private:
+  //! Recycled data banks of a given type, by label
+  template <typename T>
+  using BankStore = std::map<std::string, T>;
+
+  bool recycleBanks_;
+  std::set<std::string> keptBanks_;  //!< Labels of the input banks to keep (all if empty)
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<datatools::things>> items_;
+  //! Labels of the recycled banks added to each record being processed
+  std::map<const datatools::things*, std::vector<std::string>> restoredBanks_;
+  BankStore<snemo::datamodel::calibrated_data> calibratedData_;
+  BankStore<snemo::datamodel::tracker_clustering_data> trackerClusteringData_;
+  BankStore<snemo::datamodel::tracker_trajectory_data> trackerTrajectoryData_;
+};
+
+//! Interface of a source of event records
+class RecordSource {
+ public:
+  virtual ~RecordSource() = default;
+
+  //! Return the next record, or a null pointer when no more records are available
+  virtual std::unique_ptr<datatools::things> next() = 0;
+};
+
+//! Interface of a sink of event records
+class RecordSink {
+ public:
+  virtual ~RecordSink() = default;
+
+  //! Take ownership of a record to write it, return false if the output failed
+  virtual bool write(std::unique_ptr<datatools::things> item) = 0;
+
+  //! Write all pending records, return false if the output failed
+  virtual bool finish() = 0;
+};
+
+//! Read and discard records from the input module, return the number of skipped records
+std::size_t skip_records(dpp::input_module& input, std::size_t count);
+
+//! Read records from the input module in the calling thread
+class DirectInput : public RecordSource {
+ public:
+  //! Construct from the input module, optionally reading at most maxRecords records
+  DirectInput(dpp::input_module& input, RecordPool& pool, datatools::logger::priority logLevel,
+              std::size_t maxRecords = 0);
+
+  std::unique_ptr<datatools::things> next() override;
+
+ private:
+  dpp::input_module& input_;
+  RecordPool& pool_;
+  datatools::logger::priority logLevel_;
+  std::size_t maxRecords_;   //!< Maximum number of records to read (0: no limit)
+  std::size_t readRecords_;  //!< Number of records read so far
+};
+
+//! Return true if records of a data file can be read by entry number
+bool is_seekable_input(const std::string& inputFile);
+
+//! \brief Read records by entry number from the event record store of a brio file
+//!
+//! Entries are addressed directly in the store, so that the reading can start
+//! at any entry without decoding the preceding ones.
+class BrioInput : public RecordSource {
+ public:
+  //! Construct from a brio file, reading at most maxRecords records (0: no limit)
+  //! from entry firstEntry
+  BrioInput(const std::string& inputFile, RecordPool& pool, datatools::logger::priority logLevel,
+            std::size_t firstEntry, std::size_t maxRecords = 0);
+
+  ~BrioInput() override;
+
+  //! Return the number of entries in the event record store
+  std::size_t get_number_of_entries() const;
+
+  std::unique_ptr<datatools::things> next() override;
+
+ private:
+  brio::reader reader_;
+  RecordPool& pool_;
+  datatools::logger::priority logLevel_;
+  std::size_t numberOfEntries_;  //!< Number of entries in the event record store
+  std::size_t nextEntry_;        //!< Entry number of the next record to read
+  std::size_t lastEntry_;        //!< Entry number after the last record to read
+};
+
+//! Read records from another source in a dedicated thread, ahead of their use
+class ReadAheadInput : public RecordSource {
+ public:
+  //! Construct from the source actually reading the records
+  ReadAheadInput(std::unique_ptr<RecordSource> reader, std::size_t capacity);
+
+  //! Stop and join the reading thread
+  ~ReadAheadInput() override;
+
+  std::unique_ptr<datatools::things> next() override;
+
+ private:
+  //! Reading thread main loop
+  void run_();
+
+  std::unique_ptr<RecordSource> reader_;
+  BoundedQueue<std::unique_ptr<datatools::things>> queue_;
+  std::thread thread_;
+};
+
+//! Write records through the output module in the calling thread
+class DirectOutput : public RecordSink {
+ public:
+  //! Construct from an optional output module (records are discarded if null)
+  DirectOutput(dpp::base_module* output, RecordPool& pool, datatools::logger::priority logLevel);
+
+  bool write(std::unique_ptr<datatools::things> item) override;
+
+  bool finish() override;
+
+ private:
+  dpp::base_module* output_;
+  RecordPool& pool_;
+  datatools::logger::priority logLevel_;
+  bool failed_ = false;
+};
+
+//! Write records through the output module in a dedicated thread
+class WriteBehindOutput : public RecordSink {
+ public:
+  WriteBehindOutput(dpp::base_module& output, RecordPool& pool, std::size_t capacity,
+                    datatools::logger::priority logLevel);
+
+  //! Write pending records and join the writing thread
+  ~WriteBehindOutput() override;
+
+  bool write(std::unique_ptr<datatools::things> item) override;
+
+  bool finish() override;
+
+ private:
+  //! Writing thread main loop
+  void run_();
+
+  DirectOutput writer_;
+  RecordPool& pool_;
+  BoundedQueue<std::unique_ptr<datatools::things>> queue_;
+  std::atomic<bool> failed_;
+  std::thread thread_;
+};
+
+}  // namespace FLReconstruct
+
+#endif  // FLRECONSTRUCTRECORDIO_H
+
+// Local Variables: --
+// mode: c++ --
+// c-file-style: "gnu" --
+// tab-width: 2 --
+// End: --
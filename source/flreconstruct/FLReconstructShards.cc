@@ -0,0 +1,241 @@
+// Ourselves
+#include "FLReconstructShards.h"
+
+// Standard Library
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+// - POSIX
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Third Party
+// - Bayeux
+#include "bayeux/datatools/things.h"
+#include "bayeux/datatools/utils.h"
+#include "bayeux/dpp/input_module.h"
+
+// This Project
+#include "FLReconstructPipeline.h"
+#include "FLReconstructProfiler.h"
+
+namespace FLReconstruct {
+
+namespace {
+
+//! Return the name of the partial output file of a shard
+std::string shard_output_file(const std::string& outputFile, std::size_t shard) {
+  std::ostringstream name;
+  name << outputFile << ".shard-" << shard << ".brio";
+  return name.str();
+}
+
+//! Return the name of the partial profiling report of a shard
+std::string shard_profile_report(const std::string& profileReport, std::size_t shard) {
+  std::ostringstream name;
+  name << profileReport << ".shard-" << shard;
+  return name.str();
+}
+
+//! Merge the partial profiling reports of the shards into the profiling report of the run
+falaise::exit_code merge_profile_reports(const std::vector<std::string>& partialReports,
+                                         const FLReconstructParams& flRecParameters) {
+  try {
+    std::unique_ptr<ModuleProfiler> profile;
+    for (const std::string& partialReport : partialReports) {
+      std::string partialPath = partialReport;
+      datatools::fetch_path_with_env(partialPath);
+      std::ifstream partialFile(partialPath.c_str());
+      DT_THROW_IF(!partialFile, std::runtime_error,
+                  "Cannot open profiling report file '" << partialPath << "'!");
+      ModuleProfiler partialProfile = ModuleProfiler::read_json(partialFile);
+      if (!profile) {
+        profile.reset(new ModuleProfiler(partialProfile));
+      } else {
+        profile->merge(partialProfile);
+      }
+    }
+    profile->print(std::cout);
+    std::string reportPath = flRecParameters.profileReport;
+    datatools::fetch_path_with_env(reportPath);
+    std::ofstream reportFile(reportPath.c_str());
+    DT_THROW_IF(!reportFile, std::runtime_error,
+                "Cannot open profiling report file '" << reportPath << "'!");
+    profile->write_json(reportFile);
+  } catch (std::exception& e) {
+    DT_LOG_ERROR(flRecParameters.logLevel, "Cannot merge profiling reports: " << e.what());
+    return falaise::EXIT_UNAVAILABLE;
+  }
+  return falaise::EXIT_OK;
+}
+
+//! Wait for a child process, return its exit code
+falaise::exit_code wait_for_shard(pid_t pid, datatools::logger::priority logLevel) {
+  int status = 0;
+  while (waitpid(pid, &status, 0) < 0) {
+    if (errno != EINTR) {
+      DT_LOG_ERROR(logLevel, "Cannot wait for process " << pid << "!");
+      return falaise::EXIT_UNAVAILABLE;
+    }
+  }
+  if (WIFEXITED(status)) {
+    return static_cast<falaise::exit_code>(WEXITSTATUS(status));
+  }
+  DT_LOG_ERROR(logLevel, "Process " << pid << " terminated abnormally!");
+  return falaise::EXIT_UNAVAILABLE;
+}
+
+}  // namespace
+
+std::size_t count_input_entries(const std::string& inputFile,
+                                datatools::logger::priority logLevel) {
+  dpp::input_module input;
+  input.set_logging_priority(logLevel);
+  input.set_single_input_file(inputFile);
+  input.initialize_simple();
+  std::size_t numberOfEntries = 0;
+  const int64_t knownEntries = input.get_source().get_number_of_entries();
+  if (knownEntries >= 0) {
+    numberOfEntries = knownEntries;
+  } else {
+    // The source does not know its size, so we have to read it through
+    DT_LOG_WARNING(logLevel, "Counting entries of input file '" << inputFile << "'...");
+    datatools::things record;
+    while (!input.is_terminated()) {
+      record.clear();
+      if (input.process(record) != dpp::base_module::PROCESS_OK) break;
+      numberOfEntries++;
+    }
+  }
+  input.reset();
+  return numberOfEntries;
+}
+
+falaise::exit_code do_sharded_pipeline(const FLReconstructParams& flRecParameters) {
+  DT_LOG_TRACE_ENTERING(flRecParameters.logLevel);
+  falaise::exit_code code = falaise::EXIT_OK;
+
+  // Split the requested range of input entries in contiguous shards:
+  std::size_t numberOfEntries = 0;
+  try {
+    numberOfEntries = count_input_entries(flRecParameters.inputFile, flRecParameters.logLevel);
+  } catch (std::exception& e) {
+    std::cerr << "flreconstruct : Cannot open input file" << std::endl;
+    std::cerr << e.what() << std::endl;
+    return falaise::EXIT_UNAVAILABLE;
+  }
+  const std::size_t firstEntry = flRecParameters.inputFirstEntry;
+  numberOfEntries = (numberOfEntries > firstEntry ? numberOfEntries - firstEntry : 0);
+  if (flRecParameters.inputNumberOfEntries > 0) {
+    numberOfEntries = std::min(numberOfEntries, flRecParameters.inputNumberOfEntries);
+  }
+  // The limit on the number of processed events applies to the whole run, not to each shard
+  if (flRecParameters.numberOfEvents > 0) {
+    numberOfEntries = std::min<std::size_t>(numberOfEntries, flRecParameters.numberOfEvents);
+  }
+  const std::size_t numberOfShards = std::max<std::size_t>(
+      1, std::min<std::size_t>(flRecParameters.numberOfJobs, numberOfEntries));
+  DT_LOG_DEBUG(flRecParameters.logLevel, "Processing " << numberOfEntries << " entries in "
+                                                       << numberOfShards << " processes");
+
+  // Start one process per shard:
+  std::vector<pid_t> shardProcesses;
+  std::vector<std::string> partialFiles;
+  std::vector<std::string> partialReports;
+  for (std::size_t shard = 0; shard < numberOfShards; shard++) {
+    const std::size_t shardBegin = firstEntry + shard * numberOfEntries / numberOfShards;
+    const std::size_t shardEnd = firstEntry + (shard + 1) * numberOfEntries / numberOfShards;
+    FLReconstructParams shardParameters = flRecParameters;
+    shardParameters.numberOfJobs = 1;
+    shardParameters.inputFirstEntry = shardBegin;
+    shardParameters.inputNumberOfEntries = shardEnd - shardBegin;
+    shardParameters.numberOfEvents = 0;
+    // Metadata are only written once, with the merged output:
+    shardParameters.embeddedMetadata = false;
+    shardParameters.outputMetadataFile = "";
+    if (!flRecParameters.outputFile.empty()) {
+      shardParameters.outputFile = shard_output_file(flRecParameters.outputFile, shard);
+      partialFiles.push_back(shardParameters.outputFile);
+    }
+    if (!flRecParameters.profileReport.empty()) {
+      shardParameters.profileReport = shard_profile_report(flRecParameters.profileReport, shard);
+      partialReports.push_back(shardParameters.profileReport);
+    }
+
+    std::cout.flush();
+    std::cerr.flush();
+    pid_t pid = fork();
+    if (pid < 0) {
+      DT_LOG_FATAL(flRecParameters.logLevel, "Cannot start process for shard #" << shard << "!");
+      code = falaise::EXIT_UNAVAILABLE;
+      break;
+    }
+    if (pid == 0) {
+      // Shard process: run the pipeline on its range and leave without
+      // running the parent's exit handlers
+      falaise::exit_code shardCode = do_pipeline(shardParameters);
+      std::cout.flush();
+      std::cerr.flush();
+      _exit(shardCode);
+    }
+    shardProcesses.push_back(pid);
+  }
+
+  for (pid_t pid : shardProcesses) {
+    falaise::exit_code shardCode = wait_for_shard(pid, flRecParameters.logLevel);
+    if (shardCode != falaise::EXIT_OK && code == falaise::EXIT_OK) {
+      code = shardCode;
+    }
+  }
+
+  // Merge partial outputs, in order, through a pass-through pipeline writing the final
+  // output file (of any supported format) and the run metadata:
+  if (code == falaise::EXIT_OK && !partialFiles.empty()) {
+    DT_LOG_DEBUG(flRecParameters.logLevel, "Merging partial output files...");
+    FLReconstructParams mergeParameters = flRecParameters;
+    mergeParameters.numberOfJobs = 1;
+    mergeParameters.numberOfThreads = 1;
+    mergeParameters.profileReport = "";
+    mergeParameters.inputFile = partialFiles.front();
+    mergeParameters.inputFiles = partialFiles;
+    mergeParameters.inputFirstEntry = 0;
+    mergeParameters.inputNumberOfEntries = 0;
+    mergeParameters.keptBanks.clear();
+    mergeParameters.modulesConfig.clear();
+    mergeParameters.modulesConfig.add_section(mergeParameters.reconstructionPipelineModule,
+                                              "dpp::dummy_module");
+    code = do_pipeline(mergeParameters);
+  } else if (code != falaise::EXIT_OK) {
+    DT_LOG_ERROR(flRecParameters.logLevel, "Some processes failed, output is not merged!");
+  }
+
+  // Merge the partial profiling reports of all shards:
+  if (code == falaise::EXIT_OK && !partialReports.empty()) {
+    DT_LOG_DEBUG(flRecParameters.logLevel, "Merging partial profiling reports...");
+    code = merge_profile_reports(partialReports, flRecParameters);
+  }
+
+  for (const std::string& partialFile : partialFiles) {
+    std::string partialPath = partialFile;
+    datatools::fetch_path_with_env(partialPath);
+    std::remove(partialPath.c_str());
+  }
+  for (const std::string& partialReport : partialReports) {
+    std::string partialPath = partialReport;
+    datatools::fetch_path_with_env(partialPath);
+    std::remove(partialPath.c_str());
+  }
+
+  DT_LOG_TRACE_EXITING(flRecParameters.logLevel);
+  return code;
+}
+
+}  // namespace FLReconstruct
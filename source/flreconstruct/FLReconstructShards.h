@@ -0,0 +1,43 @@
+// FLReconstructShards.h - Multi-process sharded execution of FLReconstruct
+
+// Distributed under the OSI-approved BSD 3-Clause License (the "License");
+// see accompanying file License.txt for details.
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even the
+// implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the License for more information.
+
+#ifndef FLRECONSTRUCTSHARDS_H
+#define FLRECONSTRUCTSHARDS_H
+
+// Standard Library
+#include <cstddef>
+#include <string>
+
+// This Project
+#include "FLReconstructParams.h"
+#include "falaise/exitcodes.h"
+
+namespace FLReconstruct {
+
+//! Return the number of entries in an input data file
+std::size_t count_input_entries(const std::string& inputFile,
+                                datatools::logger::priority logLevel);
+
+//! \brief Run the pipeline in several processes and merge their outputs
+//!
+//! The input entries are split in contiguous ranges, one per process. Each
+//! process writes its results in a partial file, in a native Bayeux format.
+//! Partial files are then read back in order by a pass-through pipeline that
+//! writes the requested output file (with the run metadata), and removed.
+falaise::exit_code do_sharded_pipeline(const FLReconstructParams& recParams);
+
+}  // namespace FLReconstruct
+
+#endif  // FLRECONSTRUCTSHARDS_H
+
+// Local Variables: --
+// mode: c++ --
+// c-file-style: "gnu" --
+// tab-width: 2 --
+// End: --
@@ -0,0 +1,92 @@
+// Ourselves
+#include "FLReconstructWorkerPool.h"
+
+// Standard Library
+#include <utility>
+
+namespace FLReconstruct {
+
+WorkerPool::WorkerPool(const std::vector<dpp::base_module*>& pipelines) {
+  workers_.reserve(pipelines.size());
+  for (dpp::base_module* pipeline : pipelines) {
+    workers_.emplace_back(&WorkerPool::run_worker_, this, pipeline);
+  }
+}
+
+WorkerPool::~WorkerPool() { stop(); }
+
+void WorkerPool::submit(std::unique_ptr<datatools::things> item) {
+  EventSlot slot;
+  slot.sequence = nextIn_++;
+  slot.item = std::move(item);
+  {
+    std::lock_guard<std::mutex> lock(inputMutex_);
+    pending_.push_back(std::move(slot));
+  }
+  inputReady_.notify_one();
+}
+
+bool WorkerPool::has_next() {
+  std::lock_guard<std::mutex> lock(doneMutex_);
+  return done_.count(nextOut_) > 0;
+}
+
+EventSlot WorkerPool::next() {
+  std::unique_lock<std::mutex> lock(doneMutex_);
+  doneReady_.wait(lock, [this] { return done_.count(nextOut_) > 0; });
+  auto found = done_.find(nextOut_);
+  EventSlot slot = std::move(found->second);
+  done_.erase(found);
+  nextOut_++;
+  return slot;
+}
+
+std::size_t WorkerPool::in_flight() const { return nextIn_ - nextOut_; }
+
+void WorkerPool::stop() {
+  {
+    std::lock_guard<std::mutex> lock(inputMutex_);
+    stopping_ = true;
+    pending_.clear();
+  }
+  inputReady_.notify_all();
+  for (std::thread& worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+  workers_.clear();
+}
+
+void WorkerPool::run_worker_(dpp::base_module* pipeline) {
+  while (true) {
+    EventSlot slot;
+    {
+      std::unique_lock<std::mutex> lock(inputMutex_);
+      inputReady_.wait(lock, [this] { return stopping_ || !pending_.empty(); });
+      if (stopping_) {
+        return;
+      }
+      slot = std::move(pending_.front());
+      pending_.pop_front();
+    }
+
+    // Exceptions are handed back with the record so that the caller
+    // sees them at the same point of the input as a sequential run would
+    try {
+      slot.status = pipeline->process(*slot.item);
+    } catch (...) {
+      slot.status = dpp::base_module::PROCESS_FATAL;
+      slot.error = std::current_exception();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(doneMutex_);
+      std::size_t sequence = slot.sequence;
+      done_.insert(std::make_pair(sequence, std::move(slot)));
+    }
+    doneReady_.notify_all();
+  }
+}
+
+}  // namespace FLReconstruct
@@ -0,0 +1,98 @@
+// FLReconstructWorkerPool.h - Event-parallel processing for FLReconstruct
+
+// Distributed under the OSI-approved BSD 3-Clause License (the "License");
+// see accompanying file License.txt for details.
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even the
+// implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the License for more information.
+
+#ifndef FLRECONSTRUCTWORKERPOOL_H
+#define FLRECONSTRUCTWORKERPOOL_H
+
+// Standard Library
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Third Party
+// - Bayeux
+#include "bayeux/datatools/things.h"
+#include "bayeux/dpp/base_module.h"
+
+namespace FLReconstruct {
+
+//! A data record travelling through the worker pool
+struct EventSlot {
+  std::size_t sequence = 0;                 //!< Position of the record in the input
+  std::unique_ptr<datatools::things> item;  //!< The event record
+  std::exception_ptr error;                 //!< Exception thrown by the pipeline, if any
+  //! Status returned by the pipeline
+  dpp::base_module::process_status status = dpp::base_module::PROCESS_OK;
+};
+
+//! \brief Run several instances of the processing pipeline on worker threads
+//!
+//! Each worker owns a distinct pipeline module instance, typically built by
+//! its own dpp::module_manager. Records are submitted in input order and are
+//! handed back by next() in the same order, whatever the order in which the
+//! workers complete them (reorder buffer).
+class WorkerPool {
+ public:
+  //! Start one worker thread per pipeline instance
+  explicit WorkerPool(const std::vector<dpp::base_module*>& pipelines);
+
+  //! Stop and join the worker threads
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  //! Queue a record for processing
+  void submit(std::unique_ptr<datatools::things> item);
+
+  //! Return true if the next record in input order has been processed
+  bool has_next();
+
+  //! Return the next processed record in input order, blocking until it is available
+  EventSlot next();
+
+  //! Return the number of records submitted but not yet returned by next()
+  std::size_t in_flight() const;
+
+  //! Stop the workers, discarding records not yet processed
+  void stop();
+
+ private:
+  //! Worker thread main loop
+  void run_worker_(dpp::base_module* pipeline);
+
+  std::vector<std::thread> workers_;  //!< Worker threads
+  bool stopping_ = false;             //!< Stop request flag (guarded by inputMutex_)
+
+  std::mutex inputMutex_;                  //!< Protect the input queue
+  std::condition_variable inputReady_;     //!< Signal records available for processing
+  std::deque<EventSlot> pending_;          //!< Records waiting for a worker
+  std::size_t nextIn_ = 0;                 //!< Sequence number of the next submitted record
+
+  std::mutex doneMutex_;                   //!< Protect the reorder buffer
+  std::condition_variable doneReady_;      //!< Signal a processed record
+  std::map<std::size_t, EventSlot> done_;  //!< Processed records, keyed by sequence number
+  std::size_t nextOut_ = 0;                //!< Sequence number of the next record to hand back
+};
+
+}  // namespace FLReconstruct
+
+#endif  // FLRECONSTRUCTWORKERPOOL_H
+
+// Local Variables: --
+// mode: c++ --
+// c-file-style: "gnu" --
+// tab-width: 2 --
+// End: --
@@ -55,6 +55,7 @@
 #include "FLReconstructImpl.h"
 #include "FLReconstructParams.h"
 #include "FLReconstructPipeline.h"
+#include "FLReconstructShards.h"
 #include "falaise/exitcodes.h"
 #include "falaise/falaise.h"
 
@@ -104,7 +105,11 @@ falaise::exit_code do_flreconstruct(int argc, char* argv[]) {
   falaise::exit_code code = falaise::EXIT_OK;
 
   DT_LOG_DEBUG(flRecParameters.logLevel, "Running the pipeline...");
-  code = do_pipeline(flRecParameters);
+  if (flRecParameters.numberOfJobs > 1) {
+    code = do_sharded_pipeline(flRecParameters);
+  } else {
+    code = do_pipeline(flRecParameters);
+  }
   DT_LOG_DEBUG(flRecParameters.logLevel, "Pipeline is done with code=" << code);
 
   return code;
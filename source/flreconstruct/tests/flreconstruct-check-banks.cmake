@@ -0,0 +1,30 @@
+#.rst: Check the banks of the event records written by flreconstruct
+#
+# Usage:
+#
+#   cmake -DOUTPUT=<file> -DKEPT=<label>[,<label>...] -DREMOVED=<label>[,<label>...]
+#         -P flreconstruct-check-banks.cmake
+#
+# Fails if the XML output file OUTPUT does not exist, does not hold the banks
+# labelled in the comma separated list KEPT, or holds any of the banks
+# labelled in the comma separated list REMOVED.
+
+if(NOT EXISTS "${OUTPUT}")
+  message(FATAL_ERROR "Output file '${OUTPUT}' does not exist")
+endif()
+
+file(READ "${OUTPUT}" _output)
+string(REPLACE "," ";" _kept "${KEPT}")
+foreach(_label ${_kept})
+  string(FIND "${_output}" "<first>${_label}</first>" _position)
+  if(_position LESS 0)
+    message(FATAL_ERROR "Output file '${OUTPUT}' does not hold bank '${_label}'")
+  endif()
+endforeach()
+string(REPLACE "," ";" _removed "${REMOVED}")
+foreach(_label ${_removed})
+  string(FIND "${_output}" "<first>${_label}</first>" _position)
+  if(NOT _position LESS 0)
+    message(FATAL_ERROR "Output file '${OUTPUT}' holds bank '${_label}'")
+  endif()
+endforeach()
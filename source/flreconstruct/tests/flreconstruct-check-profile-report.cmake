@@ -0,0 +1,21 @@
+#.rst: Check a profiling report of flreconstruct
+#
+# Usage:
+#
+#   cmake -DREPORT=<file> -DMODULES=<name>[,<name>...] -P flreconstruct-check-profile-report.cmake
+#
+# Fails if the JSON report REPORT does not exist or does not list all the
+# modules named in the comma separated list MODULES.
+
+if(NOT EXISTS "${REPORT}")
+  message(FATAL_ERROR "Profiling report '${REPORT}' does not exist")
+endif()
+
+file(READ "${REPORT}" _report)
+string(REPLACE "," ";" _modules "${MODULES}")
+foreach(_module ${_modules})
+  string(FIND "${_report}" "\"name\": \"${_module}\"" _position)
+  if(_position LESS 0)
+    message(FATAL_ERROR "Profiling report '${REPORT}' does not list module '${_module}'")
+  endif()
+endforeach()
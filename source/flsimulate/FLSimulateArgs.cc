@@ -32,6 +32,9 @@ const std::string& FLSimulateArgs::default_file_for_seeds() {
   return _f;
 }
 
+// static
+unsigned int FLSimulateArgs::default_events_per_block() { return 100; }
+
 void do_postprocess(FLSimulateArgs& flSimParameters);
 
 // static
@@ -42,8 +45,10 @@ FLSimulateArgs FLSimulateArgs::makeDefault() {
   params.logLevel = datatools::logger::PRIO_ERROR;
   params.userProfile = "normal";
   params.numberOfEvents = 1;
+  params.numberOfJobs = 1;
   params.doSimulation = true;
   params.doDigitization = false;
+  params.doMockCalibration = false;
   // Identification of the experimental setup:
   params.experimentalSetupUrn = "";
 
@@ -68,6 +73,12 @@ FLSimulateArgs FLSimulateArgs::makeDefault() {
   params.simulationManagerParams.output_profiles_activation_rule = "";
   params.saveRngSeeding = true;
   params.rngSeeding = "";
+  params.eventsPerBlock = 0;
+
+  // Mock calibration:
+  params.mockCalibrationConfig = "";
+  params.keepSimulatedData = false;
+  params.mockCalibrationSeed = 0;
 
   // Variants support:
   params.variantConfigUrn = "";
@@ -108,6 +119,7 @@ void do_configure(int argc, char* argv[], FLSimulateArgs& flSimParameters) {
   flSimParameters.embeddedMetadata = args.embeddedMetadata;
   flSimParameters.outputFile = args.outputFile;
   flSimParameters.mountPoints = args.mountPoints;
+  flSimParameters.numberOfJobs = args.numberOfJobs;
 
   if (flSimParameters.mountPoints.size()) {
     // Apply mount points as soon as possible, because manually set file path below
@@ -171,6 +183,10 @@ void do_configure(int argc, char* argv[], FLSimulateArgs& flSimParameters) {
       flSimParameters.numberOfEvents = falaise::properties::getValueOrDefault<int>(
           baseSystem, "numberOfEvents", flSimParameters.numberOfEvents);
 
+      // Number of simulation processes:
+      flSimParameters.numberOfJobs = falaise::properties::getValueOrDefault<int>(
+          baseSystem, "numberOfJobs", flSimParameters.numberOfJobs);
+
       // Printing rate for events:
       flSimParameters.simulationManagerParams.number_of_events_modulo =
           falaise::properties::getValueOrDefault<int>(
@@ -184,6 +200,10 @@ void do_configure(int argc, char* argv[], FLSimulateArgs& flSimParameters) {
       // Do digitization:
       flSimParameters.doDigitization = falaise::properties::getValueOrDefault<bool>(
           baseSystem, "doDigitization", flSimParameters.doDigitization);
+
+      // Do mock calibration:
+      flSimParameters.doMockCalibration = falaise::properties::getValueOrDefault<bool>(
+          baseSystem, "doMockCalibration", flSimParameters.doMockCalibration);
     }
 
     // Simulation subsystem:
@@ -269,6 +289,10 @@ void do_configure(int argc, char* argv[], FLSimulateArgs& flSimParameters) {
               simSubsystem, "rngSeedFileSave",
               flSimParameters.simulationManagerParams.output_prng_seeds_file);
 
+      // Size of the blocks of events with derived PRNG seeds:
+      flSimParameters.eventsPerBlock = falaise::properties::getValueOrDefault<int>(
+          simSubsystem, "eventsPerBlock", flSimParameters.eventsPerBlock);
+
       // File for loading internal PRNG's states:
       if (flSimParameters.userProfile != "expert" && simSubsystem.has_key("inputRngStateFile")) {
         DT_THROW(FLConfigUserError, "User profile '" << flSimParameters.userProfile << "' "
@@ -300,6 +324,24 @@ void do_configure(int argc, char* argv[], FLSimulateArgs& flSimParameters) {
       // Bind properties in this section to the relevant ones in params:
     }
 
+    // Mock calibration subsystem:
+    if (flSimConfig.has_key_with_meta("flsimulate.calibration", "flsimulate::section")) {
+      datatools::properties calibSubsystem = flSimConfig.get_section("flsimulate.calibration");
+      // Bind properties in this section to the relevant ones in params:
+
+      // Configuration of the mock calibration modules:
+      flSimParameters.mockCalibrationConfig = falaise::properties::getValueOrDefault<std::string>(
+          calibSubsystem, "config", flSimParameters.mockCalibrationConfig);
+
+      // Keep the simulated data bank:
+      flSimParameters.keepSimulatedData = falaise::properties::getValueOrDefault<bool>(
+          calibSubsystem, "keepSimulatedData", flSimParameters.keepSimulatedData);
+
+      // Seed of the mock calibration PRNGs:
+      flSimParameters.mockCalibrationSeed = falaise::properties::getValueOrDefault<int>(
+          calibSubsystem, "rngSeed", flSimParameters.mockCalibrationSeed);
+    }
+
     // Variants subsystem:
     if (flSimConfig.has_key_with_meta("flsimulate.variantService", "flsimulate::section")) {
       datatools::properties variantSubsystem = flSimConfig.get_section("flsimulate.variantService");
@@ -372,6 +414,19 @@ void do_postprocess(FLSimulateArgs& flSimParameters) {
   datatools::kernel& dtk = datatools::kernel::instance();
   const datatools::urn_query_service& dtkUrnQuery = dtk.get_urn_query();
 
+  DT_THROW_IF(flSimParameters.numberOfJobs == 0, FLConfigUserError,
+              "Number of processes must be at least 1!");
+  if (flSimParameters.numberOfJobs > 1 && flSimParameters.eventsPerBlock == 0) {
+    // Parallel processes need independent PRNG seeds for their events:
+    flSimParameters.eventsPerBlock = FLSimulateArgs::default_events_per_block();
+  }
+  if (flSimParameters.eventsPerBlock > 0) {
+    DT_THROW_IF(!flSimParameters.simulationManagerParams.input_prng_states_file.empty() ||
+                    !flSimParameters.simulationManagerParams.output_prng_states_file.empty(),
+                FLConfigUserError,
+                "PRNG state files cannot be used with blocks of derived PRNG seeds!");
+  }
+
   if (flSimParameters.simulationManagerParams.input_prng_seeds_file.empty()) {
     if (!flSimParameters.saveRngSeeding &&
         flSimParameters.simulationManagerParams.output_prng_seeds_file.empty()) {
@@ -585,6 +640,7 @@ void FLSimulateArgs::print(std::ostream& out_) const {
        << std::endl;
   out_ << tag << "userProfile                = " << userProfile << std::endl;
   out_ << tag << "numberOfEvents             = " << numberOfEvents << std::endl;
+  out_ << tag << "numberOfJobs               = " << numberOfJobs << std::endl;
   out_ << tag << "doSimulation               = " << std::boolalpha << doSimulation << std::endl;
   out_ << tag << "doDigitization             = " << std::boolalpha << doDigitization << std::endl;
   out_ << tag << "experimentalSetupUrn       = " << experimentalSetupUrn << std::endl;
@@ -593,8 +649,16 @@ void FLSimulateArgs::print(std::ostream& out_) const {
        << std::endl;
   out_ << tag << "saveRngSeeding             = " << std::boolalpha << saveRngSeeding << std::endl;
   out_ << tag << "rngSeeding                 = " << rngSeeding << std::endl;
+  out_ << tag << "eventsPerBlock             = " << eventsPerBlock << std::endl;
+  out_ << tag << "doMockCalibration          = " << std::boolalpha << doMockCalibration
+       << std::endl;
   out_ << tag << "digitizationSetupUrn       = "
        << (digitizationSetupUrn.empty() ? "<not used>" : digitizationSetupUrn) << std::endl;
+  out_ << tag << "mockCalibrationConfig      = "
+       << (mockCalibrationConfig.empty() ? "<default>" : mockCalibrationConfig) << std::endl;
+  out_ << tag << "keepSimulatedData          = " << std::boolalpha << keepSimulatedData
+       << std::endl;
+  out_ << tag << "mockCalibrationSeed        = " << mockCalibrationSeed << std::endl;
   out_ << tag << "variantConfigUrn           = " << variantConfigUrn << std::endl;
   out_ << tag << "variantProfileUrn          = " << variantProfileUrn << std::endl;
   out_ << tag << "variantSubsystemParams     = " << variantSubsystemParams.config_filename
@@ -15,6 +15,7 @@
 #define FLSIMULATEARGS_H
 
 // Standard Library:
+#include <cstdint>
 #include <string>
 
 // Third Party
@@ -33,9 +34,11 @@ struct FLSimulateArgs {
   std::string userProfile;               //!< User profile
   std::vector<std::string> mountPoints;  //!< Directory mount directives
   unsigned int numberOfEvents;           //!< Number of events to be processed in the pipeline
+  unsigned int numberOfJobs;             //!< Number of simulation processes
 
   bool doSimulation;                 //!< Simulation flag
   bool doDigitization;               //!< Digitization flag
+  bool doMockCalibration;            //!< Mock calibration flag
   std::string experimentalSetupUrn;  //!< The URN of the experimental setup (possibly extracted from
                                      //!< the simulation setup)
 
@@ -47,6 +50,13 @@ struct FLSimulateArgs {
   // Digitization module setup:
   std::string digitizationSetupUrn;  //!< The URN of the digitization module setup
 
+  // Mock calibration modules setup:
+  std::string mockCalibrationConfig;  //!< Configuration of the mock calibration modules
+                                      //!< (default modules if empty)
+  bool keepSimulatedData;             //!< Flag to keep the simulated data bank after calibration
+  int32_t mockCalibrationSeed;        //!< Seed of the mock calibration PRNGs
+                                      //!< (0: seeds from the modules configuration)
+
   // Variants support:
   std::string variantConfigUrn;   //!< Variants configuration URN
   std::string variantProfileUrn;  //!< Variants profile URN
@@ -63,6 +73,8 @@ struct FLSimulateArgs {
   bool embeddedMetadata;           //!< Flag to embed metadata in the output data file
   bool saveRngSeeding;             //!< Flag to save PRNG seeds in metadata
   std::string rngSeeding;          //!< PRNG seed initialization
+  unsigned int eventsPerBlock;     //!< Number of events per block of derived PRNG seeds
+                                   //!< (0: seed once for the whole run)
   std::string outputFile;          //!< Output data file for the output module
 
   //! Construct and return the default configuration object
@@ -78,6 +90,9 @@ struct FLSimulateArgs {
 
   // Return the default file output metadata file
   static const std::string &default_file_for_seeds();
+
+  // Return the default number of events per block of derived PRNG seeds
+  static unsigned int default_events_per_block();
 };
 
 //! Parse command line arguments to configure the simulation parameters
@@ -28,6 +28,7 @@ FLSimulateCommandLine FLSimulateCommandLine::makeDefault() {
   flClarg.embeddedMetadata = true;
   flClarg.outputFile = "";
   flClarg.userProfile = "normal";
+  flClarg.numberOfJobs = 1;
   return flClarg;
 }
 
@@ -142,6 +143,14 @@ void do_cldialog(int argc, char* argv[], FLSimulateCommandLine& clArgs) {
                            "  -d \"nemoprod@/etc/nemoprod/config\" \n"
                            "  -d \"nemoprod.data@/data/nemoprod/runs\"")
 
+                              ("jobs,j",
+                               bpo::value<unsigned int>(&clArgs.numberOfJobs)
+                                   ->default_value(1)
+                                   ->value_name("n"),
+                               "number of simulation processes\n"
+                               "Example: \n"
+                               "  -j 8")
+
                               ("config,c",
                                bpo::value<std::string>(&clArgs.configScript)->value_name("file"),
                                "configuration script for simulation\n"
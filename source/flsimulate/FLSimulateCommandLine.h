@@ -33,6 +33,7 @@ struct FLSimulateCommandLine {
   datatools::logger::priority logLevel;  //!< Logging priority threshold
   std::string userProfile;               //!< User profile
   std::vector<std::string> mountPoints;  //!< Directory mount directives
+  unsigned int numberOfJobs;             //!< Number of simulation processes
   std::string configScript;              //!< Path to configuration script
   std::string outputMetadataFile;        //!< Path for saving metadata
   bool embeddedMetadata;                 //!< Flag to embed metadata in the output data file
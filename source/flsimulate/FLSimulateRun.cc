@@ -0,0 +1,378 @@
+// Ourselves
+#include "FLSimulateRun.h"
+
+// Standard Library:
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+// - POSIX
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Third Party
+// - Bayeux
+#include "bayeux/datatools/exception.h"
+#include "bayeux/datatools/things.h"
+#include "bayeux/datatools/utils.h"
+#include "bayeux/dpp/input_module.h"
+#include "bayeux/dpp/output_module.h"
+
+// This Project
+#include "falaise/snemo/processing/services.h"
+
+namespace FLSimulate {
+
+namespace {
+
+//! Labels of the seeded PRNGs, in the order of their stream index
+const char *const kStreamLabels[] = {"VG", "EG", "SHPF", "MGR"};
+const unsigned int kNumberOfStreams = 4;
+
+//! Seed of the PRNGs of the mock calibration modules, when not configured (as in the modules)
+const int32_t kMockCalibrationSeed = 12345;
+
+//! Type names of the mock calibration modules
+const char *const kTrackerCalibrationType = "snemo::processing::mock_tracker_s2c_module";
+const char *const kCaloCalibrationType = "snemo::processing::mock_calorimeter_s2c_module";
+
+//! Check if a module type is one of the mock calibration modules
+bool is_mock_calibration_type(const std::string &type) {
+  return type == kTrackerCalibrationType || type == kCaloCalibrationType;
+}
+
+//! \brief Return the seed of the mock calibration PRNGs of the run
+//!
+//! This is mockCalibrationSeed if set, otherwise the seed configured for
+//! the first mock calibration module.
+int32_t get_mock_calibration_seed(const FLSimulateArgs &flSimParameters) {
+  if (flSimParameters.mockCalibrationSeed > 0) {
+    return flSimParameters.mockCalibrationSeed;
+  }
+  const datatools::multi_properties calibrationConfig =
+      get_mock_calibration_config(flSimParameters);
+  for (const std::string &name : calibrationConfig.ordered_keys()) {
+    const datatools::multi_properties::entry &module = calibrationConfig.get(name);
+    if (is_mock_calibration_type(module.get_meta()) &&
+        module.get_properties().has_key("random.seed")) {
+      return module.get_properties().fetch_integer("random.seed");
+    }
+  }
+  return kMockCalibrationSeed;
+}
+
+//! SplitMix64 finalizer
+uint64_t mix64(uint64_t z) {
+  z = (z ^ (z >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+  z = (z ^ (z >> 27)) * UINT64_C(0x94d049bb133111eb);
+  return z ^ (z >> 31);
+}
+
+//! Return the master seed of each PRNG stream
+//!
+//! Explicit seeds are used as is. Automatic seeds are drawn once here, so
+//! that all blocks share them. If the seeds are loaded from a file, its
+//! contents are hashed into the master seeds.
+std::vector<uint64_t> get_master_seeds(const FLSimulateArgs &flSimParameters) {
+  const mctools::g4::manager_parameters &mgrParams = flSimParameters.simulationManagerParams;
+  std::vector<uint64_t> masterSeeds;
+  if (!mgrParams.input_prng_seeds_file.empty()) {
+    std::string seedsFile = mgrParams.input_prng_seeds_file;
+    datatools::fetch_path_with_env(seedsFile);
+    std::ifstream seedsInput(seedsFile.c_str());
+    DT_THROW_IF(!seedsInput, std::runtime_error,
+                "Cannot open PRNG seeds file '" << seedsFile << "'!");
+    // FNV-1a hash of the file contents
+    uint64_t hash = UINT64_C(0xcbf29ce484222325);
+    for (std::istreambuf_iterator<char> it(seedsInput), end; it != end; ++it) {
+      hash = (hash ^ static_cast<unsigned char>(*it)) * UINT64_C(0x100000001b3);
+    }
+    for (unsigned int stream = 0; stream < kNumberOfStreams; stream++) {
+      masterSeeds.push_back(mix64(hash + stream));
+    }
+    return masterSeeds;
+  }
+  const int32_t seeds[] = {mgrParams.vg_seed, mgrParams.eg_seed, mgrParams.shpf_seed,
+                           mgrParams.mgr_seed};
+  std::random_device entropy;
+  for (int32_t seed : seeds) {
+    // Special (automatic) seed values are not positive
+    masterSeeds.push_back(seed > 0 ? static_cast<uint64_t>(seed) : 1 + entropy() % 0x7ffffffe);
+  }
+  return masterSeeds;
+}
+
+//! Return the name of the partial output file of a block
+std::string block_output_file(const std::string &outputFile, uint64_t block) {
+  std::ostringstream name;
+  name << outputFile << ".block-" << block << ".brio";
+  return name.str();
+}
+
+//! Simulate one block of events in the current process
+falaise::exit_code run_block(const FLSimulateArgs &flSimParameters,
+                             const std::vector<uint64_t> &masterSeeds, uint64_t block,
+                             const std::string &partialFile) {
+  FLSimulateArgs blockParameters = flSimParameters;
+  mctools::g4::manager_parameters &mgrParams = blockParameters.simulationManagerParams;
+  mgrParams.input_prng_seeds_file = "";
+  mgrParams.output_prng_seeds_file = "";
+  int32_t *seeds[] = {&mgrParams.vg_seed, &mgrParams.eg_seed, &mgrParams.shpf_seed,
+                      &mgrParams.mgr_seed};
+  for (unsigned int stream = 0; stream < kNumberOfStreams; stream++) {
+    int32_t seed = derive_block_seed(masterSeeds[stream], stream, block);
+    // PRNGs of the simulation manager must use different seeds
+    for (unsigned int other = 0; other < stream;) {
+      if (*seeds[other] == seed) {
+        seed = seed % 0x7ffffffe + 1;
+        other = 0;
+      } else {
+        other++;
+      }
+    }
+    *seeds[stream] = seed;
+  }
+  if (blockParameters.doMockCalibration) {
+    // The seed of the mock calibration modules must also change between blocks
+    blockParameters.mockCalibrationSeed =
+        derive_block_seed(get_mock_calibration_seed(flSimParameters), kNumberOfStreams, block);
+  }
+  const unsigned int firstEvent = block * flSimParameters.eventsPerBlock;
+  const unsigned int numberOfEvents =
+      std::min(flSimParameters.eventsPerBlock, flSimParameters.numberOfEvents - firstEvent);
+  return do_simulation(blockParameters, firstEvent, numberOfEvents, partialFile, false);
+}
+
+//! Wait for any child process, return its pid and exit code
+pid_t wait_for_block(falaise::exit_code &code) {
+  int status = 0;
+  pid_t pid = -1;
+  do {
+    pid = waitpid(-1, &status, 0);
+  } while (pid < 0 && errno == EINTR);
+  if (pid < 0) {
+    code = falaise::EXIT_UNAVAILABLE;
+  } else if (WIFEXITED(status)) {
+    code = static_cast<falaise::exit_code>(WEXITSTATUS(status));
+  } else {
+    code = falaise::EXIT_UNAVAILABLE;
+  }
+  return pid;
+}
+
+//! Copy the partial files in order into the output file, with the run metadata
+falaise::exit_code merge_blocks(const FLSimulateArgs &flSimParameters,
+                                const std::vector<std::string> &partialFiles) {
+  datatools::multi_properties flSimMetadata("name", "type",
+                                            "Metadata associated to a flsimulate run");
+  do_metadata(flSimParameters, flSimMetadata);
+  if (datatools::logger::is_debug(flSimParameters.logLevel)) {
+    flSimMetadata.tree_dump(std::cerr, "Simulation metadata: ", "[debug]: ");
+  }
+
+  if (!flSimParameters.outputMetadataFile.empty()) {
+    std::string fMetadata = flSimParameters.outputMetadataFile;
+    datatools::fetch_path_with_env(fMetadata);
+    flSimMetadata.write(fMetadata);
+  }
+
+  dpp::output_module simOutput;
+  simOutput.set_name("FLSimulateOutput");
+  simOutput.set_single_output_file(flSimParameters.outputFile);
+  if (flSimParameters.embeddedMetadata) {
+    datatools::multi_properties &metadataStore = simOutput.grab_metadata_store();
+    metadataStore = flSimMetadata;
+  }
+  simOutput.initialize_simple();
+
+  falaise::exit_code code = falaise::EXIT_OK;
+  if (partialFiles.empty()) {
+    simOutput.reset();
+    return code;
+  }
+
+  dpp::input_module blockInput;
+  blockInput.set_name("FLSimulateBlockInput");
+  blockInput.set_list_of_input_files(partialFiles);
+  blockInput.initialize_simple();
+
+  datatools::things workItem;
+  while (!blockInput.is_terminated()) {
+    workItem.clear();
+    if (blockInput.process(workItem) != dpp::base_module::PROCESS_OK) {
+      std::cerr << "flsimulate : Reading of simulated blocks failed" << std::endl;
+      code = falaise::EXIT_UNAVAILABLE;
+      break;
+    }
+    if (simOutput.process(workItem) != dpp::base_module::PROCESS_OK) {
+      std::cerr << "flsimulate : Output module failed" << std::endl;
+      code = falaise::EXIT_UNAVAILABLE;
+      break;
+    }
+  }
+  blockInput.reset();
+  simOutput.reset();
+  return code;
+}
+
+}  // namespace
+
+const std::string &mock_calibration_pipeline_name() {
+  static const std::string _name("pipeline");
+  return _name;
+}
+
+datatools::multi_properties get_mock_calibration_config(const FLSimulateArgs &flSimParameters) {
+  datatools::multi_properties calibrationConfig("name", "type");
+  if (!flSimParameters.mockCalibrationConfig.empty()) {
+    std::string configFile = flSimParameters.mockCalibrationConfig;
+    datatools::fetch_path_with_env(configFile);
+    calibrationConfig.read(configFile);
+    DT_THROW_IF(!calibrationConfig.has_key(mock_calibration_pipeline_name()), std::logic_error,
+                "Mock calibration configuration '" << configFile << "' has no '"
+                                                   << mock_calibration_pipeline_name()
+                                                   << "' module!");
+  } else {
+    const std::string geoLabel =
+        snemo::processing::service_info::default_geometry_service_label();
+    std::vector<std::string> modules = {"CalibrateTracker", "CalibrateCalorimeters"};
+    datatools::properties &pipeline =
+        calibrationConfig.add_section(mock_calibration_pipeline_name(), "dpp::chain_module");
+    pipeline.store("modules", modules);
+    datatools::properties &tracker =
+        calibrationConfig.add_section(modules[0], kTrackerCalibrationType);
+    tracker.store_string("Geo_label", geoLabel);
+    tracker.store_integer("random.seed", kMockCalibrationSeed);
+    tracker.store_boolean("store_mc_hit_id", true);
+    datatools::properties &calorimeters =
+        calibrationConfig.add_section(modules[1], kCaloCalibrationType);
+    calorimeters.store_string("Geo_label", geoLabel);
+    calorimeters.store_integer("random.seed", kMockCalibrationSeed);
+    std::vector<std::string> hitCategories = {"calo", "xcalo", "gveto"};
+    calorimeters.store("hit_categories", hitCategories);
+  }
+  if (flSimParameters.mockCalibrationSeed > 0) {
+    int32_t seed = flSimParameters.mockCalibrationSeed;
+    for (const std::string &name : calibrationConfig.ordered_keys()) {
+      if (!is_mock_calibration_type(calibrationConfig.get(name).get_meta())) {
+        continue;
+      }
+      datatools::properties &moduleConfig = calibrationConfig.grab_section(name);
+      if (moduleConfig.has_key("random.seed")) {
+        moduleConfig.erase("random.seed");
+      }
+      moduleConfig.store_integer("random.seed", seed);
+      seed = seed % 0x7ffffffe + 1;
+    }
+  }
+  return calibrationConfig;
+}
+
+int32_t derive_block_seed(uint64_t masterSeed, unsigned int stream, uint64_t block) {
+  uint64_t z = mix64(masterSeed + UINT64_C(0x9e3779b97f4a7c15));
+  z = mix64(z ^ (static_cast<uint64_t>(stream) + 1));
+  z = mix64(z ^ block);
+  return static_cast<int32_t>(1 + z % 0x7ffffffe);
+}
+
+falaise::exit_code do_block_simulation(FLSimulateArgs &flSimParameters) {
+  const uint64_t eventsPerBlock = flSimParameters.eventsPerBlock;
+  const uint64_t numberOfBlocks =
+      (flSimParameters.numberOfEvents + eventsPerBlock - 1) / eventsPerBlock;
+
+  const std::vector<uint64_t> masterSeeds = get_master_seeds(flSimParameters);
+  std::ostringstream rngSeedingOut;
+  rngSeedingOut << "{";
+  for (unsigned int stream = 0; stream < kNumberOfStreams; stream++) {
+    rngSeedingOut << (stream > 0 ? "; " : "") << kStreamLabels[stream] << "="
+                  << masterSeeds[stream];
+  }
+  rngSeedingOut << "}";
+  flSimParameters.rngSeeding = rngSeedingOut.str();
+  DT_LOG_DEBUG(flSimParameters.logLevel, "PRNG master seeding = " << flSimParameters.rngSeeding);
+  if (!flSimParameters.simulationManagerParams.output_prng_seeds_file.empty()) {
+    std::string seedsFile = flSimParameters.simulationManagerParams.output_prng_seeds_file;
+    datatools::fetch_path_with_env(seedsFile);
+    std::ofstream seedsOutput(seedsFile.c_str());
+    seedsOutput << flSimParameters.rngSeeding << std::endl;
+  }
+
+  // Simulate blocks in child processes, at most numberOfJobs at a time:
+  falaise::exit_code code = falaise::EXIT_OK;
+  std::vector<std::string> partialFiles;
+  std::map<pid_t, uint64_t> runningBlocks;
+  uint64_t nextBlock = 0;
+  while (true) {
+    while (code == falaise::EXIT_OK && nextBlock < numberOfBlocks &&
+           runningBlocks.size() < flSimParameters.numberOfJobs) {
+      partialFiles.push_back(block_output_file(flSimParameters.outputFile, nextBlock));
+      std::cout.flush();
+      std::cerr.flush();
+      pid_t pid = fork();
+      if (pid < 0) {
+        std::cerr << "flsimulate : Cannot start simulation process" << std::endl;
+        code = falaise::EXIT_UNAVAILABLE;
+        break;
+      }
+      if (pid == 0) {
+        falaise::exit_code blockCode = falaise::EXIT_UNAVAILABLE;
+        try {
+          blockCode = run_block(flSimParameters, masterSeeds, nextBlock, partialFiles.back());
+        } catch (std::exception &e) {
+          std::cerr << "flsimulate : Simulation of block #" << nextBlock << " threw exception"
+                    << std::endl;
+          std::cerr << e.what() << std::endl;
+        }
+        std::cout.flush();
+        std::cerr.flush();
+        _exit(blockCode);
+      }
+      runningBlocks[pid] = nextBlock++;
+    }
+    if (runningBlocks.empty()) {
+      break;
+    }
+    falaise::exit_code blockCode = falaise::EXIT_OK;
+    pid_t pid = wait_for_block(blockCode);
+    if (pid < 0) {
+      std::cerr << "flsimulate : Cannot wait for simulation processes" << std::endl;
+      code = falaise::EXIT_UNAVAILABLE;
+      break;
+    }
+    std::map<pid_t, uint64_t>::iterator running = runningBlocks.find(pid);
+    if (running == runningBlocks.end()) {
+      continue;
+    }
+    if (blockCode != falaise::EXIT_OK) {
+      std::cerr << "flsimulate : Simulation of block #" << running->second << " failed"
+                << std::endl;
+      if (code == falaise::EXIT_OK) {
+        code = blockCode;
+      }
+    }
+    runningBlocks.erase(running);
+  }
+
+  if (code == falaise::EXIT_OK) {
+    code = merge_blocks(flSimParameters, partialFiles);
+  }
+
+  for (const std::string &partialFile : partialFiles) {
+    std::string partialPath = partialFile;
+    datatools::fetch_path_with_env(partialPath);
+    std::remove(partialPath.c_str());
+  }
+  return code;
+}
+
+}  // namespace FLSimulate
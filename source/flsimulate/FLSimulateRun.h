@@ -0,0 +1,73 @@
+// FLSimulateRun.h - Execution of the FLSimulate event loop
+//
+// Distributed under the OSI-approved BSD 3-Clause License (the "License");
+// see accompanying file License.txt for details.
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even the
+// implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the License for more information.
+
+#ifndef FLSIMULATERUN_H
+#define FLSIMULATERUN_H
+
+// Standard Library:
+#include <cstdint>
+#include <string>
+
+// Third Party
+// - Bayeux
+#include "bayeux/datatools/multi_properties.h"
+
+// This Project
+#include "FLSimulateArgs.h"
+#include "falaise/exitcodes.h"
+
+namespace FLSimulate {
+
+//! Populate the metadata container with various informations classified in several categories
+falaise::exit_code do_metadata(const FLSimulateArgs &, datatools::multi_properties &);
+
+//! \brief Simulate a range of events and write them in an output file
+//!
+//! Events are numbered from firstEvent. If writeMetadata is false, the
+//! output metadata are neither embedded in the output file nor written in
+//! the output metadata file.
+falaise::exit_code do_simulation(FLSimulateArgs &flSimParameters, unsigned int firstEvent,
+                                 unsigned int numberOfEvents, const std::string &outputFile,
+                                 bool writeMetadata);
+
+//! Return the name of the module running the mock calibration chain
+const std::string &mock_calibration_pipeline_name();
+
+//! \brief Return the configuration of the mock calibration modules
+//!
+//! The configuration is read from the mockCalibrationConfig file if any,
+//! otherwise the default mock tracker and calorimeter calibration modules
+//! are chained with the modules' default seed. If mockCalibrationSeed is set,
+//! it seeds the PRNGs of all mock calibration modules.
+datatools::multi_properties get_mock_calibration_config(const FLSimulateArgs &flSimParameters);
+
+//! \brief Return the seed of a PRNG for a block of events
+//!
+//! The seed is a strictly positive 31 bits integer depending only on the
+//! master seed, the index of the PRNG and the index of the block.
+int32_t derive_block_seed(uint64_t masterSeed, unsigned int stream, uint64_t block);
+
+//! \brief Simulate events by blocks of fixed size, in parallel processes
+//!
+//! The seeds of the PRNGs used for each block of eventsPerBlock events are
+//! derived from the master seeds and the index of the block. Each block is
+//! simulated by a fresh process, at most numberOfJobs at a time, in a partial
+//! file. Partial files are merged in order in the output file, which thus
+//! does not depend on the number of processes.
+falaise::exit_code do_block_simulation(FLSimulateArgs &flSimParameters);
+
+}  // namespace FLSimulate
+
+#endif  // FLSIMULATERUN_H
+
+// Local Variables: --
+// mode: c++ --
+// c-file-style: "gnu" --
+// tab-width: 2 --
+// End: --
@@ -55,6 +55,7 @@
 #include "bayeux/datatools/urn_db_service.h"
 #include "bayeux/datatools/urn_query_service.h"
 #include "bayeux/datatools/urn_to_path_resolver_service.h"
+#include "bayeux/dpp/module_manager.h"
 #include "bayeux/dpp/output_module.h"
 #include "bayeux/geomtools/manager.h"
 #include "bayeux/mctools/g4/manager_parameters.h"
@@ -76,15 +77,13 @@
 // #include "FLSimulateCommandLine.h"
 #include "FLSimulateErrors.h"
 #include "FLSimulateResources.h"
+#include "FLSimulateRun.h"
 
 namespace FLSimulate {
 
 //! Perform simulation using command line args as given
 falaise::exit_code do_flsimulate(int argc, char *argv[]);
 
-//! Populate the metadata container with various informations classified in several categories
-falaise::exit_code do_metadata(const FLSimulateArgs &, datatools::multi_properties &);
-
 }  // end of namespace FLSimulate
 
 //----------------------------------------------------------------------
@@ -134,6 +133,9 @@ falaise::exit_code do_metadata(const FLSimulateArgs &flSimParameters,
   system_props.store_boolean("doDigitization", flSimParameters.doDigitization,
                              "Activate digitization");
 
+  system_props.store_boolean("doMockCalibration", flSimParameters.doMockCalibration,
+                             "Activate mock calibration");
+
   if (!flSimParameters.experimentalSetupUrn.empty()) {
     system_props.store_string("experimentalSetupUrn", flSimParameters.experimentalSetupUrn,
                               "Experimental setup URN");
@@ -166,6 +168,11 @@ falaise::exit_code do_metadata(const FLSimulateArgs &flSimParameters,
       // Saving effective initial seeds for PRNGs:
       simulation_props.store_string("rngSeeding", flSimParameters.rngSeeding, "PRNG initial seeds");
     }
+    if (flSimParameters.eventsPerBlock > 0) {
+      // PRNGs are seeded again for each block of events:
+      simulation_props.store_integer("eventsPerBlock", flSimParameters.eventsPerBlock,
+                                     "Number of events per block of derived PRNG seeds");
+    }
   }
 
   if (flSimParameters.doDigitization) {
@@ -187,6 +194,23 @@ falaise::exit_code do_metadata(const FLSimulateArgs &flSimParameters,
     // }
   }
 
+  if (flSimParameters.doMockCalibration) {
+    // Mock calibration section:
+    datatools::properties &calibration_props =
+        flSimMetadata.add_section("flsimulate.calibration", "flsimulate::section");
+    calibration_props.set_description("Mock calibration setup parameters");
+    if (!flSimParameters.mockCalibrationConfig.empty()) {
+      calibration_props.store_path("config", flSimParameters.mockCalibrationConfig,
+                                   "Mock calibration modules configuration file");
+    }
+    calibration_props.store_boolean("keepSimulatedData", flSimParameters.keepSimulatedData,
+                                    "Simulated data bank is kept in output");
+    if (flSimParameters.mockCalibrationSeed > 0) {
+      calibration_props.store_integer("rngSeed", flSimParameters.mockCalibrationSeed,
+                                      "Seed of the mock calibration PRNGs");
+    }
+  }
+
   // Variants section:
   datatools::properties &variants_props =
       flSimMetadata.add_section("flsimulate.variantService", "flsimulate::section");
@@ -231,6 +255,129 @@ falaise::exit_code do_metadata(const FLSimulateArgs &flSimParameters,
   return code;
 }
 
+//----------------------------------------------------------------------
+falaise::exit_code do_simulation(FLSimulateArgs &flSimParameters, unsigned int firstEvent,
+                                 unsigned int numberOfEvents, const std::string &outputFile,
+                                 bool writeMetadata) {
+  falaise::exit_code code = falaise::EXIT_OK;
+  // Setup services:
+  datatools::service_manager services("flSimulationServices", "SuperNEMO Simulation Services");
+  std::string services_config_file = flSimParameters.servicesSubsystemConfig;
+  datatools::fetch_path_with_env(services_config_file);
+  datatools::properties services_config;
+  services_config.read_configuration(services_config_file);
+  services.initialize(services_config);
+
+  // Simulation module:
+  mctools::g4::simulation_module flSimModule;
+  flSimModule.set_name("G4SimulationModule");
+  std::string sd_label = snemo::datamodel::data_info::default_simulated_data_label();
+  std::string geo_label = snemo::processing::service_info::default_geometry_service_label();
+  flSimModule.set_sd_label(sd_label);
+  flSimModule.set_geo_label(geo_label);
+  flSimModule.set_geant4_parameters(flSimParameters.simulationManagerParams);
+  flSimModule.initialize_simple_with_service(services);
+  if (flSimModule.is_initialized()) {
+    // Fetch effective seeds' value after simulation module initialization
+    // because the embedded PRNG seed manager makes the final choice of
+    // initial seeds.
+    std::ostringstream rngSeedingOut;
+    rngSeedingOut << flSimModule.get_seed_manager();
+    flSimParameters.rngSeeding = rngSeedingOut.str();
+    DT_LOG_DEBUG(flSimParameters.logLevel, "PRNG seeding = " << flSimParameters.rngSeeding);
+  }
+
+  // Digitization module:
+  if (flSimParameters.doDigitization) {
+    DT_THROW(std::logic_error, "Digitization is not supported yet!");
+  }
+
+  // Mock calibration modules, processing each simulated event before its output:
+  dpp::module_manager calibrationManager;
+  dpp::base_module *calibrationPipeline = nullptr;
+  if (flSimParameters.doMockCalibration) {
+    calibrationManager.set_service_manager(services);
+    calibrationManager.load_modules(get_mock_calibration_config(flSimParameters));
+    calibrationManager.initialize_simple();
+    calibrationPipeline = &calibrationManager.grab(mock_calibration_pipeline_name());
+  }
+
+  // Output metadata management:
+  datatools::multi_properties flSimMetadata("name", "type",
+                                            "Metadata associated to a flsimulate run");
+  do_metadata(flSimParameters, flSimMetadata);
+  if (datatools::logger::is_debug(flSimParameters.logLevel)) {
+    flSimMetadata.tree_dump(std::cerr, "Simulation metadata: ", "[debug]: ");
+  }
+
+  if (writeMetadata && !flSimParameters.outputMetadataFile.empty()) {
+    std::string fMetadata = flSimParameters.outputMetadataFile;
+    datatools::fetch_path_with_env(fMetadata);
+    flSimMetadata.write(fMetadata);
+  }
+
+  // Simulation output module:
+  dpp::output_module simOutput;
+  simOutput.set_name("FLSimulateOutput");
+  simOutput.set_single_output_file(outputFile);
+  // Metadata management:
+  if (writeMetadata && flSimParameters.embeddedMetadata) {
+    // Push the metadata in the metadata store:
+    datatools::multi_properties &metadataStore = simOutput.grab_metadata_store();
+    metadataStore = flSimMetadata;
+  }
+  simOutput.initialize_simple();
+
+  // Manual Event loop....
+  datatools::things workItem;
+  dpp::base_module::process_status status;
+
+  for (unsigned int i(firstEvent); i < firstEvent + numberOfEvents; ++i) {
+    workItem.clear();
+
+    // Add the event header bank
+    auto &eventHeader = workItem.add<snemo::datamodel::event_header>(
+        snemo::datamodel::data_info::default_event_header_label(), "Event Header Bank");
+    eventHeader.set_generation(snemo::datamodel::event_header::GENERATION_SIMULATED);
+    datatools::event_id eventID{datatools::event_id::ANY_RUN_NUMBER, static_cast<int>(i)};
+    eventHeader.set_id(eventID);
+
+    status = flSimModule.process(workItem);
+    if (status != dpp::base_module::PROCESS_OK) {
+      std::cerr << "flsimulate : Simulation module failed" << std::endl;
+      code = falaise::EXIT_UNAVAILABLE;
+    }
+
+    if (calibrationPipeline != nullptr && code == falaise::EXIT_OK) {
+      status = calibrationPipeline->process(workItem);
+      if (status != dpp::base_module::PROCESS_OK) {
+        std::cerr << "flsimulate : Mock calibration failed" << std::endl;
+        code = falaise::EXIT_UNAVAILABLE;
+      } else if (!flSimParameters.keepSimulatedData) {
+        // Only write the compact calibrated data
+        workItem.remove(sd_label);
+      }
+    }
+
+    status = simOutput.process(workItem);
+    if (status != dpp::base_module::PROCESS_OK) {
+      std::cerr << "flsimulate : Output module failed" << std::endl;
+      code = falaise::EXIT_UNAVAILABLE;
+    }
+
+    // Here we will process optional ASB+Digitization+terminal output modules
+
+    if (code != falaise::EXIT_OK) {
+      break;
+    }
+  }
+
+  if (calibrationManager.is_initialized()) {
+    calibrationManager.reset();
+  }
+  return code;
+}
+
 //----------------------------------------------------------------------
 falaise::exit_code do_flsimulate(int argc, char *argv[]) {
   // - Configure:
@@ -282,95 +429,11 @@ falaise::exit_code do_flsimulate(int argc, char *argv[]) {
   // - Run:
   falaise::exit_code code = falaise::EXIT_OK;
   try {
-    // Setup services:
-    datatools::service_manager services("flSimulationServices", "SuperNEMO Simulation Services");
-    std::string services_config_file = flSimParameters.servicesSubsystemConfig;
-    datatools::fetch_path_with_env(services_config_file);
-    datatools::properties services_config;
-    services_config.read_configuration(services_config_file);
-    services.initialize(services_config);
-
-    // Simulation module:
-    mctools::g4::simulation_module flSimModule;
-    flSimModule.set_name("G4SimulationModule");
-    std::string sd_label = snemo::datamodel::data_info::default_simulated_data_label();
-    std::string geo_label = snemo::processing::service_info::default_geometry_service_label();
-    flSimModule.set_sd_label(sd_label);
-    flSimModule.set_geo_label(geo_label);
-    flSimModule.set_geant4_parameters(flSimParameters.simulationManagerParams);
-    flSimModule.initialize_simple_with_service(services);
-    if (flSimModule.is_initialized()) {
-      // Fetch effective seeds' value after simulation module initialization
-      // because the embedded PRNG seed manager makes the final choice of
-      // initial seeds.
-      std::ostringstream rngSeedingOut;
-      rngSeedingOut << flSimModule.get_seed_manager();
-      flSimParameters.rngSeeding = rngSeedingOut.str();
-      DT_LOG_DEBUG(flSimParameters.logLevel, "PRNG seeding = " << flSimParameters.rngSeeding);
-    }
-
-    // Digitization module:
-    if (flSimParameters.doDigitization) {
-      DT_THROW(std::logic_error, "Digitization is not supported yet!");
-    }
-
-    // Output metadata management:
-    datatools::multi_properties flSimMetadata("name", "type",
-                                              "Metadata associated to a flsimulate run");
-    do_metadata(flSimParameters, flSimMetadata);
-    if (datatools::logger::is_debug(flSimParameters.logLevel)) {
-      flSimMetadata.tree_dump(std::cerr, "Simulation metadata: ", "[debug]: ");
-    }
-
-    if (!flSimParameters.outputMetadataFile.empty()) {
-      std::string fMetadata = flSimParameters.outputMetadataFile;
-      datatools::fetch_path_with_env(fMetadata);
-      flSimMetadata.write(fMetadata);
-    }
-
-    // Simulation output module:
-    dpp::output_module simOutput;
-    simOutput.set_name("FLSimulateOutput");
-    simOutput.set_single_output_file(flSimParameters.outputFile);
-    // Metadata management:
-    if (flSimParameters.embeddedMetadata) {
-      // Push the metadata in the metadata store:
-      datatools::multi_properties &metadataStore = simOutput.grab_metadata_store();
-      metadataStore = flSimMetadata;
-    }
-    simOutput.initialize_simple();
-
-    // Manual Event loop....
-    datatools::things workItem;
-    dpp::base_module::process_status status;
-
-    for (unsigned int i(0); i < flSimParameters.numberOfEvents; ++i) {
-      workItem.clear();
-
-      // Add the event header bank
-      auto &eventHeader = workItem.add<snemo::datamodel::event_header>(
-          snemo::datamodel::data_info::default_event_header_label(), "Event Header Bank");
-      eventHeader.set_generation(snemo::datamodel::event_header::GENERATION_SIMULATED);
-      datatools::event_id eventID{datatools::event_id::ANY_RUN_NUMBER, static_cast<int>(i)};
-      eventHeader.set_id(eventID);
-
-      status = flSimModule.process(workItem);
-      if (status != dpp::base_module::PROCESS_OK) {
-        std::cerr << "flsimulate : Simulation module failed" << std::endl;
-        code = falaise::EXIT_UNAVAILABLE;
-      }
-
-      status = simOutput.process(workItem);
-      if (status != dpp::base_module::PROCESS_OK) {
-        std::cerr << "flsimulate : Output module failed" << std::endl;
-        code = falaise::EXIT_UNAVAILABLE;
-      }
-
-      // Here we will process optional ASB+Digitization+terminal output modules
-
-      if (code != falaise::EXIT_OK) {
-        break;
-      }
+    if (flSimParameters.eventsPerBlock > 0) {
+      code = do_block_simulation(flSimParameters);
+    } else {
+      code = do_simulation(flSimParameters, 0, flSimParameters.numberOfEvents,
+                           flSimParameters.outputFile, true);
     }
   } catch (std::exception &e) {
     std::cerr << "flsimulate : Setup/run of simulation threw exception" << std::endl;